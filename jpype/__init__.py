@@ -25,6 +25,8 @@ from ._gui import *
 from ._classpath import *
 from ._jclass import *
 from ._jobject import *
+from ._jasync import *
+from ._jmethod import *
 # There is a bug in lgtm with __init__ imports.  It will be fixed next month.
 from . import _jarray       # lgtm [py/import-own-module]
 from . import _jexception   # lgtm [py/import-own-module]
@@ -51,6 +53,8 @@ __all__.extend(_jpackage.__all__)  # type: ignore[name-defined]
 __all__.extend(_jclass.__all__)  # type: ignore[name-defined]
 __all__.extend(_jcustomizer.__all__)  # type: ignore[name-defined]
 __all__.extend(_gui.__all__)  # type: ignore[name-defined]
+__all__.extend(_jasync.__all__)  # type: ignore[name-defined]
+__all__.extend(_jmethod.__all__)  # type: ignore[name-defined]
 
 __version__ = "1.5.2.dev0"
 __version_info__ = __version__.split('.')
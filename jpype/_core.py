@@ -41,7 +41,7 @@ from importlib import util as _util
 __all__ = [
     'isJVMStarted', 'startJVM', 'shutdownJVM',
     'getDefaultJVMPath', 'getJVMVersion', 'isThreadAttachedToJVM', 'attachThreadToJVM',
-    'detachThreadFromJVM', 'synchronized',
+    'detachThreadFromJVM', 'synchronized', 'preloadPackages',
     'JVMNotFoundException', 'JVMNotSupportedException', 'JVMNotRunning'
 ]
 
@@ -543,6 +543,37 @@ def getJVMVersion():
     return tuple([int(i) for i in version.split('.')])
 
 
+def preloadPackages(*packages):
+    """ Create the class wrappers for all public classes in Java packages.
+
+    Classes are normally wrapped lazily on first use.  Services that touch
+    many classes at startup can instead build the Java side of the wrappers
+    for whole packages in one batched pass and then create the Python types.
+    Subpackages are not included.  Classes that fail to load are skipped.
+
+    When the JVM is started with ``-Dorg.jpype.typecache=<file>``, the member
+    ordering computed for each class is stored in the file and reused on the
+    next start for classes whose jars are unchanged.
+
+    Arguments:
+        *packages (str): Names of the Java packages to load.
+
+    Returns:
+      A list of the Python wrappers for the classes loaded.
+
+    Example:
+
+    .. code-block:: python
+
+      jpype.preloadPackages("java.util", "java.util.concurrent")
+
+    """
+    if not _jpype.isStarted():
+        raise JVMNotRunning("JVM must be started first")
+    manager = _jpype.JPypeContext.getTypeManager()
+    return [_jpype._getClass(cls) for cls in manager.preload(packages)]
+
+
 @_jcustomizer.JImplementationFor("java.lang.Runtime")
 class _JRuntime(object):
     # We need to redirect hooks so that we control the order
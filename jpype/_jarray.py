@@ -110,9 +110,6 @@ class _JArrayProto(object):
     def __str__(self):
         return str(list(self))
 
-    def __iter__(self):
-        return _JavaArrayIter(self)
-
     def __reversed__(self):
         for elem in self[::-1]:
             yield elem
@@ -177,22 +174,6 @@ def _toJavaClass(tp):
 # Cannot be Mutable because java arrays are fixed in length
 
 
-class _JavaArrayIter(object):
-    def __init__(self, a):
-        self._array = a
-        self._ndx = -1
-
-    def __iter__(self):
-        return self
-
-    def __next__(self):
-        self._ndx += 1
-        if self._ndx >= len(self._array):
-            raise StopIteration
-        return self._array[self._ndx]
-
-    next = __next__
-
 # **********************************************************
 # Char array customizer
 
@@ -0,0 +1,291 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import asyncio
+import socket
+import threading
+import weakref
+
+import _jpype
+from . import _jcustomizer
+
+__all__ = ['callAsync', 'asFuture', 'toCompletableFuture', 'serveCallbacks']
+
+# Java threads write to this socket pair when results are ready
+_wakeup = None
+_loops: weakref.WeakSet = weakref.WeakSet()
+# Java threads write to this socket pair when queued proxy calls are ready
+_callbackWakeup = None
+# Servers for the loops that run queued proxy calls
+_servers: weakref.WeakKeyDictionary = weakref.WeakKeyDictionary()
+
+
+def _complete(future, value, exc):
+    if future.done():
+        return
+    if exc is not None:
+        future.set_exception(exc)
+    else:
+        future.set_result(value)
+
+
+def _drain(sock):
+    try:
+        while sock.recv(4096):
+            pass
+    except (BlockingIOError, InterruptedError):
+        pass
+    current = asyncio.get_running_loop()
+    for future, value, exc in _jpype._asyncDrain():
+        loop = future.get_loop()
+        if loop is current:
+            _complete(future, value, exc)
+            continue
+        try:
+            loop.call_soon_threadsafe(_complete, future, value, exc)
+        except RuntimeError:
+            # The loop for this future has been closed
+            pass
+
+
+async def _reader(loop, sock):
+    while True:
+        await loop.sock_recv(sock, 4096)
+        _drain(sock)
+
+
+def _register(loop):
+    global _wakeup
+    if _wakeup is None:
+        rsock, wsock = socket.socketpair()
+        rsock.setblocking(False)
+        wsock.setblocking(False)
+        _jpype._asyncWakeup(wsock.fileno())
+        _wakeup = (rsock, wsock)
+    if loop in _loops:
+        return
+    rsock = _wakeup[0]
+    try:
+        loop.add_reader(rsock.fileno(), _drain, rsock)
+    except NotImplementedError:
+        # Proactor loops can not watch a socket so read it with a task
+        loop.create_task(_reader(loop, rsock))
+    _loops.add(loop)
+
+
+def callAsync(method, *args, executor=None):
+    """ Call a Java method without blocking the event loop.
+
+    The arguments are converted immediately and the call is run on a Java
+    executor.  When the call finishes the result is converted and delivered
+    to the returned future by the event loop.  Cancelling the future cancels
+    the Java ``CompletableFuture``, though a call already running is not
+    interrupted.
+
+    This must be called from a thread running an asyncio event loop.
+
+    Args:
+        method: A Java method, either bound to an object or static.
+        *args: The arguments to the method.
+
+    Keyword Args:
+        executor (java.util.concurrent.Executor, optional): The executor on
+            which to run the call.  By default a shared pool of daemon
+            threads is used.
+
+    Returns:
+        asyncio.Future: A future holding the result of the call.
+
+    Example:
+
+    .. code-block:: python
+
+        async def query(statement, sql):
+            rs = await jpype.callAsync(statement.executeQuery, sql)
+    """
+    if not isinstance(method, _jpype._JMethod):
+        raise TypeError("Java method is required")
+    loop = asyncio.get_running_loop()
+    _register(loop)
+    future = loop.create_future()
+    jfuture = method._callAsync(future, executor, *args)
+
+    def cancel(f):
+        if f.cancelled():
+            jfuture.cancel(True)
+    future.add_done_callback(cancel)
+    return future
+
+
+def asFuture(stage):
+    """ Wrap a Java ``CompletionStage`` as an asyncio future.
+
+    A completion handler is registered on the Java side, so no Python thread
+    waits on the stage.  Completions from any number of stages are queued
+    natively and delivered by the event loop in batches.  Java
+    ``CompletionStage`` objects can also be awaited directly.
+
+    This must be called from a thread running an asyncio event loop.
+
+    Args:
+        stage (java.util.concurrent.CompletionStage): The stage to watch.
+
+    Returns:
+        asyncio.Future: A future holding the result of the stage.
+    """
+    loop = asyncio.get_running_loop()
+    _register(loop)
+    future = loop.create_future()
+    _jpype._asyncWatch(future, stage)
+    return future
+
+
+def toCompletableFuture(future):
+    """ Wrap an asyncio future as a Java ``CompletableFuture``.
+
+    The Java future is completed by the event loop when the Python future
+    finishes.  Exceptions that are not Java exceptions are passed as a
+    ``java.lang.RuntimeException`` holding the Python message.
+
+    Args:
+        future (asyncio.Future): The future to watch.
+
+    Returns:
+        java.util.concurrent.CompletableFuture: The Java future.
+    """
+    out = _jpype.JClass("java.util.concurrent.CompletableFuture")()
+
+    def done(f):
+        if f.cancelled():
+            out.cancel(True)
+            return
+        exc = f.exception()
+        if exc is None:
+            out.complete(f.result())
+        elif isinstance(exc, _jpype._JException):
+            out.completeExceptionally(exc)
+        else:
+            out.completeExceptionally(_jpype.JClass("java.lang.RuntimeException")(repr(exc)))
+    asyncio.ensure_future(future).add_done_callback(done)
+    return out
+
+
+@_jcustomizer.JImplementationFor('java.util.concurrent.CompletionStage')
+class _JCompletionStage:
+
+    def __await__(self):
+        return asFuture(self).__await__()
+
+
+class CallbackServer(object):
+    """ Runs calls to queued proxies on an asyncio event loop.
+
+    Created by ``jpype.serveCallbacks``.  The loop counts as a consumer of
+    queued calls until the server is closed or its task is cancelled, which
+    ``asyncio.run`` does when the main coroutine returns.  Calls still
+    waiting when the last consumer stops fail with a Java
+    ``RuntimeException``.
+
+    The server may be used as a context manager.
+    """
+
+    def __init__(self, loop, sock):
+        self._lock = threading.Lock()
+        self._serving = True
+        _jpype._serveCallbacks(True)
+        self._task = loop.create_task(self._serve(loop, sock))
+
+    async def _serve(self, loop, sock):
+        try:
+            while True:
+                # Take anything queued before the loop was woken
+                _jpype._runCallbacks(0)
+                await loop.sock_recv(sock, 4096)
+        finally:
+            # A wake-up may have been read without running the calls
+            if _jpype.isStarted():
+                _jpype._runCallbacks(0)
+            self._release()
+
+    def _release(self):
+        with self._lock:
+            if not self._serving:
+                return
+            self._serving = False
+        if _jpype.isStarted():
+            _jpype._serveCallbacks(False)
+
+    @property
+    def serving(self):
+        """ True until the server is closed. """
+        return self._serving
+
+    def close(self):
+        """ Stop serving calls.
+
+        This may be called from any thread.
+        """
+        self._release()
+        loop = self._task.get_loop()
+        if not loop.is_closed():
+            loop.call_soon_threadsafe(self._task.cancel)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+
+def serveCallbacks(loop=None):
+    """ Run calls to queued proxies on an asyncio event loop.
+
+    Calls from Java threads to proxies created with ``queued=True`` are
+    delivered to the loop in batches through a wake-up socket read only by
+    loops serving callbacks.  The loop must not block on Java work that
+    waits for those calls.  Each loop is registered once, so calling this
+    again returns the same server.
+
+    The loop stops serving when the returned server is closed or when its
+    task is cancelled, as ``asyncio.run`` does on exit.  A loop that is
+    stopped but not closed keeps serving once it runs again.  A call that no
+    loop takes within 60 seconds fails with a Java ``RuntimeException``.
+
+    Args:
+        loop (asyncio.AbstractEventLoop, optional): The loop to use.  By
+            default the running loop.
+
+    Returns:
+        CallbackServer: The server for the loop.
+    """
+    global _callbackWakeup
+    if loop is None:
+        loop = asyncio.get_running_loop()
+    ref = _servers.get(loop)
+    server = ref() if ref is not None else None
+    if server is not None and server.serving:
+        return server
+    if _callbackWakeup is None:
+        rsock, wsock = socket.socketpair()
+        rsock.setblocking(False)
+        wsock.setblocking(False)
+        _jpype._callbackWakeup(wsock.fileno())
+        _callbackWakeup = (rsock, wsock)
+    # The task holds the server, so only a weak reference is kept here
+    server = CallbackServer(loop, _callbackWakeup[0])
+    _servers[loop] = weakref.ref(server)
+    return server
@@ -82,7 +82,7 @@ def JConversion(cls, exact=None, instanceof=None, attribute=None, excludes=None)
     return customizer
 
 
-def JImplementationFor(clsname, base=False):
+def JImplementationFor(clsname, base=False, immutable=False):
     """ Decorator to define an implementation for a class.
 
     Applies to a class which will serve as a prototype as for the Java class
@@ -104,10 +104,16 @@ def JImplementationFor(clsname, base=False):
     retroactively if the class is already created.  Conflicts are
     resolved by the last customizer applied.
 
+    Classes marked immutable have the hash of each instance computed once
+    and cached.  Only mark a class immutable if ``hashCode`` can never change
+    for an instance.
+
     Args:
       clsname (str): name of java class.
       base (bool, optional): if True this will be a base class.
         Default is False.
+      immutable (bool, optional): if True the hash of instances of this
+        class is cached.  Default is False.
 
     """
     if not isinstance(clsname, str):
@@ -115,6 +121,8 @@ def JImplementationFor(clsname, base=False):
 
     def customizer(cls):
         hints = getClassHints(clsname)
+        if immutable:
+            hints.registerImmutable(clsname)
         if base:
             hints.registerClassBase(cls)
         else:
@@ -204,6 +212,7 @@ class JClassHints(_jpype._JClassHints):
         self.bases = []
         self.implementations = []
         self.instantiated = False
+        self.immutable = False
 
     def registerClassBase(self, base):
         """ (internal) Add an implementation for a class
@@ -230,6 +239,15 @@ class JClassHints(_jpype._JClassHints):
         if self.instantiated:
             _applyCustomizerPost(_jpype.JClass(classname), proto)
 
+    def registerImmutable(self, classname):
+        """ (internal) Mark a class as immutable
+
+        Use @JImplementationFor(cls, immutable=True) to access this.
+        """
+        self.immutable = True
+        if self.instantiated:
+            _jpype.JClass(classname)._immutable = True
+
     def applyCustomizers(self, name, bases, members):
         """ (internal) Called by JClass and JArray to customize a newly created class."""
         # Apply base classes
@@ -260,6 +278,8 @@ class JClassHints(_jpype._JClassHints):
         required by inherited parents.
         """
         self.instantiated = True
+        if self.immutable:
+            cls._immutable = True
         if hasattr(cls, '__jclass_init__'):
             init = []
             for base in cls.__mro__:
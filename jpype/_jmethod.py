@@ -19,7 +19,58 @@
 import _jpype
 from . import _jclass
 
-__all__ = []  # type: ignore[var-annotated]
+__all__ = ['callNumPy', 'returnNumPy']
+
+
+def callNumPy(method, *args):
+    """ Call a Java method returning a primitive array as a NumPy array.
+
+    The Java array is copied once into a new ``numpy.ndarray`` which owns
+    its memory, so no ``JArray`` wrapper is created and no Java array is
+    held.  Returns of any other type are converted as usual and a null
+    array is returned as None.
+
+    Args:
+        method: A Java method, either bound to an object or static.
+        *args: The arguments to the method.
+
+    Returns:
+        numpy.ndarray: The array returned by the method.
+
+    Example:
+
+    .. code-block:: python
+
+        values = jpype.callNumPy(series.toDoubleArray)
+    """
+    if not isinstance(method, _jpype._JMethod):
+        raise TypeError("Java method is required")
+    return method._callNumPy(*args)
+
+
+def returnNumPy(method, enabled=True):
+    """ Return primitive arrays from a Java method as NumPy arrays.
+
+    This applies to every call to the method by that name on the class,
+    whether bound or not, as if each call were made with ``callNumPy``.  It
+    is typically set in the ``__jclass_init__`` of a customizer.
+
+    Args:
+        method: A Java method taken from the class or an instance.
+        enabled (bool): Turn the NumPy return on or off.
+
+    Example:
+
+    .. code-block:: python
+
+        @jpype.JImplementationFor("com.example.Series")
+        class _Series:
+            def __jclass_init__(cls):
+                jpype.returnNumPy(cls.toDoubleArray)
+    """
+    if not isinstance(method, _jpype._JMethod):
+        raise TypeError("Java method is required")
+    method._returnNumPy = enabled
 
 
 def _jmethodGetDoc(method, cls, overloads):
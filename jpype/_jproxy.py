@@ -15,9 +15,11 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
+import threading
+
 import _jpype
 
-__all__ = ["JProxy", "JImplements"]
+__all__ = ["JProxy", "JImplements", "JCallbackExecutor"]
 
 
 # FIXME the java.lang.method we are overriding should be passes to the lookup function
@@ -54,7 +56,7 @@ def _prepareInterfaces(cls, intf):
     return actualIntf
 
 
-def _createJProxyDeferred(cls, *intf):
+def _createJProxyDeferred(cls, *intf, queued=False):
     """ (internal) Create a proxy from a Python class with
     @JOverride notation on methods evaluated at first
     instantiation.
@@ -69,14 +71,14 @@ def _createJProxyDeferred(cls, *intf):
         if actualIntf is None:
             actualIntf = _prepareInterfaces(cls, intf)
             tp.__jpype_interfaces__ = actualIntf
-        return _jpype._JProxy.__new__(tp, None, actualIntf)
+        return _jpype._JProxy.__new__(tp, None, actualIntf, False, queued)
 
     members = {'__new__': new}
     # Return the augmented class
     return type("proxy.%s" % cls.__name__, (cls, _jpype._JProxy), members)
 
 
-def _createJProxy(cls, *intf):
+def _createJProxy(cls, *intf, queued=False):
     """ (internal) Create a proxy from a Python class with
     @JOverride notation on methods evaluated at declaration.
     """
@@ -86,7 +88,7 @@ def _createJProxy(cls, *intf):
     actualIntf = _prepareInterfaces(cls, intf)
 
     def new(tp, *args, **kwargs):
-        self = _jpype._JProxy.__new__(tp, None, actualIntf)
+        self = _jpype._JProxy.__new__(tp, None, actualIntf, False, queued)
         tp.__init__(self, *args, **kwargs)
         return self
 
@@ -116,6 +118,10 @@ def JImplements(*interfaces, deferred=False, **kwargs):
         (False). Deferred validation allows a proxy class to be declared prior
         to starting the JVM.  Validation only occurs once per proxy class,
         thus there is no performance penalty.  Default False.
+      queued (bool):
+        Whether calls from Java threads are queued for a
+        ``JCallbackExecutor`` rather than taking the GIL in the calling
+        thread.  Default False.
 
     Example:
 
@@ -214,8 +220,10 @@ class JProxy(_jpype._JProxy):
             java interface methods.
         inst (object, optional): specifies an object with methods
             whose names matches the java interfaces methods.
+        queued (bool, optional): queue calls from Java threads for a
+            ``JCallbackExecutor``.
     """
-    def __new__(cls, intf, dict=None, inst=None, convert=False):
+    def __new__(cls, intf, dict=None, inst=None, convert=False, queued=False):
         # Convert the interfaces
         actualIntf = _convertInterfaces([intf])
 
@@ -224,10 +232,10 @@ class JProxy(_jpype._JProxy):
             raise TypeError("Specify only one of dict and inst")
 
         if dict is not None:
-            return _jpype._JProxy(_JFromDict(dict), actualIntf, convert)
+            return _jpype._JProxy(_JFromDict(dict), actualIntf, convert, queued)
 
         if inst is not None:
-            return _jpype._JProxy.__new__(cls, inst, actualIntf, convert)
+            return _jpype._JProxy.__new__(cls, inst, actualIntf, convert, queued)
 
         raise TypeError("a dict or inst must be specified")
 
@@ -236,3 +244,70 @@ class JProxy(_jpype._JProxy):
         if not isinstance(obj, _jpype._JProxy):
             return obj
         return obj.__javainst__
+
+
+class JCallbackExecutor(object):
+    """ Runs calls to queued proxies on a designated Python thread.
+
+    Ordinarily each Java thread that calls a proxy takes the GIL for the
+    duration of the call.  When many Java threads call back at once they
+    contend for the GIL.  Proxies created with ``queued=True`` instead place
+    the call on a native queue and park the Java thread.  The executor thread
+    takes every queued call in one pass and runs them under a single hold of
+    the GIL.
+
+    Calls made from Python threads, including calls that Java makes while
+    running a Python callback, are never queued so they can not deadlock on
+    the executor.  While no executor is running, Java threads call a queued
+    proxy directly like any other proxy.  Calls still waiting when the last
+    executor stops, or when the JVM shuts down, fail with a Java
+    ``RuntimeException``.  ``jpype.serveCallbacks`` runs the queue on an
+    asyncio loop instead.
+
+    Example:
+
+      .. code-block:: python
+
+          @JImplements("java.util.function.Consumer", queued=True)
+          class Listener:
+              @JOverride
+              def accept(self, record):
+                  ...
+
+          with JCallbackExecutor():
+              consumer.run(Listener())
+    """
+
+    def __init__(self):
+        self._thread = None
+        self._stop = threading.Event()
+
+    def start(self):
+        """ Start running callbacks on a daemon thread. """
+        if self._thread is not None:
+            raise RuntimeError("executor is already running")
+        self._stop.clear()
+        _jpype._serveCallbacks(True)
+        self._thread = threading.Thread(target=self.run, name="JPype Callbacks", daemon=True)
+        self._thread.start()
+        return self
+
+    def stop(self):
+        """ Stop the executor thread and wait for it to finish. """
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+            # Calls still waiting fail once the last consumer stops
+            _jpype._serveCallbacks(False)
+
+    def run(self):
+        """ Run callbacks in the current thread until stopped. """
+        while not self._stop.is_set():
+            _jpype._runCallbacks(0.1)
+
+    def __enter__(self):
+        return self.start()
+
+    def __exit__(self, *args):
+        self.stop()
@@ -15,8 +15,6 @@
 #   See NOTICE file for details.
 #
 # *****************************************************************************
-import typing
-
 import _jpype
 from . import _jcustomizer
 
@@ -43,29 +41,6 @@ class _JStringProto:
     def __add__(self, other: str) -> str:
         return self.concat(other)  # type: ignore[attr-defined]
 
-    def __len__(self) -> int:
-        return self.length()  # type: ignore[attr-defined]
-
-    def __getitem__(self, i: typing.Union[slice, int]):
-        if isinstance(i, slice):
-            return str(self)[i]
-
-        if i < 0:
-            i += len(self)
-            if i < 0:
-                raise IndexError("Array index is negative")
-        if i >= len(self):
-            raise IndexError("Array index exceeds length")
-        return self.charAt(i)  # type: ignore[attr-defined]
-
-    def __contains__(self, other: str) -> bool:
-        return self.contains(other)  # type: ignore[attr-defined]
-
-    def __hash__(self):
-        if self == None:  # lgtm [py/test-equals-none]
-            return hash(None)
-        return self.__str__().__hash__()
-
     def __repr__(self):
         return "'%s'" % self.__str__()
 
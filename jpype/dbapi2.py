@@ -39,6 +39,8 @@ paramstyle = 'qmark'
 
 _SQLException = None
 _SQLTimeoutException = None
+_JPypeBatch = None
+_bufferColumnTypes = {}  # type: ignore[var-annotated]
 _registry = {}
 _types = []
 
@@ -1134,6 +1136,96 @@ class Cursor(object):
             self._rowcount = -1
         return self
 
+    def executecolumns(self, operation, columns, *, batchsize=None, keys=False):
+        """ (extension) Prepare a database operation and execute it against
+        parameters supplied by column.
+
+        This is a columnar form of ``.executemany()`` intended for bulk
+        loads.  Rather than binding each parameter of each row from Python,
+        each column is transferred to Java as a single array and the
+        parameters are bound and batched entirely in Java.
+
+        Columns may be Java arrays, objects supporting the buffer protocol
+        such as NumPy arrays of bool, int or float, or sequences.  Buffers
+        are bound with the matching primitive setter and cannot hold
+        nulls.  Sequences of str are bound with ``setString``.  Other
+        sequences have the connection adapters applied and are bound with
+        ``setObject``.  None is bound as a SQL NULL.
+
+        Args:
+           operation (str): A statement to be executed.
+           columns (list): A list of columns, one per parameter.  All
+               columns must be the same length.
+           batchsize (int, optional): The number of rows to send per
+               ``executeBatch``.  By default all rows are sent as one batch.
+           keys (bool, optional): Specify if the keys should be available to
+              retrieve. (Default False)
+
+        Returns:
+           This cursor.
+        """
+        self._last = None
+        self._parameterTypes = None
+        self._validate()
+        if isinstance(columns, str) or not isinstance(columns, typing.Sequence):
+            raise _UnsupportedTypeError("columns must be a sequence of columns")
+        # complete the previous operation
+        self._finish()
+        try:
+            if keys:
+                self._statement = self._jcx.prepareStatement(operation, 1)
+            else:
+                self._statement = self._jcx.prepareStatement(operation)
+        except TypeError as ex:
+            raise _UnsupportedTypeError(str(ex))
+        except _SQLException as ex:
+            raise ProgrammingError("Failed to prepare '%s'" % operation) from ex
+        count = self._statement.getParameterMetaData().getParameterCount()
+        if count != len(columns):
+            raise ProgrammingError("incorrect number of columns (%d!=%d)"
+                                   % (count, len(columns)))
+        if not self._connection._batch:  # pragma: no cover
+            return self._executeRepeat(zip(*columns))
+        jcolumns = [self._asColumn(c) for c in columns]
+        if len(set(len(c) for c in jcolumns)) > 1:
+            raise ProgrammingError("columns must be the same length")
+        if batchsize is None:
+            batchsize = 0
+        try:
+            self._rowcount = _JPypeBatch.execute(self._statement, jcolumns, batchsize)
+        except _SQLException as ex:
+            raise ProgrammingError(ex.message()) from ex
+        return self
+
+    def _asColumn(self, column):
+        if isinstance(column, _jpype.JArray):
+            return column
+        if isinstance(column, (str, bytes)):
+            raise _UnsupportedTypeError("column must be a sequence of values")
+        # Primitive buffers go to Java in a single transfer
+        try:
+            view = memoryview(column)
+        except TypeError:
+            view = None
+        if view is not None and view.ndim == 1:
+            tp = _bufferColumnTypes.get((view.format.lstrip("@=<>!"), view.itemsize), None)
+            if tp is not None:
+                return _jtypes.JArray(tp)(column)
+        if not isinstance(column, typing.Sequence):
+            column = list(column)
+        if all(isinstance(v, (str, type(None))) for v in column):
+            return _jtypes.JArray(_jtypes.JString)(column)
+        adapters = self._connection._adapters
+        out = list(column)
+        for i, v in enumerate(out):
+            a = adapters.get(type(v), None)
+            if a is not None:
+                out[i] = a(v)
+        try:
+            return _jtypes.JArray(_jtypes.JObject)(out)
+        except TypeError as ex:
+            raise _UnsupportedTypeError(str(ex)) from ex
+
     def _executeRepeat(self, seq_of_parameters):  # pragma: no cover
         counts = []
         if isinstance(seq_of_parameters, typing.Iterable):
@@ -1398,9 +1490,10 @@ _accepted = set(["exact", "implicit"])
 
 
 def _populateTypes():
-    global _SQLException, _SQLTimeoutException
+    global _SQLException, _SQLTimeoutException, _JPypeBatch
     _SQLException = _jpype.JClass("java.sql.SQLException")
     _SQLTimeoutException = _jpype.JClass("java.sql.SQLTimeoutException")
+    _JPypeBatch = _jpype.JClass("org.jpype.sql.JPypeBatch")
     cs = _jpype.JClass("java.sql.CallableStatement")
     ps = _jpype.JClass("java.sql.PreparedStatement")
     rs = _jpype.JClass("java.sql.ResultSet")
@@ -1443,6 +1536,21 @@ def _populateTypes():
     _default_converters[java.math.BigDecimal] = _asPython
     _default_converters[byteArray] = bytes
     _default_converters[type(None)] = _nop
+
+    # Buffer formats (code, itemsize) bound by executecolumns
+    _bufferColumnTypes[("?", 1)] = _jtypes.JBoolean
+    _bufferColumnTypes[("b", 1)] = _jtypes.JByte
+    _bufferColumnTypes[("B", 1)] = _jtypes.JShort
+    _bufferColumnTypes[("h", 2)] = _jtypes.JShort
+    _bufferColumnTypes[("H", 2)] = _jtypes.JInt
+    _bufferColumnTypes[("i", 4)] = _jtypes.JInt
+    _bufferColumnTypes[("l", 4)] = _jtypes.JInt
+    _bufferColumnTypes[("I", 4)] = _jtypes.JLong
+    _bufferColumnTypes[("L", 4)] = _jtypes.JLong
+    _bufferColumnTypes[("l", 8)] = _jtypes.JLong
+    _bufferColumnTypes[("q", 8)] = _jtypes.JLong
+    _bufferColumnTypes[("f", 4)] = _jtypes.JFloat
+    _bufferColumnTypes[("d", 8)] = _jtypes.JDouble
     # Adaptors can be installed after the JVM is started
     # JByteArray = _jpype.JArray(_jtypes.JByte)
     # VARCHAR.adapters[memoryview] = JByteArray
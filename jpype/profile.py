@@ -0,0 +1,157 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+""" Profile the calls made from Python to Java methods.
+
+Python profilers see a call to a Java method as a single opaque call.  This
+module reports each Java method called, how often and where the time went:
+finding the overload, converting the arguments, running in Java with the GIL
+released, and converting the return.
+
+Every call is counted, but only one call in each ``interval`` is timed.  The
+times reported are scaled up to estimate the total over all calls.
+
+.. code-block:: python
+
+    import jpype.profile
+
+    jpype.profile.enable()
+    run_workload()
+    jpype.profile.disable()
+    jpype.profile.dump("java.prof")
+
+    import pstats
+    pstats.Stats("java.prof").sort_stats("cumulative").print_stats(10)
+"""
+import marshal
+
+import _jpype
+
+__all__ = ['enable', 'disable', 'stats', 'dump', 'perfMap', 'monitoring']
+
+_PHASES = ("match", "convert", "java", "return")
+
+
+def enable(interval=10):
+    """ Start profiling calls to Java methods.
+
+    Args:
+        interval (int): Time one call in this many for each method.  Use 1
+          to time every call.
+    """
+    _jpype.profileConfig({"enabled": True, "interval": interval})
+
+
+def disable():
+    """ Stop profiling calls to Java methods.
+
+    The results are kept until they are read with ``reset=True``.
+    """
+    _jpype.profileConfig({"enabled": False})
+
+
+def stats(reset=False):
+    """ Get the profile for each Java method called.
+
+    Args:
+        reset (bool): Clear the results after they are read.
+
+    Returns:
+        dict: A dict mapping the name of each method to a dict holding the
+        number of ``calls``, the number of ``cache_hits`` when the overload was
+        taken from the cache of the last match, the number of calls
+        ``sampled``, and the estimated ``match_ns``, ``convert_ns``,
+        ``java_ns``, ``return_ns`` and ``total_ns`` over all calls.
+    """
+    out = {}
+    for (cls, name), entry in _jpype.profileStats(reset).items():
+        sampled = entry["sampled"]
+        scale = entry["calls"] / sampled if sampled else 0
+        result = {
+            "calls": entry["calls"],
+            "cache_hits": entry["cache_hits"],
+            "sampled": sampled,
+        }
+        total = 0
+        for phase in _PHASES:
+            t = int(entry[phase + "_ns"] * scale)
+            result[phase + "_ns"] = t
+            total += t
+        result["total_ns"] = total
+        out["%s.%s" % (cls, name)] = result
+    return out
+
+
+def dump(filename, reset=False):
+    """ Write the profile in the format read by ``pstats``.
+
+    Each method appears with the class as the file name.  The internal time
+    of a method is the cost of the bridge, and the time spent in Java appears
+    as a separate function called by it, named for the method with a
+    ``[java]`` suffix.
+
+    Args:
+        filename (str): The file to write.
+        reset (bool): Clear the results after they are read.
+    """
+    out = {}
+    for key, entry in stats(reset).items():
+        cls, _, name = key.rpartition(".")
+        calls = entry["calls"]
+        total = entry["total_ns"] / 1e9
+        java = entry["java_ns"] / 1e9
+        func = (cls, 0, name)
+        out[func] = (calls, calls, total - java, total, {})
+        out[(cls, 0, name + " [java]")] = (calls, calls, java, java,
+                                           {func: (calls, calls, java, java)})
+    with open(filename, "wb") as fd:
+        marshal.dump(out, fd)
+
+
+def perfMap(enabled=True):
+    """ Name Java methods in the perf map for native profilers.
+
+    Each Java method called is given a small native entry point and its
+    address is written to ``/tmp/perf-<pid>.map``, so ``perf`` and tools that
+    read perf maps show ``java::java.util.HashMap.get`` rather than the
+    generic call of a JPype method.  Only supported on Linux for x86-64
+    and ARM64.
+
+    Args:
+        enabled (bool): Turn the perf map on or off.
+
+    Raises:
+        NotImplementedError: If the platform is not supported.
+    """
+    _jpype.instrumentConfig({"perf_map": enabled})
+
+
+def monitoring(enabled=True):
+    """ Report calls to Java methods to ``sys.monitoring``.
+
+    Each call to a Java method fires ``PY_START`` and then ``PY_RETURN`` or
+    ``PY_UNWIND`` with a code object whose ``co_filename`` is the class name
+    and ``co_name`` is the method name, so profilers which use
+    ``sys.monitoring`` report the Java method by name.  Requires Python 3.13.
+
+    Args:
+        enabled (bool): Turn the events on or off.
+
+    Raises:
+        NotImplementedError: If this version of Python is not supported.
+    """
+    _jpype.instrumentConfig({"monitoring": enabled})
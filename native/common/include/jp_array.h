@@ -59,6 +59,14 @@ public:
 	jsize     getLength() const;
 	void       setRange(jsize start, jsize length, jsize step, PyObject* val);
 	JPPyObject getItem(jsize ndx);
+
+	/**
+	 * Get a range of elements as a Python list.
+	 *
+	 * @param start is the first element relative to this view.
+	 * @param length is the number of elements.
+	 */
+	JPPyObject getRange(jsize start, jsize length);
 	void       setItem(jsize ndx, PyObject*);
 
 	/**
@@ -0,0 +1,201 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef JP_ASYNC_H
+#define JP_ASYNC_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * A Java result waiting to be delivered to Python.
+ *
+ * The value and error are global references.
+ */
+struct JPAsyncCompletion
+{
+	JPAsyncCompletion *next;
+	jlong token;
+	jobject value;
+	jobject error;
+} ;
+
+/**
+ * A proxy call from a Java thread waiting for a Python thread.
+ *
+ * The request lives on the stack of the calling thread, which is parked
+ * until the request is done.  All references are global.
+ */
+struct JPCallbackRequest
+{
+	JPCallbackRequest *next;
+	jlong host;
+	jlong returnType;
+	jobject name;
+	jobject parameterTypes;
+	jobject args;
+	jobject missing;
+	jobject result;
+	jobject error;
+	bool done;
+	bool cancelled;
+	std::mutex lock;
+	std::condition_variable ready;
+} ;
+
+/**
+ * Delivers the results of Java futures to Python.
+ *
+ * Each future watched for Python holds a token naming the Python future to
+ * complete and the type of the result.  Calls to queued proxies are passed
+ * to Python in the same way.  Java threads report completions
+ * through a lock-free stack without taking the GIL.  The push that finds the
+ * stack empty writes one byte to a wake-up socket watched by the event loop,
+ * which then drains every completion in a single pass under the GIL.  Queued
+ * calls have their own socket, read only by loops serving them.
+ */
+class JPAsync
+{
+public:
+
+	explicit JPAsync(JPContext *context);
+	~JPAsync();
+
+	void init(JPJavaFrame& frame);
+
+	/**
+	 * Set the socket that is written to when completions are ready.
+	 */
+	void setWakeup(long long fd);
+
+	/**
+	 * Set the socket that is written to when queued proxy calls are ready.
+	 *
+	 * This is separate from the completion wake-up so that only loops
+	 * serving callbacks read it.
+	 */
+	void setCallbackWakeup(long long fd);
+
+	/**
+	 * Create a token for a Python future.
+	 *
+	 * The token is owned by Java once it has been passed to call or watch.
+	 */
+	jlong newToken(PyObject *future, JPClass *returnType);
+
+	/**
+	 * Release a token that was never submitted.
+	 */
+	void releaseToken(jlong token);
+
+	/**
+	 * Invoke a method on a Java executor.
+	 *
+	 * This does not use Python so it may be called without the GIL.
+	 *
+	 * @param executor is the executor to use or null for the shared pool.
+	 * @return the CompletableFuture for the call.
+	 */
+	jobject call(JPJavaFrame& frame, jlong token, jobject method,
+			jobject obj, jobject args, jobject executor);
+
+	/**
+	 * Complete a Python future when a CompletionStage finishes.
+	 *
+	 * A handler is registered on the stage so no thread waits on it.
+	 */
+	void watch(JPJavaFrame& frame, jlong token, jobject stage);
+
+	/**
+	 * Queue a completion.
+	 *
+	 * This is called from Java threads and must not touch Python.
+	 */
+	void complete(JNIEnv *env, jlong token, jobject value, jobject error);
+
+	/**
+	 * Queue a proxy call and wait for a Python thread to run it.
+	 *
+	 * This is called from Java threads without the GIL.  Any exception
+	 * raised by the call is rethrown in the calling thread.  If the
+	 * consumers stop before the call is run, or no consumer takes the call
+	 * within the callback timeout, a RuntimeException is thrown.
+	 *
+	 * @param out receives the result of the call.
+	 * @return false if no consumer is running, in which case the caller
+	 * must run the call itself.
+	 */
+	bool queueCallback(JNIEnv *env, jstring name, jlong host, jlong returnType,
+			jlongArray parameterTypes, jobjectArray args, jobject missing, jobject &out);
+
+	/**
+	 * Add or remove a Python thread or loop that runs queued calls.
+	 *
+	 * Removing the last consumer fails every call still waiting.
+	 *
+	 * @return the number of consumers.
+	 */
+	int setConsumer(bool add);
+
+	/**
+	 * Fail every waiting call and stop queuing new ones.
+	 *
+	 * Called when the JVM shuts down.  This does not use Python or Java.
+	 */
+	void stopCallbacks();
+
+	/**
+	 * Run queued proxy calls.
+	 *
+	 * The GIL is released while waiting, then every queued call is run
+	 * under one hold of the GIL.
+	 *
+	 * @param timeout is the time to wait in seconds, 0 to poll, or
+	 * negative to wait until a call arrives.
+	 * @return the number of calls that were run.
+	 */
+	int runCallbacks(JPJavaFrame& frame, double timeout);
+
+	/**
+	 * Take every queued completion.
+	 *
+	 * @return a list of (future, value, exception) tuples in completion
+	 * order.
+	 */
+	JPPyObject drain(JPJavaFrame& frame);
+
+private:
+	static void wake(long long fd);
+	void cancelCallbacks();
+	bool withdrawCallback(JPCallbackRequest *request);
+	JPPyObject convertResult(JPJavaFrame& frame, JPClass *returnType, jobject value);
+
+	JPContext *m_Context;
+	std::atomic<JPAsyncCompletion*> m_Head{nullptr};
+	std::atomic<long long> m_WakeFd{-1};
+	std::atomic<long long> m_CallbackFd{-1};
+	std::atomic<JPCallbackRequest*> m_Callbacks{nullptr};
+	std::mutex m_CallbackLock;
+	std::condition_variable m_CallbackReady;
+	// Guarded by m_CallbackLock
+	int m_Consumers{0};
+	bool m_Stopped{false};
+	jclass m_AsyncClass{};
+	jmethodID m_CallID{};
+	jmethodID m_WatchID{};
+} ;
+
+#endif /* JP_ASYNC_H */
@@ -15,28 +15,15 @@
  *****************************************************************************/
 #ifndef _JPBYTE_TYPE_H_
 #define _JPBYTE_TYPE_H_
+#include "jp_primitivetraits.h"
 
-class JPByteType : public JPPrimitiveType
+class JPByteType : public JPPrimitiveTypeImpl<JPByteType, jbyte>
 {
 public:
 
 	JPByteType();
 	~JPByteType() override;
 
-public:
-	using type_t = jbyte;
-	using array_t = jbyteArray;
-
-	static inline jbyte& field(jvalue& v)
-	{
-		return v.b;
-	}
-
-	static inline const jbyte& field(const jvalue& v)
-	{
-		return v.b;
-	}
-
 	JPClass* getBoxedClass(JPContext *context) const override
 	{
 		return context->_java_lang_Byte;
@@ -47,18 +34,10 @@ public:
 	JPPyObject  convertToPythonObject(JPJavaFrame &frame, jvalue val, bool cast) override;
 	JPValue     getValueFromObject(const JPValue& obj) override;
 
-	JPPyObject  invokeStatic(JPJavaFrame& frame, jclass, jmethodID, jvalue*) override;
-	JPPyObject  invoke(JPJavaFrame& frame, jobject, jclass, jmethodID, jvalue*) override;
-
-	JPPyObject  getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid) override;
-	void        setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* val) override;
-	JPPyObject  getField(JPJavaFrame& frame, jobject c, jfieldID fid) override;
-	void        setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* val) override;
-
-	jarray      newArrayOf(JPJavaFrame& frame, jsize size) override;
-	void        setArrayRange(JPJavaFrame& frame, jarray, jsize start, jsize length, jsize step, PyObject*) override;
-	JPPyObject  getArrayItem(JPJavaFrame& frame, jarray, jsize ndx) override;
-	void        setArrayItem(JPJavaFrame& frame, jarray, jsize ndx, PyObject* val) override;
+	/**
+	 * Convert an item for a bulk assignment from a sequence.
+	 */
+	type_t convertItem(PyObject* item);
 
 	char getTypeCode() override
 	{
@@ -84,17 +63,6 @@ public:
 		return field(v);
 	}
 
-	void getView(JPArrayView& view) override;
-	void releaseView(JPArrayView& view) override;
-	const char* getBufferFormat() override;
-	Py_ssize_t getItemSize() override;
-	void copyElements(JPJavaFrame &frame,
-			jarray a, jsize start, jsize len,
-			void* memory, int offset) override;
-
-	PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer &buffer, int subs, int base, jobject dims) override;
-
 private:
 	static const jlong _Byte_Min = 127;
 	static const jlong _Byte_Max = -128;
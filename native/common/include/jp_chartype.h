@@ -15,30 +15,17 @@
  *****************************************************************************/
 #ifndef _JP_CHAR_TYPE_H_
 #define _JP_CHAR_TYPE_H_
+#include "jp_primitivetraits.h"
 
-class JPCharType : public JPPrimitiveType
+class JPCharType : public JPPrimitiveTypeImpl<JPCharType, jchar>
 {
 public:
 
 	JPCharType();
 	~JPCharType() override;
 
-public:
-	using type_t = jchar;
-	using array_t = jcharArray;
-
 	JPValue newInstance(JPJavaFrame& frame, JPPyObjectVector& args) override;
 
-	inline jchar& field(jvalue& v)
-	{
-		return v.c;
-	}
-
-	inline jchar field(const jvalue& v) const
-	{
-		return v.c;
-	}
-
 	JPClass* getBoxedClass(JPContext *context) const override
 	{
 		return context->_java_lang_Character;
@@ -49,18 +36,10 @@ public:
 	JPPyObject  convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast) override;
 	JPValue     getValueFromObject(const JPValue& obj) override;
 
-	JPPyObject  invokeStatic(JPJavaFrame& frame, jclass, jmethodID, jvalue*) override;
-	JPPyObject  invoke(JPJavaFrame& frame, jobject, jclass, jmethodID, jvalue*) override;
-
-	JPPyObject  getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid) override;
-	void        setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* val) override;
-	JPPyObject  getField(JPJavaFrame& frame, jobject c, jfieldID fid) override;
-	void        setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* val) override;
-
-	jarray      newArrayOf(JPJavaFrame& frame, jsize size) override;
-	void        setArrayRange(JPJavaFrame& frame, jarray, jsize start, jsize length, jsize step, PyObject*) override;
-	JPPyObject  getArrayItem(JPJavaFrame& frame, jarray, jsize ndx) override;
-	void        setArrayItem(JPJavaFrame& frame, jarray, jsize ndx, PyObject* val) override;
+	/**
+	 * Convert an item for a bulk assignment from a sequence.
+	 */
+	type_t convertItem(PyObject* item);
 
 	char getTypeCode() override
 	{
@@ -77,17 +56,6 @@ public:
 		return field(v);
 	}
 
-	void getView(JPArrayView& view) override;
-	void releaseView(JPArrayView& view) override;
-	const char* getBufferFormat() override;
-	Py_ssize_t getItemSize() override;
-	void copyElements(JPJavaFrame &frame,
-			jarray a, jsize start, jsize len,
-			void* memory, int offset) override;
-
-	PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer &buffer, int subs, int base, jobject dims) override;
-
 } ;
 
 #endif // _JP-CHAR_TYPE_H_
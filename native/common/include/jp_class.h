@@ -83,6 +83,22 @@ public:
 		return JPModifier::isInterface(m_Modifiers);
 	}
 
+	/**
+	 * Instances of immutable classes have their Python hash cached.
+	 *
+	 * Strings, boxed types and enums are immutable.  Other classes can be
+	 * marked by a customizer.
+	 */
+	bool isImmutable() const
+	{
+		return m_Immutable;
+	}
+
+	void setImmutable(bool immutable)
+	{
+		m_Immutable = immutable;
+	}
+
 	virtual bool isArray() const
 	{
 		return false;
@@ -180,6 +196,19 @@ public:
 	virtual void        setArrayRange(JPJavaFrame& frame, jarray,
 			jsize start, jsize length, jsize step, PyObject* vals);
 	virtual JPPyObject  getArrayItem(JPJavaFrame& frame, jarray, jsize ndx);
+
+	/**
+	 * Convert a range of an array into a Python list.
+	 *
+	 * @param frame is the frame to hold the local references.
+	 * @param a is the array.
+	 * @param start is the first element.
+	 * @param length is the number of elements.
+	 * @param step is the distance between elements.
+	 * @return a new list.
+	 */
+	virtual JPPyObject  getArrayRange(JPJavaFrame& frame, jarray a,
+			jsize start, jsize length, jsize step);
 	virtual void        setArrayItem(JPJavaFrame& frame, jarray, jsize ndx, PyObject* val);
 
 	/**
@@ -213,6 +242,7 @@ protected:
 	JPFieldList          m_Fields;
 	string               m_CanonicalName;
 	jint                 m_Modifiers;
+	bool                 m_Immutable;
 	JPPyObject           m_Host;
 	JPPyObject           m_Hints;
 } ;
@@ -16,6 +16,8 @@
 #ifndef JP_CLASSHINTS_H
 #define JP_CLASSHINTS_H
 
+#include <unordered_map>
+
 class JPConversion
 {
 public:
@@ -52,6 +54,8 @@ public:
 	jvalue convert(JPMatch &match) override;
 } ;
 
+class JPHintConversion;
+
 class JPClassHints
 {
 public:
@@ -63,6 +67,10 @@ public:
 	 * Searches the list for a conversion. The first conversion better than
 	 * explicit is returned immediately.
 	 *
+	 * The search uses a plan for the Python type of the object which holds
+	 * only the conversions that can apply.  Type tests that depend only on
+	 * the type are resolved when the plan is built.
+	 *
 	 * @returns the quality of the match
 	 */
 	JPMatch::Type getConversion(JPMatch& match, JPClass *cls);
@@ -99,7 +107,26 @@ public:
 	void getInfo(JPClass *cls, JPConversionInfo &info);
 
 private:
-	std::list<JPConversion*> conversions;
+
+	/**
+	 * Conversions that may apply to one Python type.
+	 *
+	 * Each entry is either already known to match or must be tested against
+	 * each object.
+	 */
+	struct Plan
+	{
+		JPPyObject type;
+		std::vector<std::pair<JPHintConversion*, bool>> entries;
+	} ;
+
+	Plan& getPlan(PyObject *obj);
+	void invalidate();
+
+	std::list<JPHintConversion*> conversions;
+	std::unordered_map<PyTypeObject*, Plan> m_Plans;
+	bool m_UsesAbc = false;
+	PyObject *m_AbcToken = nullptr;
 } ;
 
 extern JPConversion *hintsConversion;
@@ -16,6 +16,7 @@
 #ifndef JP_CONTEXT_H
 #define JP_CONTEXT_H
 #include <jpype.h>
+#include <atomic>
 #include <list>
 
 /** JPClass is a bit heavy when we just need to hold a
@@ -74,6 +75,7 @@ using JPThrowableRef = JPRef<jthrowable>;
 
 class JPStackInfo;
 class JPGarbageCollection;
+class JPAsync;
 
 void assertJVMRunning(JPContext* context, const JPStackInfo& info);
 
@@ -111,6 +113,18 @@ int hasInterrupt();
  * other JPype C++ resources are owned by Java. Java will delete them as needed.
  * The context itself belongs to Python.
  */
+/**
+ * Counters for threads attached by JPype.
+ */
+struct JPAttachStats
+{
+	long long attached;
+	long long attaches;
+	long long detaches;
+	long long auto_detaches;
+	long long attach_time;
+} ;
+
 class JPContext
 {
 public:
@@ -134,6 +148,15 @@ public:
 	bool isThreadAttached();
 	void detachCurrentThread();
 
+	/**
+	 * Called when a native thread exits.
+	 *
+	 * Threads attached by JPype are detached automatically so that their
+	 * Java Thread objects are released.
+	 */
+	void onThreadExit();
+	void getAttachStats(JPAttachStats& stats);
+
 	JNIEnv* getEnv();
 
 	JavaVM* getJavaVM()
@@ -202,6 +225,7 @@ public:
 private:
 
 	void loadEntryPoints(const string& path);
+	JNIEnv* attach(bool daemon);
 
 	jint(JNICALL * CreateJVM_Method)(JavaVM **pvm, void **penv, void *args){};
 	jint(JNICALL * GetCreatedJVMs_Method)(JavaVM **pvm, jsize size, jsize * nVms){};
@@ -210,6 +234,12 @@ private:
 
 	JavaVM *m_JavaVM{};
 
+	// Thread attachment counters
+	std::atomic<long long> m_Attaches{0};
+	std::atomic<long long> m_Detaches{0};
+	std::atomic<long long> m_AutoDetaches{0};
+	std::atomic<long long> m_AttachTime{0};
+
 	// Java half
 	JPObjectRef m_JavaContext;
 
@@ -232,6 +262,8 @@ private:
 	jmethodID m_Class_GetNameID{};
 	jmethodID m_Context_collectRectangularID{};
 	jmethodID m_Context_assembleID{};
+	jmethodID m_Context_FillStringsID{};
+	jmethodID m_Context_StoreRangeID{};
 	jmethodID m_String_ToCharArrayID{};
 	jmethodID m_Context_CreateExceptionID{};
 	jmethodID m_Context_GetExcClassID{};
@@ -265,6 +297,7 @@ private:
 	bool m_Embedded;
 public:
 	JPGarbageCollection *m_GC;
+	JPAsync *m_Async;
 
 	// This will gather C++ resources to clean up after shutdown.
 	std::list<JPResource*> m_Resources;
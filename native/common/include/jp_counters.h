@@ -0,0 +1,152 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef JP_COUNTERS_H
+#define JP_COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Events counted at the boundary between Python and Java.
+ *
+ * Names must match JPCounters::getName.
+ */
+enum JPCounter
+{
+	JPCOUNT_JNI_CALL = 0,
+	JPCOUNT_FRAME,
+	JPCOUNT_GLOBAL_NEW,
+	JPCOUNT_GLOBAL_DELETE,
+	JPCOUNT_GIL_RELEASE,
+	JPCOUNT_GIL_ACQUIRE,
+	JPCOUNT_DISPATCH_HIT,
+	JPCOUNT_DISPATCH_MISS,
+	JPCOUNT_TO_JAVA_EXACT,
+	JPCOUNT_TO_JAVA_DERIVED,
+	JPCOUNT_TO_JAVA_IMPLICIT,
+	JPCOUNT_TO_JAVA_EXPLICIT,
+	JPCOUNT_TO_PYTHON_PRIMITIVE,
+	JPCOUNT_TO_PYTHON_STRING,
+	JPCOUNT_TO_PYTHON_ARRAY,
+	JPCOUNT_TO_PYTHON_OBJECT,
+	JPCOUNT_SIZE
+} ;
+
+/**
+ * Durations recorded in histograms when timing is enabled.
+ */
+enum JPTimer
+{
+	JPTIME_JAVA_CALL = 0,
+	JPTIME_GIL_WAIT,
+	JPTIME_SIZE
+} ;
+
+// Histogram buckets are powers of two in nanoseconds
+const int JPTIME_BUCKETS = 40;
+
+/**
+ * Counters that stay compiled in and are enabled at run time.
+ *
+ * Each thread updates its own shard so counting does not contend on a
+ * shared cache line.  A snapshot sums the shards of live threads with the
+ * totals of threads that have exited.  When disabled, the cost is one
+ * relaxed load of a flag at each site.
+ */
+class JPCounters
+{
+public:
+
+	struct Histogram
+	{
+		uint64_t count;
+		uint64_t total;
+		uint64_t buckets[JPTIME_BUCKETS];
+	} ;
+
+	struct Snapshot
+	{
+		uint64_t counts[JPCOUNT_SIZE];
+		Histogram timers[JPTIME_SIZE];
+	} ;
+
+	static bool isEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	static bool isTiming()
+	{
+		return s_Timing.load(std::memory_order_relaxed);
+	}
+
+	static void setEnabled(bool enabled, bool timing);
+
+	static void add(JPCounter counter);
+	static void record(JPTimer timer, uint64_t ns);
+
+	/**
+	 * Sum the counts of all threads.
+	 *
+	 * @param reset clears the counts after they are read.
+	 */
+	static void snapshot(Snapshot& out, bool reset);
+
+	static const char* getName(JPCounter counter);
+	static const char* getName(JPTimer timer);
+
+private:
+	static std::atomic<bool> s_Enabled;
+	static std::atomic<bool> s_Timing;
+} ;
+
+/**
+ * Record the lifetime of a scope in a timing histogram.
+ */
+class JPCounterTimer
+{
+public:
+
+	explicit JPCounterTimer(JPTimer timer)
+	: m_Timer(timer), m_Active(JPCounters::isTiming())
+	{
+		if (m_Active)
+			m_Start = std::chrono::steady_clock::now();
+	}
+
+	~JPCounterTimer()
+	{
+		if (m_Active)
+		{
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - m_Start).count();
+			JPCounters::record(m_Timer, (uint64_t) ns);
+		}
+	}
+
+	JPCounterTimer(const JPCounterTimer&) = delete;
+	JPCounterTimer& operator=(const JPCounterTimer&) = delete;
+
+private:
+	JPTimer m_Timer;
+	bool m_Active;
+	std::chrono::steady_clock::time_point m_Start;
+} ;
+
+#define JP_COUNT(X) do { if (JPCounters::isEnabled()) JPCounters::add(X); } while (0)
+
+#endif /* JP_COUNTERS_H */
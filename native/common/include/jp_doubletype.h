@@ -15,28 +15,15 @@
  *****************************************************************************/
 #ifndef _JP_DOUBLE_TYPE_H_
 #define _JP_DOUBLE_TYPE_H_
+#include "jp_primitivetraits.h"
 
-class JPDoubleType : public JPPrimitiveType
+class JPDoubleType : public JPPrimitiveTypeImpl<JPDoubleType, jdouble>
 {
 public:
 
 	JPDoubleType();
 	~JPDoubleType() override = default;
 
-public:
-	using type_t = jdouble;
-	using array_t = jdoubleArray;
-
-	static inline jdouble& field(jvalue& v)
-	{
-		return v.d;
-	}
-
-	static inline const jdouble& field(const jvalue& v)
-	{
-		return v.d;
-	}
-
 	JPClass* getBoxedClass(JPContext *context) const override
 	{
 		return context->_java_lang_Double;
@@ -47,19 +34,10 @@ public:
 	JPPyObject  convertToPythonObject(JPJavaFrame &frame, jvalue val, bool cast) override;
 	JPValue     getValueFromObject(const JPValue& obj) override;
 
-	JPPyObject  invokeStatic(JPJavaFrame &frame, jclass, jmethodID, jvalue*) override;
-	JPPyObject  invoke(JPJavaFrame &frame, jobject, jclass, jmethodID, jvalue*) override;
-
-	JPPyObject  getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid) override;
-	void        setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* val) override;
-	JPPyObject  getField(JPJavaFrame& frame, jobject c, jfieldID fid) override;
-	void        setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* val) override;
-
-	jarray      newArrayOf(JPJavaFrame& frame, jsize size) override;
-	void        setArrayRange(JPJavaFrame& frame, jarray,
-			jsize start, jsize length, jsize step, PyObject*) override;
-	JPPyObject  getArrayItem(JPJavaFrame& frame, jarray, jsize ndx) override;
-	void        setArrayItem(JPJavaFrame& frame, jarray, jsize ndx, PyObject* val) override;
+	/**
+	 * Convert an item for a bulk assignment from a sequence.
+	 */
+	type_t convertItem(PyObject* item);
 
 	char getTypeCode() override
 	{
@@ -80,17 +58,6 @@ public:
 		return (jdouble) field(v);
 	}
 	// GCOV_EXCL_STOP
-
-	void getView(JPArrayView& view) override;
-	void releaseView(JPArrayView& view) override;
-	const char* getBufferFormat() override;
-	Py_ssize_t getItemSize() override;
-	void copyElements(JPJavaFrame &frame,
-			jarray a, jsize start, jsize len,
-			void* memory, int offset) override;
-
-	PyObject *newMultiArray(JPJavaFrame &frame,
-			JPPyBuffer& view, int subs, int base, jobject dims) override;
 } ;
 
 #endif // _JP_DOUBLE_TYPE_H_
@@ -24,6 +24,74 @@ struct JPGCStats
 	long long max_rss;
 	long long min_rss;
 	long long python_triggered;
+	long long python_collections;
+	long long java_triggered;
+	long long skipped;
+	long long java_used;
+	long long java_committed;
+	long long java_max;
+	long long java_collections;
+	long long java_collection_time;
+} ;
+
+/**
+ * Snapshot of the Java heap.
+ */
+struct JPGCHeap
+{
+	jlong used;
+	jlong committed;
+	jlong max;
+	jlong collections;
+	jlong collection_time;
+	jlong used_after_collection;
+} ;
+
+/**
+ * Tunables for the garbage collection coordinator.
+ */
+struct JPGCConfig
+{
+	JPGCConfig();
+
+	// Name of the policy ("adaptive", "heap" or "none")
+	string policy;
+	// Growth of the process in bytes before a Java collection is considered
+	long long delta;
+	// Fraction of the Java heap in use that triggers a collection
+	double heap_fraction;
+	// Minimum time between requested collections in milliseconds
+	long long interval;
+	// Request collections without blocking the Python thread
+	bool async;
+} ;
+
+class JPGarbageCollection;
+
+/**
+ * Decides when a Python collection should be followed by a Java collection.
+ */
+class JPGCPolicy
+{
+public:
+
+	virtual ~JPGCPolicy() = default;
+
+	/**
+	 * Called when the coordinator starts or the policy is selected.
+	 *
+	 * @param current is the current working set size.
+	 */
+	virtual void reset(size_t current) = 0;
+
+	/**
+	 * Called at the end of each Python collection.
+	 *
+	 * @param gc is the coordinator.
+	 * @param current is the current working set size.
+	 * @return true if Java should collect.
+	 */
+	virtual bool decide(JPGarbageCollection& gc, size_t current) = 0;
 } ;
 
 class JPGarbageCollection
@@ -31,6 +99,7 @@ class JPGarbageCollection
 public:
 
 	explicit JPGarbageCollection(JPContext *context);
+	~JPGarbageCollection();
 
 	void init(JPJavaFrame& frame);
 
@@ -49,15 +118,43 @@ public:
 
 	void getStats(JPGCStats& stats);
 
+	/**
+	 * Read the Java heap figures.
+	 *
+	 * @return false if the heap could not be read.
+	 */
+	bool getJavaHeap(JPGCHeap& heap);
+
+	const JPGCConfig& getConfig() const
+	{
+		return m_Config;
+	}
+
+	/**
+	 * Change the tunables.
+	 *
+	 * Selecting a different policy resets its state.
+	 *
+	 * @throws ValueError if the policy is not known.
+	 */
+	void setConfig(const JPGCConfig& config);
+
 private:
+	void requestCollection();
+
 	JPContext *m_Context;
+	JPGCConfig m_Config;
+	JPGCPolicy *m_Policy;
 	bool running;
 	bool in_python_gc;
 	bool java_triggered;
 	PyObject *python_gc;
 	jclass _SystemClass;
 	jclass _ContextClass;
+	jclass _MonitorClass;
 	jmethodID _gcMethodID;
+	jmethodID _heapStatsID;
+	jmethodID _requestID;
 
 	jmethodID _totalMemoryID;
 	jmethodID _freeMemoryID;
@@ -69,11 +166,11 @@ private:
 	size_t last_java;
 	size_t low_water;
 	size_t high_water;
-	size_t limit;
-	size_t last;
+	long long last_request;
 	int java_count;
 	int python_count;
 	int python_triggered;
+	int skipped;
 } ;
 
 #endif /* JP_GC_H */
@@ -172,6 +172,8 @@ public:
 	jint hashCode(jobject o);
 	jobject collectRectangular(jarray obj);
 	jobject assemble(jobject dims, jobject parts);
+	void fillStrings(jobjectArray array, jintArray indices, jcharArray chars, jintArray ends);
+	void storeRange(jobjectArray src, jobjectArray dest, jint start, jint step);
 
 	jobject newArrayInstance(jclass c, jintArray dims);
 	jthrowable getCause(jthrowable th);
@@ -358,6 +360,7 @@ public:
 
 	// Object
 	jclass GetObjectClass(jobject obj);
+	bool IsSameObject(jobject obj1, jobject obj2);
 	jobject GetStaticObjectField(jclass clazz, jfieldID fid);
 	jobject GetObjectField(jobject clazz, jfieldID fid);
 	void SetStaticObjectField(jclass clazz, jfieldID fid, jobject val);
@@ -382,6 +385,8 @@ public:
 	const char* GetStringUTFChars(jstring a0, jboolean* a1);
 	void ReleaseStringUTFChars(jstring a0, const char* a1);
 	jsize GetStringUTFLength(jstring a0);
+	jsize GetStringLength(jstring a0);
+	void GetStringRegion(jstring a0, jsize a1, jsize a2, jchar* a3);
 
 	jboolean isPackage(const string& str);
 	jobject getPackage(const string& str);
@@ -88,6 +88,8 @@ public:
 	std::vector<JPMatch> m_Arguments;
 	JPMatch::Type m_Type;
 	bool m_IsVarIndirect;
+	// The overload was taken from the cache of the last match
+	bool m_Cached;
 	char m_Offset;
 	char m_Skip;
 } ;
@@ -48,8 +48,21 @@ public:
 	 *
 	 */
 	JPMatch::Type matches(JPJavaFrame &frame, JPMethodMatch& match, bool isInstance, JPPyObjectVector& args);
-	JPPyObject invoke(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
-	JPPyObject invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg, bool instance);
+	JPPyObject invoke(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance, bool numpy);
+	JPPyObject invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg,
+			bool instance, JPPrimitiveType *component);
+
+	/**
+	 * Submit a call to run on a Java executor.
+	 *
+	 * The result is delivered to a Python future when the call finishes.
+	 *
+	 * @param future is the Python future to complete.
+	 * @param executor is the Java executor or null for the shared pool.
+	 * @return the CompletableFuture for the call.
+	 */
+	JPPyObject invokeAsync(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg,
+			PyObject *future, jobject executor);
 	JPValue invokeConstructor(JPJavaFrame &frame, JPMethodMatch& match, JPPyObjectVector& arg);
 
 	bool isAbstract() const
@@ -101,7 +114,10 @@ public:
 
 private:
 	void packArgs(JPJavaFrame &frame, JPMethodMatch &match, vector<jvalue> &v, JPPyObjectVector &arg);
+	jobjectArray packObjectArgs(JPJavaFrame &frame, JPMethodMatch &match, JPPyObjectVector &arg, jobject &self);
 	void ensureTypeCache();
+	JPPyObject invokeNumPy(JPJavaFrame &frame, JPPrimitiveType *component,
+			jobject obj, jclass clazz, jvalue* val);
 
 	JPMethod(const JPMethod& o);
 
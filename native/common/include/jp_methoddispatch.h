@@ -63,8 +63,16 @@ public:
 		return JPModifier::isBeanAccessor(m_Modifiers);
 	}
 
-	JPPyObject invoke(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance);
+	/**
+	 * Call the best matching overload.
+	 *
+	 * @param numpy is true to return primitive arrays as NumPy arrays for
+	 * this call.
+	 */
+	JPPyObject invoke(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance, bool numpy);
 	JPValue invokeConstructor(JPJavaFrame& frame, JPPyObjectVector& vargs);
+	JPPyObject invokeAsync(JPJavaFrame& frame, JPPyObjectVector& vargs, bool instance,
+			PyObject *future, jobject executor);
 	bool matches(JPJavaFrame& frame, JPPyObjectVector& args, bool instance);
 
 	string matchReport(JPPyObjectVector& sequence);
@@ -74,6 +82,37 @@ public:
 		return m_Overloads;
 	}
 
+	/** Entry point which names this method in perf maps.
+	 */
+	void* getTrampoline() const
+	{
+		return m_Trampoline;
+	}
+
+	void setTrampoline(void* trampoline)
+	{
+		m_Trampoline = trampoline;
+	}
+
+	/** Code object reported to sys.monitoring for this method.
+	 */
+	JPPyObject& getCode()
+	{
+		return m_Code;
+	}
+
+	/** True if primitive arrays are returned as NumPy arrays on every call.
+	 */
+	bool isNumPyReturn() const
+	{
+		return m_NumPyReturn;
+	}
+
+	void setNumPyReturn(bool numpy)
+	{
+		m_NumPyReturn = numpy;
+	}
+
 private:
 	/** Search for a matching overload.
 	 *
@@ -82,11 +121,19 @@ private:
 	 */
 	bool findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch, JPPyObjectVector& vargs, bool searchInstance, bool raise);
 
+	/** Get the profiler record if profiling is enabled.
+	 */
+	JPMethodProfile* getProfile();
+
 	JPClass*      m_Class;
 	string        m_Name;
 	JPMethodList  m_Overloads;
 	jlong         m_Modifiers;
 	JPMethodCache m_LastCache{};
+	std::atomic<JPMethodProfile*> m_Profile{nullptr};
+	void*         m_Trampoline = nullptr;
+	JPPyObject    m_Code;
+	bool          m_NumPyReturn = false;
 } ;
 
 #endif // _JPMETHODDISPATCH_H_
\ No newline at end of file
@@ -16,14 +16,34 @@
 #ifndef _JPMONITOR_H_
 #define _JPMONITOR_H_
 
+/**
+ * Enter and exit the monitor of a Java object from Python.
+ *
+ * The object is borrowed, so the owner must keep it alive while the monitor
+ * exists, and for as long as the monitor is held.
+ */
 class JPMonitor
 {
 public:
 	JPMonitor(JPContext* context, jobject obj);
 	virtual ~JPMonitor();
 
-	void enter();
-	void exit();
+	/**
+	 * Enter the monitor.
+	 *
+	 * JNI has no way to try a monitor without blocking, so the GIL is
+	 * released unless this thread already holds the monitor.
+	 */
+	void enter(JPJavaFrame& frame);
+	void exit(JPJavaFrame& frame);
+
+	/**
+	 * Check if the monitor has been entered and not exited.
+	 */
+	bool isEntered() const
+	{
+		return m_Entered > 0;
+	}
 
 	JPContext* getContext()
 	{
@@ -31,8 +51,11 @@ public:
 	}
 
 private:
+	bool isHeld(JPJavaFrame& frame);
+
 	JPContext* m_Context;
-	JPObjectRef m_Value;
+	jobject m_Value;
+	std::atomic<int> m_Entered{0};
 } ;
 
 #endif // _JPMONITOR_H_
\ No newline at end of file
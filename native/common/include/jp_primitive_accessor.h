@@ -16,6 +16,9 @@
 #ifndef JP_PRIMITIVE_ACCESSOR_H
 #define JP_PRIMITIVE_ACCESSOR_H
 #include <Python.h>
+#include <algorithm>
+#include <exception>
+#include <thread>
 #include "jp_exception.h"
 #include "jp_javaframe.h"
 #include "jp_match.h"
@@ -85,6 +88,180 @@ public:
 
 } ;
 
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jboolean* vals)
+{
+	frame.SetBooleanArrayRegion((jbooleanArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jbyte* vals)
+{
+	frame.SetByteArrayRegion((jbyteArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jchar* vals)
+{
+	frame.SetCharArrayRegion((jcharArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jshort* vals)
+{
+	frame.SetShortArrayRegion((jshortArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jint* vals)
+{
+	frame.SetIntArrayRegion((jintArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jlong* vals)
+{
+	frame.SetLongArrayRegion((jlongArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jfloat* vals)
+{
+	frame.SetFloatArrayRegion((jfloatArray) a, start, len, vals);
+}
+
+inline void setArrayRegion(JPJavaFrame &frame, jarray a, jsize start, jsize len, jdouble* vals)
+{
+	frame.SetDoubleArrayRegion((jdoubleArray) a, start, len, vals);
+}
+
+/**
+ * Minimum number of elements each worker must have before a
+ * multidimensional array conversion is split across threads.
+ */
+static const Py_ssize_t JP_CONVERT_GRAIN = 1 << 18;
+
+/**
+ * Fill rows [first, last) of a multidimensional array.
+ *
+ * Each row is converted into scratch memory and copied to a new Java
+ * array with a region call.  This does not touch Python so it may be
+ * called from a worker thread with the GIL released.
+ */
+template <class type_t> void convertMultiArrayRows(
+		JPJavaFrame &frame,
+		JPPrimitiveType* cls,
+		void (*pack)(type_t*, jvalue),
+		jconverter converter,
+		JPPyBuffer &buffer,
+		jsize base, jobjectArray contents,
+		jsize first, jsize last)
+{
+	Py_buffer& view = buffer.getView();
+	int u = view.ndim - 1;
+	Py_ssize_t step;
+	if (view.strides == nullptr)
+		step = view.itemsize;
+	else
+		step = view.strides[u];
+
+	std::vector<Py_ssize_t> indices(view.ndim);
+	std::vector<type_t> row(base);
+	for (jsize k = first; k < last; ++k)
+	{
+		// Unravel the row number into the leading indices
+		Py_ssize_t r = k;
+		for (int j = u - 1; j >= 0; --j)
+		{
+			indices[j] = r % view.shape[j];
+			r /= view.shape[j];
+		}
+		char *src = buffer.getBufferPtr(indices);
+		type_t *dest = row.data();
+		for (jsize i = 0; i < base; ++i)
+		{
+			pack(dest++, converter(src));
+			src += step;
+		}
+		jarray a0 = cls->newArrayOf(frame, base);
+		setArrayRegion(frame, a0, 0, base, row.data());
+		frame.SetObjectArrayElement(contents, k, a0);
+		frame.DeleteLocalRef(a0);
+	}
+}
+
+/**
+ * Fill a multidimensional array using a pool of worker threads.
+ *
+ * The rows are divided into contiguous blocks with the calling thread
+ * taking the first.  The GIL is released while the workers run as the
+ * buffer export holds the memory.  Any error is rethrown after all of the
+ * workers have joined.
+ */
+template <class type_t> void convertMultiArrayParallel(
+		JPJavaFrame &frame,
+		JPPrimitiveType* cls,
+		void (*pack)(type_t*, jvalue),
+		jconverter converter,
+		JPPyBuffer &buffer,
+		jsize base, jobjectArray contents,
+		jsize subs, unsigned workers)
+{
+	JPContext *context = frame.getContext();
+	// Local references can not be shared between threads
+	auto shared = (jobjectArray) frame.NewGlobalRef(contents);
+	std::vector<std::exception_ptr> errors(workers);
+	{
+		JPPyCallRelease release;
+		std::vector<std::thread> threads;
+		for (unsigned w = 1; w < workers; ++w)
+		{
+			threads.emplace_back([&, w]()
+			{
+				jsize first = (jsize) ((Py_ssize_t) subs * w / workers);
+				jsize last = (jsize) ((Py_ssize_t) subs * (w + 1) / workers);
+				try
+				{
+					context->attachCurrentThreadAsDaemon();
+					JPJavaFrame wframe = JPJavaFrame::outer(context);
+					convertMultiArrayRows<type_t>(wframe, cls, pack, converter,
+							buffer, base, shared, first, last);
+				} catch (...)
+				{
+					errors[w] = std::current_exception();
+				}
+				context->detachCurrentThread();
+			});
+		}
+		try
+		{
+			JPJavaFrame wframe = JPJavaFrame::inner(context);
+			convertMultiArrayRows<type_t>(wframe, cls, pack, converter,
+					buffer, base, shared, 0, (jsize) (subs / workers));
+		} catch (...)
+		{
+			errors[0] = std::current_exception();
+		}
+		for (std::thread &thread : threads)
+			thread.join();
+	}
+	frame.DeleteGlobalRef(shared);
+	for (std::exception_ptr &error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+/**
+ * Assemble the filled rows into a multidimensional array and convert it
+ * to Python.
+ */
+inline PyObject *assembleMultiArray(JPJavaFrame &frame, jobject dims, jobjectArray contents)
+{
+	JPContext *context = frame.getContext();
+	jobject out = frame.assemble(dims, contents);
+	JPClass *type = context->_java_lang_Object;
+	if (out != nullptr)
+		type = frame.findClassForObject(out);
+	jvalue v;
+	v.l = out;
+	return type->convertToPythonObject(frame, v, false).keep();
+}
+
 template <class type_t> PyObject *convertMultiArray(
 		JPJavaFrame &frame,
 		JPPrimitiveType* cls,
@@ -104,6 +281,18 @@ template <class type_t> PyObject *convertMultiArray(
 
 	// Reserve space for array.
 	auto contents = (jobjectArray) context->_java_lang_Object->newArrayOf(frame, subs);
+
+	// Large arrays are split by row across worker threads
+	Py_ssize_t total = (Py_ssize_t) subs * base;
+	unsigned workers = std::thread::hardware_concurrency();
+	workers = (unsigned) std::min<Py_ssize_t>(std::min<Py_ssize_t>(workers, subs), total / JP_CONVERT_GRAIN);
+	if (workers > 1)
+	{
+		convertMultiArrayParallel<type_t>(frame, cls, pack, converter,
+				buffer, base, contents, subs, workers);
+		return assembleMultiArray(frame, dims, contents);
+	}
+
 	std::vector<Py_ssize_t> indices(view.ndim);
 	int u = view.ndim - 1;
 	int k = 0;
@@ -159,18 +348,10 @@ template <class type_t> PyObject *convertMultiArray(
 		indices[u]++;
 	}
 
-	// Assemble it into a multidimensional array
-	jobject out = frame.assemble(dims, contents);
-
-	// Convert it to Python
-	JPClass *type = context->_java_lang_Object;
-	if (out != nullptr)
-		type = frame.findClassForObject(out);
-	jvalue v;
-	v.l = out;
-	return type->convertToPythonObject(frame, v, false).keep();
+	return assembleMultiArray(frame, dims, contents);
 }
 
+
 template <typename base_t>
 class JPConversionLong : public JPIndexConversion
 {
@@ -0,0 +1,474 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef JP_PRIMITIVETRAITS_H
+#define JP_PRIMITIVETRAITS_H
+#include <cstdint>
+#include <cstring>
+#include "jp_array.h"
+#include "jp_primitive_accessor.h"
+
+/**
+ * The JNI entry points and buffer details of each primitive type.
+ *
+ * The calls still go through JPJavaFrame so that exceptions are checked,
+ * but the choice of call is made at compile time.
+ */
+template <class T> struct JPPrimitiveTraits;
+
+#define JP_PRIMITIVE_TRAITS(TYPE, NAME, MEMBER, CODE, FORMAT, DTYPE, SCALAR, BUFFER) \
+template <> struct JPPrimitiveTraits<j##TYPE> \
+{ \
+	using array_t = j##TYPE##Array; \
+	static const JPScalar scalar = SCALAR; \
+	static const bool buffer = BUFFER; \
+	static const char* code() { return CODE; } \
+	static const char* format() { return FORMAT; } \
+	static const char* dtype() { return DTYPE; } \
+	static j##TYPE& field(jvalue& v) { return v.MEMBER; } \
+	static const j##TYPE& field(const jvalue& v) { return v.MEMBER; } \
+	static j##TYPE getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid) \
+	{ return frame.GetStatic##NAME##Field(c, fid); } \
+	static j##TYPE getField(JPJavaFrame& frame, jobject c, jfieldID fid) \
+	{ return frame.Get##NAME##Field(c, fid); } \
+	static void setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, j##TYPE v) \
+	{ frame.SetStatic##NAME##Field(c, fid, v); } \
+	static void setField(JPJavaFrame& frame, jobject c, jfieldID fid, j##TYPE v) \
+	{ frame.Set##NAME##Field(c, fid, v); } \
+	static j##TYPE callStatic(JPJavaFrame& frame, jclass c, jmethodID mth, jvalue* val) \
+	{ return frame.CallStatic##NAME##MethodA(c, mth, val); } \
+	static j##TYPE call(JPJavaFrame& frame, jobject obj, jmethodID mth, jvalue* val) \
+	{ return frame.Call##NAME##MethodA(obj, mth, val); } \
+	static j##TYPE callNonvirtual(JPJavaFrame& frame, jobject obj, jclass c, jmethodID mth, jvalue* val) \
+	{ return frame.CallNonvirtual##NAME##MethodA(obj, c, mth, val); } \
+	static array_t newArray(JPJavaFrame& frame, jsize size) \
+	{ return frame.New##NAME##Array(size); } \
+	static void getRegion(JPJavaFrame& frame, jarray a, jsize start, jsize len, j##TYPE* vals) \
+	{ frame.Get##NAME##ArrayRegion((array_t) a, start, len, vals); } \
+	static void setRegion(JPJavaFrame& frame, jarray a, jsize start, jsize len, j##TYPE* vals) \
+	{ frame.Set##NAME##ArrayRegion((array_t) a, start, len, vals); } \
+	static j##TYPE* getElements(JPJavaFrame& frame, jarray a, jboolean* isCopy) \
+	{ return frame.Get##NAME##ArrayElements((array_t) a, isCopy); } \
+	static void releaseElements(JPJavaFrame& frame, jarray a, j##TYPE* vals, jint mode) \
+	{ frame.Release##NAME##ArrayElements((array_t) a, vals, mode); } \
+};
+
+// Booleans are never copied as raw bytes as Java requires 0 or 1.  Chars
+// are assigned item by item so that the range is checked.
+JP_PRIMITIVE_TRAITS(boolean, Boolean, z, "z", "?", "bool", JPSCALAR_OTHER, true)
+JP_PRIMITIVE_TRAITS(byte, Byte, b, "b", "b", "int8", JPSCALAR_INT8, true)
+JP_PRIMITIVE_TRAITS(char, Char, c, "c", "H", "uint16", JPSCALAR_UINT16, false)
+JP_PRIMITIVE_TRAITS(short, Short, s, "s", "h", "int16", JPSCALAR_INT16, true)
+JP_PRIMITIVE_TRAITS(int, Int, i, "i", "=i", "int32", JPSCALAR_INT32, true)
+JP_PRIMITIVE_TRAITS(long, Long, j, "j", "=q", "int64", JPSCALAR_INT64, true)
+JP_PRIMITIVE_TRAITS(float, Float, f, "f", "f", "float32", JPSCALAR_FLOAT32, true)
+JP_PRIMITIVE_TRAITS(double, Double, d, "d", "d", "float64", JPSCALAR_FLOAT64, true)
+
+#undef JP_PRIMITIVE_TRAITS
+
+template <class T> struct JPPrimitiveCast
+{
+	template <class S> static T cast(S s)
+	{
+		return (T) s;
+	}
+} ;
+
+template <> struct JPPrimitiveCast<jboolean>
+{
+	template <class S> static jboolean cast(S s)
+	{
+		return s != 0;
+	}
+} ;
+
+/**
+ * Copy a strided buffer into a strided range, converting each item.
+ *
+ * This is the bulk transfer of getConverter with the conversion inlined
+ * so that the contiguous case can be vectorized.
+ */
+template <class S, class T> void copyScalars(const char* src, Py_ssize_t sstep,
+		T* dest, Py_ssize_t dstep, Py_ssize_t length)
+{
+	for (Py_ssize_t i = 0; i < length; ++i, src += sstep, dest += dstep)
+	{
+		S s;
+		memcpy(&s, src, sizeof (S));
+		*dest = JPPrimitiveCast<T>::cast(s);
+	}
+}
+
+template <class T> bool copyScalars(JPScalar scalar, const char* src, Py_ssize_t sstep,
+		T* dest, Py_ssize_t dstep, Py_ssize_t length)
+{
+	switch (scalar)
+	{
+		case JPSCALAR_INT8: copyScalars<int8_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_UINT8: copyScalars<uint8_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_INT16: copyScalars<int16_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_UINT16: copyScalars<uint16_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_INT32: copyScalars<int32_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_UINT32: copyScalars<uint32_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_INT64: copyScalars<int64_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_UINT64: copyScalars<uint64_t>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_FLOAT32: copyScalars<float>(src, sstep, dest, dstep, length); return true;
+		case JPSCALAR_FLOAT64: copyScalars<double>(src, sstep, dest, dstep, length); return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Shared implementation of the primitive types.
+ *
+ * Everything which differs only in the JNI call or the jvalue member is
+ * written once here.  Each type supplies its conversions, along with
+ * convertItem for bulk assignment from a sequence.  Calls back to the type
+ * are qualified so they are resolved at compile time.
+ */
+template <class Derived, class T>
+class JPPrimitiveTypeImpl : public JPPrimitiveType
+{
+protected:
+	using traits_t = JPPrimitiveTraits<T>;
+
+	explicit JPPrimitiveTypeImpl(const string& name)
+	: JPPrimitiveType(name)
+	{
+	}
+
+public:
+	using type_t = T;
+	using array_t = typename traits_t::array_t;
+
+	static inline type_t& field(jvalue& v)
+	{
+		return traits_t::field(v);
+	}
+
+	static inline const type_t& field(const jvalue& v)
+	{
+		return traits_t::field(v);
+	}
+
+	JPPyObject invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth, jvalue* val) override
+	{
+		jvalue v;
+		{
+			JPPyCallRelease call;
+			field(v) = traits_t::callStatic(frame, claz, mth, val);
+		}
+		return toPython(frame, v);
+	}
+
+	JPPyObject invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmethodID mth, jvalue* val) override
+	{
+		jvalue v;
+		{
+			JPPyCallRelease call;
+			if (clazz == nullptr)
+				field(v) = traits_t::call(frame, obj, mth, val);
+			else
+				field(v) = traits_t::callNonvirtual(frame, obj, clazz, mth, val);
+		}
+		return toPython(frame, v);
+	}
+
+	JPPyObject getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid) override
+	{
+		jvalue v;
+		field(v) = traits_t::getStaticField(frame, c, fid);
+		return toPython(frame, v);
+	}
+
+	void setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* obj) override
+	{
+		traits_t::setStaticField(frame, c, fid, toJava(frame, obj));
+	}
+
+	JPPyObject getField(JPJavaFrame& frame, jobject c, jfieldID fid) override
+	{
+		jvalue v;
+		field(v) = traits_t::getField(frame, c, fid);
+		return toPython(frame, v);
+	}
+
+	void setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* obj) override
+	{
+		traits_t::setField(frame, c, fid, toJava(frame, obj));
+	}
+
+	jarray newArrayOf(JPJavaFrame& frame, jsize size) override
+	{
+		return traits_t::newArray(frame, size);
+	}
+
+	JPPyObject getArrayItem(JPJavaFrame& frame, jarray a, jsize ndx) override
+	{
+		jvalue v;
+		traits_t::getRegion(frame, a, ndx, 1, &field(v));
+		return toPython(frame, v);
+	}
+
+	void setArrayItem(JPJavaFrame& frame, jarray a, jsize ndx, PyObject* obj) override
+	{
+		type_t val = toJava(frame, obj);
+		traits_t::setRegion(frame, a, ndx, 1, &val);
+	}
+
+	JPPyObject getArrayRange(JPJavaFrame& frame, jarray a,
+			jsize start, jsize length, jsize step) override
+	{
+		JP_TRACE_IN("JPPrimitiveType::getArrayRange");
+		JPPyObject out = JPPyObject::call(PyList_New(length));
+		if (length == 0)
+			return out;
+		jvalue v;
+		// Copy the whole span in one region call unless the step is so large
+		// that most of the copy would be discarded.
+		jsize stride = (step < 0) ? -step : step;
+		if (stride > 16)
+		{
+			jsize index = start;
+			for (jsize i = 0; i < length; ++i, index += step)
+			{
+				traits_t::getRegion(frame, a, index, 1, &field(v));
+				PyList_SET_ITEM(out.get(), i, toPython(frame, v).keep());
+			}
+			return out;
+		}
+		jsize first = (step > 0) ? start : start + (length - 1) * step;
+		jsize span = (length - 1) * stride + 1;
+		vector<type_t> memory(span);
+		traits_t::getRegion(frame, a, first, span, memory.data());
+		type_t *p = memory.data() + (start - first);
+		for (jsize i = 0; i < length; ++i, p += step)
+		{
+			field(v) = *p;
+			PyList_SET_ITEM(out.get(), i, toPython(frame, v).keep());
+		}
+		return out;
+		JP_TRACE_OUT;
+	}
+
+	void setArrayRange(JPJavaFrame& frame, jarray a,
+			jsize start, jsize length, jsize step,
+			PyObject* sequence) override
+	{
+		JP_TRACE_IN("JPPrimitiveType::setArrayRange");
+		// Getting the elements may copy the whole array in and out, so the
+		// range is converted in scratch memory and written with region calls.
+		jsize stride = (step < 0) ? -step : step;
+		if (stride > 16)
+		{
+			vector<type_t> values;
+			convertRange(frame, nullptr, start, sequence, values, 0, 1, length);
+			jsize index = start;
+			for (jsize i = 0; i < length; ++i, index += step)
+				traits_t::setRegion(frame, a, index, 1, &values[i]);
+			return;
+		}
+		jsize first = (step > 0 || length == 0) ? start : start + (length - 1) * step;
+		jsize span = (length == 0) ? 0 : (length - 1) * stride + 1;
+		vector<type_t> memory;
+		// Keep the elements between those assigned
+		if (stride > 1 && span > 0)
+		{
+			memory.resize(span);
+			traits_t::getRegion(frame, a, first, span, memory.data());
+		}
+		if (convertRange(frame, a, start, sequence, memory, start - first, step, length))
+			traits_t::setRegion(frame, a, first, span, memory.data());
+		JP_TRACE_OUT;
+	}
+
+	void getView(JPArrayView& view) override
+	{
+		JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
+		view.m_IsCopy = false;
+		view.m_Memory = (void*) traits_t::getElements(frame,
+				(jarray) view.m_Array->getJava(), &view.m_IsCopy);
+		view.m_Buffer.format = (char*) traits_t::format();
+		view.m_Buffer.itemsize = sizeof (type_t);
+	}
+
+	void releaseView(JPArrayView& view) override
+	{
+		try
+		{
+			JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
+			traits_t::releaseElements(frame, (jarray) view.m_Array->getJava(),
+					(type_t*) view.m_Memory, view.m_Buffer.readonly ? JNI_ABORT : 0);
+		}		catch (JPypeException&)
+		{
+			// This is called as part of the cleanup routine and exceptions
+			// are not permitted
+		}
+	}
+
+	const char* getBufferFormat() override
+	{
+		return traits_t::format();
+	}
+
+	Py_ssize_t getItemSize() override
+	{
+		return sizeof (type_t);
+	}
+
+	void copyElements(JPJavaFrame &frame, jarray a, jsize start, jsize len,
+			void* memory, int offset) override
+	{
+		auto* b = (type_t*) ((char*) memory + offset);
+		traits_t::getRegion(frame, a, start, len, b);
+	}
+
+	PyObject *newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer,
+			int subs, int base, jobject dims) override
+	{
+		JP_TRACE_IN("JPPrimitiveType::newMultiArray");
+		return convertMultiArray<type_t>(
+				frame, this, &pack, traits_t::code(),
+				buffer, subs, base, dims);
+		JP_TRACE_OUT;
+	}
+
+	JPPyObject newNumPy(JPJavaFrame &frame, jarray a) override
+	{
+		JP_TRACE_IN("JPPrimitiveType::newNumPy");
+		jsize length = frame.GetArrayLength(a);
+		JPPyObject out = newNumPyArray(length, traits_t::dtype());
+		JPPyBuffer buffer(out.get(), PyBUF_CONTIG);
+		if (!buffer.valid())
+			JP_RAISE_PYTHON();
+		traits_t::getRegion(frame, a, 0, length, (type_t*) buffer.getView().buf);
+		return out;
+		JP_TRACE_OUT;
+	}
+
+protected:
+
+	/**
+	 * Get an integer item for a bulk assignment from a sequence.
+	 */
+	jlong getIndexItem(PyObject* item)
+	{
+		if (!PyIndex_Check(item))
+		{
+			PyErr_Format(PyExc_TypeError, "Unable to implicitly convert '%s' to %s",
+					Py_TYPE(item)->tp_name, getCanonicalName().c_str());
+			JP_RAISE_PYTHON();
+		}
+		jlong v = PyLong_AsLongLong(item);
+		if (v == -1)
+			JP_PY_CHECK();
+		return v;
+	}
+
+private:
+
+	static void pack(type_t* d, jvalue v)
+	{
+		*d = field(v);
+	}
+
+	JPPyObject toPython(JPJavaFrame& frame, jvalue v)
+	{
+		return static_cast<Derived*>(this)->Derived::convertToPythonObject(frame, v, false);
+	}
+
+	type_t toJava(JPJavaFrame& frame, PyObject* obj)
+	{
+		JPMatch match(&frame, obj);
+		if (static_cast<Derived*>(this)->Derived::findJavaConversion(match) < JPMatch::_implicit)
+			JP_RAISE(PyExc_TypeError, "Unable to convert to Java " + getCanonicalName());
+		return field(match.convert());
+	}
+
+	/**
+	 * Convert a buffer or sequence for a range of an array.
+	 *
+	 * The values are placed in memory starting at offset, which is only
+	 * allocated here if the caller left it empty.  If an array is given, a
+	 * buffer holding exactly this type with no gaps is written directly to
+	 * it, in which case this returns false and memory is not touched.
+	 */
+	bool convertRange(JPJavaFrame& frame, jarray a, jsize start, PyObject* sequence,
+			vector<type_t>& memory, jsize offset, jsize step, jsize length)
+	{
+		// First check if assigning sequence supports buffer API
+		if (traits_t::buffer && PyObject_CheckBuffer(sequence))
+		{
+			JPPyBuffer buffer(sequence, PyBUF_FULL_RO);
+			if (buffer.valid())
+			{
+				Py_buffer& view = buffer.getView();
+				if (view.ndim != 1)
+					JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
+				Py_ssize_t vshape = view.shape[0];
+				Py_ssize_t vstep = view.strides[0];
+				if (vshape != length)
+					JP_RAISE(PyExc_ValueError, "mismatched size");
+
+				char* src = (char*) view.buf;
+				if (view.suboffsets && view.suboffsets[0] >= 0)
+					src = *((char**) src) + view.suboffsets[0];
+				JPScalar scalar = getScalar(view.format, (int) view.itemsize);
+				// Formats that are not native scalars are never written raw
+				if (a != nullptr && scalar != JPSCALAR_OTHER
+						&& scalar == traits_t::scalar && step == 1
+						&& vstep == (Py_ssize_t) sizeof (type_t)
+						&& ((uintptr_t) src) % alignof (type_t) == 0)
+				{
+					traits_t::setRegion(frame, a, start, length, (type_t*) src);
+					return false;
+				}
+				type_t* dest = reserveRange(memory, offset, step, length);
+				if (copyScalars<type_t>(scalar, src, vstep, dest, step, length))
+					return true;
+				jconverter conv = getConverter(view.format, (int) view.itemsize, traits_t::code());
+				for (Py_ssize_t i = 0; i < length; ++i, dest += step)
+				{
+					*dest = field(conv(src));
+					src += vstep;
+				}
+				return true;
+			} else
+			{
+				PyErr_Clear();
+			}
+		}
+
+		// Use sequence API
+		JPPySequence seq = JPPySequence::use(sequence);
+		auto* self = static_cast<Derived*>(this);
+		type_t* dest = reserveRange(memory, offset, step, length);
+		for (Py_ssize_t i = 0; i < length; ++i, dest += step)
+			*dest = self->Derived::convertItem(seq[i].get());
+		return true;
+	}
+
+	/** Size the scratch memory for a range unless the caller already has. */
+	static type_t* reserveRange(vector<type_t>& memory, jsize offset, jsize step, jsize length)
+	{
+		jsize last = offset + (length - 1) * step;
+		if (memory.empty() && length > 0)
+			memory.resize(((last > offset) ? last : offset) + 1);
+		return memory.data() + offset;
+	}
+} ;
+
+#endif /* JP_PRIMITIVETRAITS_H */
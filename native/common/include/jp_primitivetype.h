@@ -49,8 +49,22 @@ public:
 	virtual PyObject *newMultiArray(JPJavaFrame &frame,
 			JPPyBuffer& view, int subs, int base, jobject dims) = 0;
 
+	/**
+	 * Copy an array of this type into a new NumPy array.
+	 *
+	 * The elements are copied with one region call into memory owned by
+	 * the NumPy array, so nothing is left pinned.
+	 */
+	virtual JPPyObject newNumPy(JPJavaFrame &frame, jarray a) = 0;
+
 	// Helper for Long types
 	PyObject *convertLong(PyTypeObject* wrapper, PyLongObject* tmp);
+
+protected:
+	/**
+	 * Create an uninitialized one dimensional NumPy array.
+	 */
+	static JPPyObject newNumPyArray(jsize length, const char* dtype);
 } ;
 
 #endif
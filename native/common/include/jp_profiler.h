@@ -0,0 +1,130 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#ifndef JP_PROFILER_H
+#define JP_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Totals for one Java method.
+ *
+ * Every call is counted, but only one call in each sampling interval is
+ * timed.  Times are the sums over the timed calls in nanoseconds.
+ */
+struct JPMethodProfile
+{
+	JPMethodProfile(const std::string& cls, const std::string& name)
+	: m_Class(cls), m_Name(name)
+	{
+	}
+
+	std::string m_Class;
+	std::string m_Name;
+	std::atomic<uint64_t> m_Calls{0};
+	std::atomic<uint64_t> m_CacheHits{0};
+	std::atomic<uint64_t> m_Sampled{0};
+	std::atomic<uint64_t> m_MatchTime{0};
+	std::atomic<uint64_t> m_ConvertTime{0};
+	std::atomic<uint64_t> m_JavaTime{0};
+	std::atomic<uint64_t> m_ReturnTime{0};
+} ;
+
+/**
+ * Opt-in profiler for calls to Java methods.
+ *
+ * Records are created the first time a method is called while profiling
+ * and are kept until the process exits, so a dispatch can hold a pointer
+ * to its record.  A reset only clears the totals.
+ */
+class JPProfiler
+{
+public:
+
+	static bool isEnabled()
+	{
+		return s_Enabled.load(std::memory_order_relaxed);
+	}
+
+	static uint64_t getInterval()
+	{
+		return s_Interval.load(std::memory_order_relaxed);
+	}
+
+	static void setEnabled(bool enabled, uint64_t interval);
+
+	/**
+	 * Get the record for a method, creating it if required.
+	 */
+	static JPMethodProfile* getProfile(const std::string& cls, const std::string& name);
+
+	/**
+	 * Get the records of methods called since the last reset.
+	 */
+	static std::vector<JPMethodProfile*> getProfiles();
+
+	/**
+	 * Clear the totals of a record.
+	 */
+	static void reset(JPMethodProfile& profile);
+
+private:
+	static std::atomic<bool> s_Enabled;
+	static std::atomic<uint64_t> s_Interval;
+} ;
+
+/**
+ * Measure one call to a Java method.
+ *
+ * The call is split into the overload match, the argument conversion, the
+ * time with the GIL released, and the return conversion.  The time released
+ * is reported by JPPyCallRelease through the sample for the current thread.
+ * Samples nest when Java calls back into Python.
+ */
+class JPProfileSample
+{
+public:
+
+	explicit JPProfileSample(JPMethodProfile* profile);
+	~JPProfileSample();
+
+	JPProfileSample(const JPProfileSample&) = delete;
+	JPProfileSample& operator=(const JPProfileSample&) = delete;
+
+	/**
+	 * Mark the end of the overload match.
+	 */
+	void matched(bool cached);
+
+	static void released();
+	static void acquired();
+
+private:
+	JPMethodProfile* m_Profile;
+	JPProfileSample* m_Previous;
+	bool m_Timed;
+	int m_Depth;
+	int64_t m_Start;
+	int64_t m_Matched;
+	int64_t m_Released;
+	// Time of the last release or acquire of the GIL
+	int64_t m_Mark;
+	int64_t m_Java;
+} ;
+
+#endif /* JP_PROFILER_H */
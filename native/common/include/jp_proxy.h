@@ -42,12 +42,37 @@ public:
 	virtual JPPyObject getCallable(const string& cname) = 0;
 	static void releaseProxyPython(void* host);
 
+	/**
+	 * Call the Python implementation of a method.
+	 *
+	 * The GIL must be held.
+	 *
+	 * @return the boxed result, or missing if the method is not implemented.
+	 */
+	jobject invoke(JPJavaFrame& frame, jstring name, JPClass* returnClass,
+			jlongArray parameterTypePtrs, jobjectArray args, jobject missing);
+
+	/**
+	 * Queued proxies hand calls from Java threads to a Python thread rather
+	 * than taking the GIL in the calling thread.
+	 */
+	bool isQueued() const
+	{
+		return m_Queued;
+	}
+
+	void setQueued(bool queued)
+	{
+		m_Queued = queued;
+	}
+
 protected:
 	JPContext*    m_Context;
 	PyJPProxy*    m_Instance;
 	JPObjectRef   m_Proxy;
 	JPClassList   m_InterfaceClasses;
 	jweak         m_Ref;
+	bool          m_Queued{};
 } ;
 
 class JPProxyDirect : public JPProxy
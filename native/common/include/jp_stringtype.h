@@ -33,6 +33,47 @@ public:
 	JPMatch::Type findJavaConversion(JPMatch& match) override;
 	void getConversionInfo(JPConversionInfo &info) override;
 	JPValue newInstance(JPJavaFrame& frame, JPPyObjectVector& args) override;
+
+	/**
+	 * Configure the cache used when strings are converted.
+	 *
+	 * The cache is direct mapped on the contents of the string.  Strings
+	 * returned from it are interned so that repeated values are the same
+	 * Python object.
+	 *
+	 * @param size is the number of entries, or 0 to disable.
+	 * @param maxLength is the longest string in UTF-16 code units to cache.
+	 */
+	void setCache(size_t size, jsize maxLength);
+	size_t getCacheSize() const
+	{
+		return m_Cache.size();
+	}
+	jsize getCacheMaxLength() const
+	{
+		return m_CacheMaxLength;
+	}
+	long long getCacheHits() const
+	{
+		return m_CacheHits;
+	}
+	long long getCacheMisses() const
+	{
+		return m_CacheMisses;
+	}
+
+private:
+	JPPyObject convertCached(JPJavaFrame& frame, jstring jstr);
+
+	struct CacheEntry
+	{
+		size_t hash;
+		PyObject *str;
+	} ;
+	std::vector<CacheEntry> m_Cache;
+	jsize m_CacheMaxLength{64};
+	long long m_CacheHits{0};
+	long long m_CacheMisses{0};
 } ;
 
 #endif /* JP_STRINGTYPE_H */
\ No newline at end of file
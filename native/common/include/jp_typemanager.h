@@ -39,6 +39,16 @@ public:
 	JPClass* findClass(jclass cls);
 	JPClass* findClassByName(const string& str);
 	JPClass* findClassForObject(jobject obj);
+
+	/**
+	 * Find the classes for a range of an object array in one call.
+	 *
+	 * Null elements give a null class.
+	 *
+	 * @return a copy of the elements that were inspected.
+	 */
+	jobjectArray findClassesForArray(JPJavaFrame& frame, jobjectArray array,
+			jsize start, jsize length, jsize step, std::vector<JPClass*>& out);
 	void populateMethod(void* method, jobject obj);
 	void populateMembers(JPClass* cls);
     int interfaceParameterCount(JPClass* cls);
@@ -49,6 +59,7 @@ private:
 	jmethodID m_FindClass;
 	jmethodID m_FindClassByName;
 	jmethodID m_FindClassForObject;
+	jmethodID m_FindClassesForArray;
 	jmethodID m_PopulateMethod;
 	jmethodID m_PopulateMembers;
     jmethodID m_InterfaceParameterCount;
@@ -60,6 +60,7 @@ public:
 			void* memory, int offset) override;
 	PyObject *newMultiArray(JPJavaFrame &frame,
 			JPPyBuffer& view, int subs, int base, jobject dims) override;
+	JPPyObject newNumPy(JPJavaFrame &frame, jarray a) override;
 } ;
 
 #endif // _JP_VOID_TYPE_H_
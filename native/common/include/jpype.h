@@ -122,6 +122,35 @@ using jconverter = jvalue (*)(void *) ;
  */
 extern jconverter getConverter(const char* from, int itemsize, const char* to);
 
+/**
+ * Scalar types which bulk transfers copy with a loop specialized for the
+ * pair of types rather than calling a converter for each item.
+ */
+enum JPScalar
+{
+	JPSCALAR_OTHER,
+	JPSCALAR_INT8,
+	JPSCALAR_UINT8,
+	JPSCALAR_INT16,
+	JPSCALAR_UINT16,
+	JPSCALAR_INT32,
+	JPSCALAR_UINT32,
+	JPSCALAR_INT64,
+	JPSCALAR_UINT64,
+	JPSCALAR_FLOAT32,
+	JPSCALAR_FLOAT64
+} ;
+
+/**
+ * Get the scalar type of a buffer item.
+ *
+ * @param from is a Python struct designation
+ * @param itemsize is the size of the Python item
+ * @return JPSCALAR_OTHER if the item is not a native scalar, in which case
+ * a converter is required.
+ */
+extern JPScalar getScalar(const char* from, int itemsize);
+
 extern bool _jp_cpp_exceptions;
 
 // Types
@@ -187,6 +216,8 @@ static inline JPPyObject JPPyTuple_Pack(T... args) {
 #include "jp_context.h"
 #include "jp_exception.h"
 #include "jp_tracer.h"
+#include "jp_counters.h"
+#include "jp_profiler.h"
 #include "jp_typemanager.h"
 #include "jp_encoding.h"
 #include "jp_modifier.h"
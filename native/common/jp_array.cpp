@@ -129,6 +129,15 @@ JPPyObject JPArray::getItem(jsize ndx)
 	return compType->getArrayItem(frame, m_Object.get(), m_Start + ndx * m_Step);
 }
 
+JPPyObject JPArray::getRange(jsize start, jsize length)
+{
+	JPJavaFrame frame = JPJavaFrame::outer(m_Class->getContext());
+	JPClass* compType = m_Class->getComponentType();
+	if (start < 0 || length < 0 || start + length > m_Length)
+		JP_RAISE(PyExc_IndexError, "array index out of bounds");
+	return compType->getArrayRange(frame, m_Object.get(), m_Start + start * m_Step, length, m_Step);
+}
+
 jarray JPArray::clone(JPJavaFrame& frame, PyObject* obj)
 {
 	JPValue value = m_Class->newArray(frame, m_Length);
@@ -64,6 +64,7 @@ void JPArrayClass::getConversionInfo(JPConversionInfo &info)
 JPPyObject JPArrayClass::convertToPythonObject(JPJavaFrame& frame, jvalue value, bool cast)
 {
 	JP_TRACE_IN("JPArrayClass::convertToPythonObject");
+	JP_COUNT(JPCOUNT_TO_PYTHON_ARRAY);
 	if (!cast)
 	{
 		if (value.l == nullptr)
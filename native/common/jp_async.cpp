@@ -0,0 +1,446 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_async.h"
+#include "jp_classloader.h"
+#include "jp_proxy.h"
+#include <algorithm>
+#include <chrono>
+
+#ifdef WIN32
+#include <winsock2.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#endif
+
+namespace
+{
+
+/**
+ * The Python side of a pending Java future.
+ */
+struct JPAsyncTask
+{
+	PyObject *future;
+	JPClass *returnType;
+} ;
+
+// Time a queued call may wait for a consumer to take it
+const std::chrono::seconds s_CallbackTimeout(60);
+
+}
+
+JPAsync::JPAsync(JPContext *context)
+{
+	m_Context = context;
+}
+
+JPAsync::~JPAsync() = default;
+
+void JPAsync::init(JPJavaFrame& frame)
+{
+	jclass cls = m_Context->getClassLoader()->findClass(frame, "org.jpype.JPypeAsync");
+	m_AsyncClass = (jclass) frame.NewGlobalRef(cls);
+	m_CallID = frame.GetStaticMethodID(m_AsyncClass, "call",
+			"(JJLjava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/util/concurrent/Executor;)Ljava/util/concurrent/CompletableFuture;");
+	m_WatchID = frame.GetStaticMethodID(m_AsyncClass, "watch",
+			"(JJLjava/util/concurrent/CompletionStage;)V");
+}
+
+void JPAsync::setWakeup(long long fd)
+{
+	m_WakeFd = fd;
+}
+
+void JPAsync::setCallbackWakeup(long long fd)
+{
+	m_CallbackFd = fd;
+}
+
+jlong JPAsync::newToken(PyObject *future, JPClass *returnType)
+{
+	auto *task = new JPAsyncTask();
+	Py_INCREF(future);
+	task->future = future;
+	task->returnType = returnType;
+	return (jlong) task;
+}
+
+void JPAsync::releaseToken(jlong token)
+{
+	auto *task = (JPAsyncTask*) token;
+	Py_DECREF(task->future);
+	delete task;
+}
+
+jobject JPAsync::call(JPJavaFrame& frame, jlong token, jobject method,
+		jobject obj, jobject args, jobject executor)
+{
+	JP_TRACE_IN("JPAsync::call");
+	jvalue v[6];
+	v[0].j = (jlong) m_Context;
+	v[1].j = token;
+	v[2].l = method;
+	v[3].l = obj;
+	v[4].l = args;
+	v[5].l = executor;
+	return frame.CallStaticObjectMethodA(m_AsyncClass, m_CallID, v);
+	JP_TRACE_OUT;
+}
+
+void JPAsync::watch(JPJavaFrame& frame, jlong token, jobject stage)
+{
+	JP_TRACE_IN("JPAsync::watch");
+	jvalue v[3];
+	v[0].j = (jlong) m_Context;
+	v[1].j = token;
+	v[2].l = stage;
+	frame.CallStaticVoidMethodA(m_AsyncClass, m_WatchID, v);
+	JP_TRACE_OUT;
+}
+
+void JPAsync::complete(JNIEnv *env, jlong token, jobject value, jobject error)
+{
+	auto *entry = new JPAsyncCompletion();
+	entry->token = token;
+	entry->value = (value != nullptr) ? env->NewGlobalRef(value) : nullptr;
+	entry->error = (error != nullptr) ? env->NewGlobalRef(error) : nullptr;
+	JPAsyncCompletion *head = m_Head.load(std::memory_order_relaxed);
+	do
+	{
+		entry->next = head;
+	} while (!m_Head.compare_exchange_weak(head, entry,
+			std::memory_order_release, std::memory_order_relaxed));
+
+	// Only the first completion of a batch needs to wake the loop
+	if (head == nullptr)
+		wake(m_WakeFd);
+}
+
+void JPAsync::wake(long long fd)
+{
+	if (fd < 0)
+		return;
+	char c = 0;
+#if defined(WIN32)
+	send((SOCKET) fd, &c, 1, 0);
+#elif defined(MSG_NOSIGNAL)
+	send((int) fd, &c, 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+#else
+	send((int) fd, &c, 1, MSG_DONTWAIT);
+#endif
+}
+
+bool JPAsync::queueCallback(JNIEnv *env, jstring name, jlong host, jlong returnType,
+		jlongArray parameterTypes, jobjectArray args, jobject missing, jobject &out)
+{
+	// The consumers are checked and the request pushed under the lock so
+	// that a consumer stopping can not miss the request.
+	std::unique_lock<std::mutex> queue(m_CallbackLock);
+	if (m_Consumers == 0 || m_Stopped)
+		return false;
+
+	JPCallbackRequest request;
+	request.host = host;
+	request.returnType = returnType;
+	request.name = env->NewGlobalRef(name);
+	request.parameterTypes = env->NewGlobalRef(parameterTypes);
+	request.args = (args != nullptr) ? env->NewGlobalRef(args) : nullptr;
+	request.missing = env->NewGlobalRef(missing);
+	request.result = nullptr;
+	request.error = nullptr;
+	request.done = false;
+	request.cancelled = false;
+
+	JPCallbackRequest *head = m_Callbacks.load(std::memory_order_relaxed);
+	do
+	{
+		request.next = head;
+	} while (!m_Callbacks.compare_exchange_weak(head, &request,
+			std::memory_order_release, std::memory_order_relaxed));
+
+	queue.unlock();
+
+	// Only the first request of a batch needs to wake the consumer
+	if (head == nullptr)
+	{
+		m_CallbackReady.notify_all();
+		wake(m_CallbackFd);
+	}
+
+	bool timedOut = false;
+	{
+		std::unique_lock<std::mutex> guard(request.lock);
+		auto done = [&request] {
+			return request.done;
+		};
+		if (!request.ready.wait_for(guard, s_CallbackTimeout, done))
+		{
+			// The consumer lock is taken before the request lock
+			guard.unlock();
+			timedOut = withdrawCallback(&request);
+			guard.lock();
+			// Otherwise a consumer has already taken the call
+			if (!timedOut)
+				request.ready.wait(guard, done);
+		}
+	}
+
+	env->DeleteGlobalRef(request.name);
+	env->DeleteGlobalRef(request.parameterTypes);
+	if (request.args != nullptr)
+		env->DeleteGlobalRef(request.args);
+	out = nullptr;
+	if (request.result != nullptr)
+	{
+		out = env->NewLocalRef(request.result);
+		env->DeleteGlobalRef(request.result);
+	}
+	if (request.error != nullptr)
+	{
+		env->Throw((jthrowable) env->NewLocalRef(request.error));
+		env->DeleteGlobalRef(request.error);
+	}
+	// The missing marker is compared by identity
+	if (out != nullptr && env->IsSameObject(out, request.missing))
+	{
+		env->DeleteLocalRef(out);
+		out = missing;
+	}
+	env->DeleteGlobalRef(request.missing);
+	if (timedOut)
+		env->ThrowNew(m_Context->m_RuntimeException.get(), "Python callback was not taken by an executor");
+	else if (request.cancelled)
+		env->ThrowNew(m_Context->m_RuntimeException.get(), "Python callback executor stopped");
+	return true;
+}
+
+/**
+ * Remove a request that no consumer has taken.
+ *
+ * @return true if the request was removed, or false if a consumer already
+ * holds it.
+ */
+bool JPAsync::withdrawCallback(JPCallbackRequest *request)
+{
+	// Producers push under the lock, so only consumers can take the stack
+	// while it is rebuilt.
+	std::lock_guard<std::mutex> queue(m_CallbackLock);
+	JPCallbackRequest *head = m_Callbacks.exchange(nullptr, std::memory_order_acquire);
+	bool found = false;
+	JPCallbackRequest **link = &head;
+	while (*link != nullptr)
+	{
+		if (*link == request)
+		{
+			*link = request->next;
+			found = true;
+			break;
+		}
+		link = &(*link)->next;
+	}
+	if (head != nullptr)
+	{
+		m_Callbacks.store(head, std::memory_order_release);
+		// A consumer woken while the stack was out would have found nothing
+		m_CallbackReady.notify_all();
+		wake(m_CallbackFd);
+	}
+	return found;
+}
+
+int JPAsync::setConsumer(bool add)
+{
+	std::lock_guard<std::mutex> guard(m_CallbackLock);
+	if (add)
+		m_Consumers++;
+	else if (m_Consumers > 0 && --m_Consumers == 0)
+		cancelCallbacks();
+	return m_Consumers;
+}
+
+void JPAsync::stopCallbacks()
+{
+	std::lock_guard<std::mutex> guard(m_CallbackLock);
+	m_Stopped = true;
+	cancelCallbacks();
+}
+
+/**
+ * Wake every waiting caller with an error.
+ *
+ * Must be called holding m_CallbackLock.
+ */
+void JPAsync::cancelCallbacks()
+{
+	JPCallbackRequest *request = m_Callbacks.exchange(nullptr, std::memory_order_acquire);
+	while (request != nullptr)
+	{
+		// The request is freed once the caller wakes
+		JPCallbackRequest *next = request->next;
+		std::lock_guard<std::mutex> guard(request->lock);
+		request->cancelled = true;
+		request->done = true;
+		request->ready.notify_one();
+		request = next;
+	}
+}
+
+int JPAsync::runCallbacks(JPJavaFrame& frame, double timeout)
+{
+	JP_TRACE_IN("JPAsync::runCallbacks");
+	if (timeout != 0 && m_Callbacks.load(std::memory_order_acquire) == nullptr)
+	{
+		JPPyCallRelease call;
+		std::unique_lock<std::mutex> guard(m_CallbackLock);
+		auto pending = [this] {
+			return m_Callbacks.load(std::memory_order_acquire) != nullptr;
+		};
+		if (timeout < 0)
+			m_CallbackReady.wait(guard, pending);
+		else
+			m_CallbackReady.wait_for(guard, std::chrono::duration<double>(timeout), pending);
+	}
+
+	JPCallbackRequest *head = m_Callbacks.exchange(nullptr, std::memory_order_acquire);
+	vector<JPCallbackRequest*> requests;
+	for (JPCallbackRequest *request = head; request != nullptr; request = request->next)
+		requests.push_back(request);
+	std::reverse(requests.begin(), requests.end());
+
+	JNIEnv *env = frame.getEnv();
+	for (JPCallbackRequest *request : requests)
+	{
+		try
+		{
+			JPJavaFrame inner = JPJavaFrame::inner(m_Context);
+			auto *proxy = (JPProxy*) request->host;
+			jobject out = proxy->invoke(inner, (jstring) request->name,
+					(JPClass*) request->returnType, (jlongArray) request->parameterTypes,
+					(jobjectArray) request->args, request->missing);
+			if (out != nullptr)
+				request->result = inner.NewGlobalRef(out);
+		} catch (JPypeException& ex)
+		{
+			// Move the exception to the thread that made the call
+			ex.toJava(m_Context);
+			jthrowable th = env->ExceptionOccurred();
+			env->ExceptionClear();
+			if (th != nullptr)
+			{
+				request->error = env->NewGlobalRef(th);
+				env->DeleteLocalRef(th);
+			}
+		} catch (...)  // GCOVR_EXCL_LINE
+		{
+			env->ThrowNew(m_Context->m_RuntimeException.get(), "unknown error occurred");
+			jthrowable th = env->ExceptionOccurred();
+			env->ExceptionClear();
+			request->error = env->NewGlobalRef(th);
+			env->DeleteLocalRef(th);
+		}
+		// Notify while holding the lock as the request is freed once the
+		// caller wakes.
+		std::lock_guard<std::mutex> guard(request->lock);
+		request->done = true;
+		request->ready.notify_one();
+	}
+	return (int) requests.size();
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPAsync::convertResult(JPJavaFrame& frame, JPClass *returnType, jobject value)
+{
+	if (returnType == m_Context->_void)
+		return JPPyObject::getNone();
+	if (returnType->isPrimitive())
+	{
+		JPClass *boxed = (dynamic_cast<JPPrimitiveType*>( returnType))->getBoxedClass(m_Context);
+		JPValue out = returnType->getValueFromObject(JPValue(boxed, value));
+		return returnType->convertToPythonObject(frame, out.getValue(), false);
+	}
+	jvalue v;
+	v.l = value;
+	return returnType->convertToPythonObject(frame, v, false);
+}
+
+JPPyObject JPAsync::drain(JPJavaFrame& frame)
+{
+	JP_TRACE_IN("JPAsync::drain");
+	JPAsyncCompletion *head = m_Head.exchange(nullptr, std::memory_order_acquire);
+
+	// The stack is newest first
+	vector<JPAsyncCompletion*> entries;
+	for (JPAsyncCompletion *entry = head; entry != nullptr; entry = entry->next)
+		entries.push_back(entry);
+	std::reverse(entries.begin(), entries.end());
+
+	JPPyObject out = JPPyObject::call(PyList_New(0));
+	for (JPAsyncCompletion *entry : entries)
+	{
+		auto *task = (JPAsyncTask*) entry->token;
+		JPPyObject future = JPPyObject::accept(task->future);
+		JPPyObject result = JPPyObject::getNone();
+		JPPyObject exception = JPPyObject::getNone();
+		try
+		{
+			if (entry->error != nullptr)
+			{
+				jvalue v;
+				v.l = entry->error;
+				exception = m_Context->_java_lang_Object->convertToPythonObject(frame, v, false);
+			} else
+				result = convertResult(frame, task->returnType, entry->value);
+		} catch (JPypeException& ex)
+		{
+			// A failed conversion is reported on the future
+			ex.toPython();
+			PyObject *type, *value, *trace;
+			PyErr_Fetch(&type, &value, &trace);
+			PyErr_NormalizeException(&type, &value, &trace);
+			Py_XDECREF(type);
+			Py_XDECREF(trace);
+			exception = JPPyObject::accept(value);
+		}
+		if (entry->value != nullptr)
+			frame.DeleteGlobalRef(entry->value);
+		if (entry->error != nullptr)
+			frame.DeleteGlobalRef(entry->error);
+		delete entry;
+		delete task;
+		JPPyObject tuple = JPPyTuple_Pack(future.get(), result.get(), exception.get());
+		PyList_Append(out.get(), tuple.get());
+	}
+	return out;
+	JP_TRACE_OUT;
+}
+
+extern "C" JNIEXPORT void JNICALL Java_org_jpype_JPypeAsync_complete
+(JNIEnv *env, jclass clazz, jlong contextPtr, jlong token, jobject value, jthrowable error)
+{
+	// Exceptions are not allowed here
+	try
+	{
+		auto* context = (JPContext*) contextPtr;
+		if (!context->isRunning())
+			return;
+		context->m_Async->complete(env, token, value, error);
+	} catch (...) // GCOVR_EXCL_LINE
+	{
+	}
+}
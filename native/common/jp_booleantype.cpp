@@ -21,7 +21,7 @@
 #include "jp_boxedtype.h"
 
 JPBooleanType::JPBooleanType()
-: JPPrimitiveType("boolean")
+: JPPrimitiveTypeImpl("boolean")
 {
 }
 
@@ -30,6 +30,7 @@ JPBooleanType::~JPBooleanType()
 
 JPPyObject JPBooleanType::convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast)
 {
+	JP_COUNT(JPCOUNT_TO_PYTHON_PRIMITIVE);
 	return JPPyObject::call(PyBool_FromLong(val.z));
 }
 
@@ -169,191 +170,10 @@ void JPBooleanType::getConversionInfo(JPConversionInfo &info)
 	PyList_Append(info.ret, (PyObject*) & PyBool_Type);
 }
 
-jarray JPBooleanType::newArrayOf(JPJavaFrame& frame, jsize sz)
+jboolean JPBooleanType::convertItem(PyObject* item)
 {
-	return frame.NewBooleanArray(sz);
-}
-
-JPPyObject JPBooleanType::getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetStaticBooleanField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPBooleanType::getField(JPJavaFrame& frame, jobject c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetBooleanField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPBooleanType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		field(v) = frame.CallStaticBooleanMethodA(claz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPBooleanType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		if (clazz == nullptr)
-			field(v) = frame.CallBooleanMethodA(obj, mth, val);
-		else
-			field(v) = frame.CallNonvirtualBooleanMethodA(obj, clazz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPBooleanType::setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java boolean");
-	type_t val = field(match.convert());
-	frame.SetStaticBooleanField(c, fid, val);
-}
-
-void JPBooleanType::setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java boolean");
-	type_t val = field(match.convert());
-	frame.SetBooleanField(c, fid, val);
-}
-
-void JPBooleanType::setArrayRange(JPJavaFrame& frame, jarray a,
-		jsize start, jsize length, jsize step,
-		PyObject* sequence)
-{
-	JP_TRACE_IN("JPBooleanType::setArrayRange");
-	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
-			&JPJavaFrame::GetBooleanArrayElements, &JPJavaFrame::ReleaseBooleanArrayElements);
-
-	type_t* val = accessor.get();
-	// First check if assigning sequence supports buffer API
-	if (PyObject_CheckBuffer(sequence))
-	{
-		JPPyBuffer buffer(sequence, PyBUF_FULL_RO);
-		if (buffer.valid())
-		{
-			Py_buffer& view = buffer.getView();
-			if (view.ndim != 1)
-				JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
-			Py_ssize_t vshape = view.shape[0];
-			Py_ssize_t vstep = view.strides[0];
-			if (vshape != length)
-				JP_RAISE(PyExc_ValueError, "mismatched size");
-
-			char* memory = (char*) view.buf;
-			if (view.suboffsets && view.suboffsets[0] >= 0)
-				memory = *((char**) memory) + view.suboffsets[0];
-			jsize index = start;
-			jconverter conv = getConverter(view.format, (int) view.itemsize, "z");
-			for (Py_ssize_t i = 0; i < length; ++i, index += step)
-			{
-				jvalue r = conv(memory);
-				val[index] = r.z;
-				memory += vstep;
-			}
-			accessor.commit();
-			return;
-		} else
-		{
-			PyErr_Clear();
-		}
-	}
-
-	// Use sequence API
-	JPPySequence seq = JPPySequence::use(sequence);
-	jsize index = start;
-	for (Py_ssize_t i = 0; i < length; ++i, index += step)
-	{
-		int v = PyObject_IsTrue(seq[i].get());
-		if (v == -1)
-			JP_PY_CHECK();
-		val[index] = v;
-	}
-	accessor.commit();
-	JP_TRACE_OUT;
-}
-
-JPPyObject JPBooleanType::getArrayItem(JPJavaFrame& frame, jarray a, jsize ndx)
-{
-	auto array = (array_t) a;
-	type_t val;
-	frame.GetBooleanArrayRegion(array, ndx, 1, &val);
-	jvalue v;
-	field(v) = val;
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPBooleanType::setArrayItem(JPJavaFrame& frame, jarray a, jsize ndx, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java boolean");
-	type_t val = field(match.convert());
-	frame.SetBooleanArrayRegion((array_t) a, ndx, 1, &val);
-}
-
-void JPBooleanType::getView(JPArrayView& view)
-{
-	JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-	view.m_Memory = (void*) frame.GetBooleanArrayElements(
-			(jbooleanArray) view.m_Array->getJava(), &view.m_IsCopy);
-	view.m_Buffer.format = "?";
-	view.m_Buffer.itemsize = sizeof (jboolean);
-}
-
-void JPBooleanType::releaseView(JPArrayView& view)
-{
-	try
-	{
-		JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-		frame.ReleaseBooleanArrayElements((jbooleanArray) view.m_Array->getJava(),
-				(jboolean*) view.m_Memory, view.m_Buffer.readonly ? JNI_ABORT : 0);
-	}	catch (JPypeException&)
-	{
-		// This is called as part of the cleanup routine and exceptions
-		// are not permitted
-	}
-}
-
-const char* JPBooleanType::getBufferFormat()
-{
-	return "?";
-}
-
-Py_ssize_t JPBooleanType::getItemSize()
-{
-	return sizeof (jboolean);
-}
-
-void JPBooleanType::copyElements(JPJavaFrame &frame, jarray a, jsize start, jsize len,
-		void* memory, int offset)
-{
-	auto* b = (jboolean*) ((char*) memory + offset);
-	frame.GetBooleanArrayRegion((jbooleanArray) a, start, len, b);
-}
-
-static void pack(jboolean* d, jvalue v)
-{
-	*d = v.z;
-}
-
-PyObject *JPBooleanType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
-{
-	JP_TRACE_IN("JPBooleanType::newMultiArray");
-	return convertMultiArray<type_t>(
-			frame, this, &pack, "z",
-			buffer, subs, base, dims);
-	JP_TRACE_OUT;
+	int v = PyObject_IsTrue(item);
+	if (v == -1)
+		JP_PY_CHECK();
+	return v;
 }
@@ -26,6 +26,7 @@ JPBoxedType::JPBoxedType(JPJavaFrame& frame, jclass clss,
 : JPClass(frame, clss, name, super, interfaces, modifiers),
 m_PrimitiveType(primitiveType)
 {
+	m_Immutable = true;
 	if (name != "java.lang.Void")
 	{
 		string s = string("(") + primitiveType->getTypeCode() + ")V";
@@ -21,7 +21,7 @@
 #include "jp_boxedtype.h"
 
 JPCharType::JPCharType()
-: JPPrimitiveType("char")
+: JPPrimitiveTypeImpl("char")
 {
 }
 
@@ -43,6 +43,7 @@ JPValue JPCharType::newInstance(JPJavaFrame& frame, JPPyObjectVector& args)
 
 JPPyObject JPCharType::convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast)
 {
+	JP_COUNT(JPCOUNT_TO_PYTHON_PRIMITIVE);
 	//	if (!cast)
 	//	{
 	JPPyObject out = JPPyObject::call(PyJPChar_Create((PyTypeObject*) _JChar, val.c));
@@ -144,157 +145,9 @@ void JPCharType::getConversionInfo(JPConversionInfo &info)
 	PyList_Append(info.ret, (PyObject*) m_Context->_char->getHost());
 }
 
-jarray JPCharType::newArrayOf(JPJavaFrame& frame, jsize sz)
+jchar JPCharType::convertItem(PyObject* item)
 {
-	return frame.NewCharArray(sz);
-}
-
-JPPyObject JPCharType::getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetStaticCharField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPCharType::getField(JPJavaFrame& frame, jobject c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetCharField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPCharType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		field(v) = frame.CallStaticCharMethodA(claz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPCharType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		if (clazz == nullptr)
-			field(v) = frame.CallCharMethodA(obj, mth, val);
-		else
-			field(v) = frame.CallNonvirtualCharMethodA(obj, clazz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPCharType::setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java char");
-	type_t val = field(match.convert());
-	frame.SetStaticCharField(c, fid, val);
-}
-
-void JPCharType::setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java char");
-	type_t val = field(match.convert());
-	frame.SetCharField(c, fid, val);
-}
-
-void JPCharType::setArrayRange(JPJavaFrame& frame, jarray a,
-		jsize start, jsize length, jsize step,
-		PyObject* sequence)
-{
-	JP_TRACE_IN("JPCharType::setArrayRange");
-
-	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
-			&JPJavaFrame::GetCharArrayElements, &JPJavaFrame::ReleaseCharArrayElements);
-
-	type_t* val = accessor.get();
-	JPPySequence seq = JPPySequence::use(sequence);
-	jsize index = start;
-	for (Py_ssize_t i = 0; i < length; ++i, index += step)
-	{
-		jchar v = JPPyString::asCharUTF16(seq[i].get());
-		JP_PY_CHECK();
-		val[index] = (type_t) v;
-	}
-	accessor.commit();
-	JP_TRACE_OUT;
-}
-
-JPPyObject JPCharType::getArrayItem(JPJavaFrame& frame, jarray a, jsize ndx)
-{
-	auto array = (array_t) a;
-	type_t val;
-	frame.GetCharArrayRegion(array, ndx, 1, &val);
-	jvalue v;
-	field(v) = val;
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPCharType::setArrayItem(JPJavaFrame& frame, jarray a, jsize ndx, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java char");
-	type_t val = field(match.convert());
-	frame.SetCharArrayRegion((array_t) a, ndx, 1, &val);
-}
-
-void JPCharType::getView(JPArrayView& view)
-{
-	JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-	view.m_Memory = (void*) frame.GetCharArrayElements(
-			(jcharArray) view.m_Array->getJava(), &view.m_IsCopy);
-	view.m_Buffer.format = "H";
-	view.m_Buffer.itemsize = sizeof (jchar);
-}
-
-void JPCharType::releaseView(JPArrayView& view)
-{
-	try
-	{
-		JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-		frame.ReleaseCharArrayElements((jcharArray) view.m_Array->getJava(),
-				(jchar*) view.m_Memory, view.m_Buffer.readonly ? JNI_ABORT : 0);
-	}	catch (JPypeException&)
-	{
-		// This is called as part of the cleanup routine and exceptions
-		// are not permitted
-	}
-}
-
-const char* JPCharType::getBufferFormat()
-{
-	return "H";
-}
-
-Py_ssize_t JPCharType::getItemSize()
-{
-	return sizeof (jchar);
-}
-
-void JPCharType::copyElements(JPJavaFrame &frame, jarray a, jsize start, jsize len,
-		void* memory, int offset)
-{
-	auto* b = (jchar*) ((char*) memory + offset);
-	frame.GetCharArrayRegion((jcharArray) a, start, len, b);
-}
-
-static void pack(jchar* d, jvalue v)
-{
-	*d = v.c;
-}
-
-PyObject *JPCharType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
-{
-	JP_TRACE_IN("JPCharType::newMultiArray");
-	return convertMultiArray<type_t>(
-			frame, this, &pack, "c",
-			buffer, subs, base, dims);
-	JP_TRACE_OUT;
+	jchar v = JPPyString::asCharUTF16(item);
+	JP_PY_CHECK();
+	return v;
 }
@@ -28,6 +28,7 @@ JPClass::JPClass(
 	m_SuperClass = nullptr;
 	m_Interfaces = JPClassList();
 	m_Modifiers = modifiers;
+	m_Immutable = false;
 }
 
 JPClass::JPClass(JPJavaFrame& frame,
@@ -43,6 +44,7 @@ JPClass::JPClass(JPJavaFrame& frame,
 	m_SuperClass = super;
 	m_Interfaces = interfaces;
 	m_Modifiers = modifiers;
+	m_Immutable = JPModifier::isEnum(modifiers);
 }
 
 JPClass::~JPClass()= default;
@@ -256,6 +258,149 @@ void JPClass::setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* ob
 	JP_TRACE_OUT;
 }
 
+/**
+ * Conversions resolved while converting a batch of elements.
+ *
+ * Like the method dispatch cache, this remembers the conversion found for
+ * each Python type and, for Java objects, Java class, so that the search
+ * over every conversion happens once per kind of element.  Conversions may
+ * still depend on the value, so the remembered conversion is checked again
+ * for each element.
+ */
+class JPConversionBatch
+{
+public:
+
+	explicit JPConversionBatch(JPClass *cls) : m_Class(cls)
+	{
+	}
+
+	/**
+	 * Resolve the conversion for an element.
+	 *
+	 * @return the match type or _none if the element can not be converted.
+	 */
+	JPMatch::Type resolve(JPMatch &match)
+	{
+		PyTypeObject *type = Py_TYPE(match.object);
+		JPValue *slot = match.getJavaSlot();
+		JPClass *slotClass = nullptr;
+		if (slot != nullptr)
+		{
+			// Null objects match differently from live ones
+			slotClass = slot->getClass();
+			if (slotClass == nullptr
+					|| (!slotClass->isPrimitive() && slot->getJavaObject() == nullptr))
+				return m_Class->findJavaConversion(match);
+		}
+		for (Entry &entry : m_Entries)
+		{
+			if (entry.type == type && entry.slotClass == slotClass)
+			{
+				match.conversion = entry.conversion;
+				match.closure = entry.closure;
+				if (entry.conversion != nullptr
+						&& entry.conversion->matches(m_Class, match) == entry.match)
+					return match.type;
+				return m_Class->findJavaConversion(match);
+			}
+		}
+		m_Class->findJavaConversion(match);
+		if (m_Entries.size() < 16)
+			m_Entries.push_back({type, slotClass, match.type, match.conversion, match.closure});
+		return match.type;
+	}
+
+private:
+
+	struct Entry
+	{
+		PyTypeObject *type;
+		JPClass *slotClass;
+		JPMatch::Type match;
+		JPConversion *conversion;
+		void *closure;
+	} ;
+
+	JPClass *m_Class;
+	std::vector<Entry> m_Entries;
+} ;
+
+/**
+ * Strings waiting to be stored into an array.
+ *
+ * The text is packed as UTF-16 so that the group is created and stored
+ * on the Java side in a single call.
+ */
+class JPStringBatch
+{
+public:
+
+	JPStringBatch(JPJavaFrame &frame, jobjectArray array)
+	: m_Frame(frame), m_Array(array)
+	{
+	}
+
+	void add(jsize index, PyObject *str)
+	{
+		Py_ssize_t n = PyUnicode_GET_LENGTH(str);
+		void *data = PyUnicode_DATA(str);
+		switch (PyUnicode_KIND(str))
+		{
+			case PyUnicode_1BYTE_KIND:
+				m_Chars.insert(m_Chars.end(), (Py_UCS1*) data, (Py_UCS1*) data + n);
+				break;
+			case PyUnicode_2BYTE_KIND:
+				m_Chars.insert(m_Chars.end(), (Py_UCS2*) data, (Py_UCS2*) data + n);
+				break;
+			default:
+				for (Py_ssize_t i = 0; i < n; ++i)
+				{
+					Py_UCS4 c = ((Py_UCS4*) data)[i];
+					if (c >= 0x10000)
+					{
+						c -= 0x10000;
+						m_Chars.push_back((jchar) (0xd800 + (c >> 10)));
+						m_Chars.push_back((jchar) (0xdc00 + (c & 0x3ff)));
+					} else
+						m_Chars.push_back((jchar) c);
+				}
+		}
+		m_Indices.push_back(index);
+		m_Ends.push_back((jint) m_Chars.size());
+		if (m_Chars.size() >= (1 << 22))
+			flush();
+	}
+
+	void flush()
+	{
+		if (m_Indices.empty())
+			return;
+		auto n = (jsize) m_Indices.size();
+		auto size = (jsize) m_Chars.size();
+		jintArray indices = m_Frame.NewIntArray(n);
+		m_Frame.SetIntArrayRegion(indices, 0, n, m_Indices.data());
+		jintArray ends = m_Frame.NewIntArray(n);
+		m_Frame.SetIntArrayRegion(ends, 0, n, m_Ends.data());
+		jcharArray chars = m_Frame.NewCharArray(size);
+		m_Frame.SetCharArrayRegion(chars, 0, size, m_Chars.data());
+		m_Frame.fillStrings(m_Array, indices, chars, ends);
+		m_Frame.DeleteLocalRef(indices);
+		m_Frame.DeleteLocalRef(ends);
+		m_Frame.DeleteLocalRef(chars);
+		m_Indices.clear();
+		m_Ends.clear();
+		m_Chars.clear();
+	}
+
+private:
+	JPJavaFrame &m_Frame;
+	jobjectArray m_Array;
+	std::vector<jint> m_Indices;
+	std::vector<jint> m_Ends;
+	std::vector<jchar> m_Chars;
+} ;
+
 void JPClass::setArrayRange(JPJavaFrame& frame, jarray a,
 		jsize start, jsize length, jsize step,
 		PyObject* vals)
@@ -264,26 +409,43 @@ void JPClass::setArrayRange(JPJavaFrame& frame, jarray a,
 	auto array = (jobjectArray) a;
 
 	// Verify before we start the conversion, as we wont be able
-	// to abort once we start
+	// to abort once we start.  Conversions can still fail on the value, so
+	// the elements are converted into a scratch array which is only copied
+	// once every element has succeeded.
 	JPPySequence seq = JPPySequence::use(vals);
+	JPConversionBatch batch(this);
 	JP_TRACE("Verify argument types");
 	for (int i = 0; i < length; i++)
 	{
 		JPPyObject v = seq[i];
 		JPMatch match(&frame, v.get());
-		if (findJavaConversion(match) < JPMatch::_implicit)
+		if (batch.resolve(match) < JPMatch::_implicit)
 			JP_RAISE(PyExc_TypeError, "Unable to convert");
 	}
 
-	JP_TRACE("Copy");
-	int index = start;
-	for (int i = 0; i < length; i++, index += step)
+	JP_TRACE("Convert");
+	jobjectArray scratch = frame.NewObjectArray(length, m_Context->_java_lang_Object->getJavaClass(), nullptr);
+	JPStringBatch strings(frame, scratch);
+	for (int i = 0; i < length; i++)
 	{
 		JPPyObject v = seq[i];
 		JPMatch match(&frame, v.get());
-		findJavaConversion(match);
-		frame.SetObjectArrayElement(array, index, match.convert().l);
+		batch.resolve(match);
+		if (match.conversion == stringConversion && PyUnicode_Check(v.get()))
+		{
+			strings.add(i, v.get());
+			continue;
+		}
+		jobject obj = match.convert().l;
+		frame.SetObjectArrayElement(scratch, i, obj);
+		if (obj != nullptr)
+			frame.DeleteLocalRef(obj);
 	}
+	strings.flush();
+
+	JP_TRACE("Copy");
+	frame.storeRange(scratch, array, start, step);
+	frame.DeleteLocalRef(scratch);
 	JP_TRACE_OUT;
 }
 
@@ -317,6 +479,33 @@ JPPyObject JPClass::getArrayItem(JPJavaFrame& frame, jarray a, jsize ndx)
 	JP_TRACE_OUT;
 }
 
+JPPyObject JPClass::getArrayRange(JPJavaFrame& frame, jarray a,
+		jsize start, jsize length, jsize step)
+{
+	JP_TRACE_IN("JPClass::getArrayRange");
+	auto array = (jobjectArray) a;
+	JPPyObject out = JPPyObject::call(PyList_New(length));
+
+	// Resolve the classes for the whole range in one call
+	std::vector<JPClass*> types;
+	jobjectArray snapshot = m_Context->getTypeManager()->findClassesForArray(
+			frame, array, start, length, step, types);
+	for (jsize i = 0; i < length; ++i)
+	{
+		jvalue v;
+		v.l = frame.GetObjectArrayElement(snapshot, i);
+		JPClass *retType = this;
+		if (v.l != nullptr && types[i] != nullptr)
+			retType = types[i];
+		PyList_SET_ITEM(out.get(), i, retType->convertToPythonObject(frame, v, false).keep());
+		if (v.l != nullptr)
+			frame.DeleteLocalRef(v.l);
+	}
+	frame.DeleteLocalRef(snapshot);
+	return out;
+	JP_TRACE_OUT;
+}
+
 //</editor-fold>
 //<editor-fold desc="conversion" defaultstate="collapsed">
 
@@ -330,6 +519,7 @@ JPValue JPClass::getValueFromObject(const JPValue& obj)
 JPPyObject JPClass::convertToPythonObject(JPJavaFrame& frame, jvalue value, bool cast)
 {
 	JP_TRACE_IN("JPClass::convertToPythonObject");
+	JP_COUNT(JPCOUNT_TO_PYTHON_OBJECT);
 	JPClass *cls = this;
 	if (!cast)
 	{
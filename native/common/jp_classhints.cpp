@@ -56,6 +56,24 @@ jvalue JPMatch::convert()
 	// Sanity check, this should not happen
 	if (conversion == nullptr)
 		JP_RAISE(PyExc_SystemError, "Fail in conversion"); // GCOVR_EXCL_LINE
+	if (JPCounters::isEnabled())
+	{
+		switch (type)
+		{
+			case _exact:
+				JPCounters::add(JPCOUNT_TO_JAVA_EXACT);
+				break;
+			case _derived:
+				JPCounters::add(JPCOUNT_TO_JAVA_DERIVED);
+				break;
+			case _implicit:
+				JPCounters::add(JPCOUNT_TO_JAVA_IMPLICIT);
+				break;
+			default:
+				JPCounters::add(JPCOUNT_TO_JAVA_EXPLICIT);
+				break;
+		}
+	}
 	return conversion->convert(*this);
 }
 
@@ -64,6 +82,7 @@ JPMethodMatch::JPMethodMatch(JPJavaFrame &frame, JPPyObjectVector& args, bool ca
 {
 	m_Type = JPMatch::_none;
 	m_IsVarIndirect = false;
+	m_Cached = false;
 	m_Overload = nullptr;
 	m_Offset = 0;
 	m_Skip = 0;
@@ -87,32 +106,6 @@ JPMethodMatch::JPMethodMatch(JPJavaFrame &frame, JPPyObjectVector& args, bool ca
 JPConversion::~JPConversion() = default;
 JPClassHints::JPClassHints() = default;
 
-JPClassHints::~JPClassHints()
-{
-	for (auto & conversion : conversions)
-	{
-		delete conversion;
-	}
-	conversions.clear();
-}
-
-JPMatch::Type JPClassHints::getConversion(JPMatch& match, JPClass *cls)
-{
-	JPConversion *best = nullptr;
-	for (auto & conversion : conversions)
-	{
-		JPMatch::Type quality = conversion->matches(cls, match);
-		if (quality > JPMatch::_explicit)
-			return match.type;
-		if (quality != JPMatch::_none)
-			best = conversion;
-	}
-	match.conversion = best;
-	if (best == nullptr)
-		return match.type = JPMatch::_none;
-	return match.type = JPMatch::_explicit;
-}
-
 void JPIndexConversion::getInfo(JPClass *cls, JPConversionInfo &info)
 {
 	PyObject *typing = PyImport_AddModule("jpype.protocol");
@@ -128,10 +121,36 @@ void JPNumberConversion::getInfo(JPClass *cls, JPConversionInfo &info)
 	PyList_Append(info.implicit, proto.get());
 }
 
+/**
+ * Base for conversions held in class hints.
+ *
+ * Conversions that test the type of the object expose the type so that the
+ * test can be resolved once for each Python type.
+ */
+class JPHintConversion : public JPConversion
+{
+public:
+
+	/**
+	 * Get the type tested by this conversion.
+	 *
+	 * @return a borrowed reference or null if the test depends on the object.
+	 */
+	virtual PyObject *getType()
+	{
+		return nullptr;
+	}
+
+	/**
+	 * Complete a match once the test has passed.
+	 */
+	virtual JPMatch::Type accept(JPClass *cls, JPMatch &match) = 0;
+} ;
+
 /**
  * Conversion for all user specified conversions.
  */
-class JPPythonConversion : public JPConversion
+class JPPythonConversion : public JPHintConversion
 {
 public:
 
@@ -142,6 +161,13 @@ public:
 
 	~JPPythonConversion() override = default;
 
+	JPMatch::Type accept(JPClass *cls, JPMatch &match) override
+	{
+		match.closure = cls;
+		match.conversion = this;
+		return match.type = JPMatch::_implicit;
+	}
+
 	jvalue convert(JPMatch &match) override
 	{
 		JP_TRACE_IN("JPPythonConversion::convert");
@@ -181,6 +207,7 @@ public:
 	JPAttributeConversion(string attribute, PyObject *method)
 	: JPPythonConversion(method), attribute_(std::move(attribute))
 	{
+		name_ = JPPyObject::call(PyUnicode_InternFromString(attribute_.c_str()));
 	}
 
 	~JPAttributeConversion() override = default;
@@ -188,12 +215,20 @@ public:
 	JPMatch::Type matches(JPClass *cls, JPMatch &match) override
 	{
 		JP_TRACE_IN("JPAttributeConversion::matches");
-		JPPyObject attr = JPPyObject::accept(PyObject_GetAttrString(match.object, attribute_.c_str()));
-		if (attr.isNull())
+		// Probe without raising an AttributeError for each miss
+		PyObject *attr = nullptr;
+#if PY_VERSION_HEX >= 0x030D0000
+		int found = PyObject_GetOptionalAttr(match.object, name_.get(), &attr);
+#else
+		int found = _PyObject_LookupAttr(match.object, name_.get(), &attr);
+#endif
+		Py_XDECREF(attr);
+		if (found <= 0)
+		{
+			PyErr_Clear();
 			return JPMatch::_none;
-		match.conversion = this;
-		match.closure = cls;
-		return match.type = JPMatch::_implicit;
+		}
+		return accept(cls, match);
 		JP_TRACE_OUT;
 	}
 
@@ -205,6 +240,7 @@ public:
 
 private:
 	std::string attribute_;
+	JPPyObject name_;
 
 } ;
 
@@ -213,13 +249,14 @@ void JPClassHints::addAttributeConversion(const string &attribute, PyObject *con
 	JP_TRACE_IN("JPClassHints::addAttributeConversion", this);
 	JP_TRACE(attribute);
 	conversions.push_back(new JPAttributeConversion(attribute, conversion));
+	invalidate();
 	JP_TRACE_OUT;
 }
 
 //</editor-fold>
 //<editor-fold desc="type conversion" defaultstate="collapsed">
 
-class JPNoneConversion : public JPConversion
+class JPNoneConversion : public JPHintConversion
 {
 public:
 
@@ -231,16 +268,26 @@ public:
 	~JPNoneConversion() override
 	= default;
 
+	PyObject *getType() override
+	{
+		return type_.get();
+	}
+
 	JPMatch::Type matches(JPClass *cls, JPMatch &match) override
 	{
 		JP_TRACE_IN("JPTypeConversion::matches");
 		if (!PyObject_IsInstance(match.object, type_.get()))
 			return JPMatch::_none;
+		return accept(cls, match);
+		JP_TRACE_OUT;
+	}
+
+	JPMatch::Type accept(JPClass *cls, JPMatch &match) override
+	{
 		match.closure = cls;
 		match.conversion = this;
 		match.type = JPMatch::_none;
 		return JPMatch::_implicit; // Prevent further searching
-		JP_TRACE_OUT;
 	}
 
 	void getInfo(JPClass *cls, JPConversionInfo &info) override
@@ -270,15 +317,18 @@ public:
 	~JPTypeConversion() override
 	= default;
 
+	PyObject *getType() override
+	{
+		return type_.get();
+	}
+
 	JPMatch::Type matches(JPClass *cls, JPMatch &match) override
 	{
 		JP_TRACE_IN("JPTypeConversion::matches");
 		if ((exact_ && ((PyObject*) Py_TYPE(match.object)) == type_.get())
 				|| PyObject_IsInstance(match.object, type_.get()))
 		{
-			match.closure = cls;
-			match.conversion = this;
-			return match.type = JPMatch::_implicit;
+			return accept(cls, match);
 		}
 		return JPMatch::_none;
 		JP_TRACE_OUT;
@@ -298,6 +348,7 @@ void JPClassHints::addTypeConversion(PyObject *type, PyObject *method, bool exac
 {
 	JP_TRACE_IN("JPClassHints::addTypeConversion", this);
 	conversions.push_back(new JPTypeConversion(type, method, exact));
+	invalidate();
 	JP_TRACE_OUT;
 }
 
@@ -305,6 +356,7 @@ void JPClassHints::excludeConversion(PyObject *type)
 {
 	JP_TRACE_IN("JPClassHints::addTypeConversion", this);
 	conversions.push_front(new JPNoneConversion(type));
+	invalidate();
 	JP_TRACE_OUT;
 }
 
@@ -317,6 +369,118 @@ void JPClassHints::getInfo(JPClass *cls, JPConversionInfo &info)
 	}
 }
 
+// Plans are dropped rather than evicted one at a time when there are too
+// many types.
+static const size_t JP_HINT_PLAN_LIMIT = 256;
+
+static PyObject *abcMeta = nullptr;
+static PyObject *abcToken = nullptr;
+
+void JPClassHints::invalidate()
+{
+	m_Plans.clear();
+	if (abcMeta == nullptr)
+	{
+		JPPyObject abc = JPPyObject::call(PyImport_ImportModule("abc"));
+		abcMeta = PyObject_GetAttrString(abc.get(), "ABCMeta");
+		JP_PY_CHECK();
+		abcToken = PyObject_GetAttrString(abc.get(), "get_cache_token");
+		JP_PY_CHECK();
+	}
+
+	// Type tests can be cached if they depend only on the type.  Abstract
+	// base classes can gain members through register(), which changes the
+	// abc cache token.
+	m_UsesAbc = false;
+	for (auto & conversion : conversions)
+	{
+		PyObject *type = conversion->getType();
+		if (type != nullptr && (PyObject*) Py_TYPE(type) == abcMeta)
+			m_UsesAbc = true;
+	}
+}
+
+JPClassHints::Plan& JPClassHints::getPlan(PyObject *obj)
+{
+	if (m_UsesAbc)
+	{
+		JPPyObject token = JPPyObject::call(PyObject_CallObject(abcToken, nullptr));
+		if (m_AbcToken == nullptr || PyObject_RichCompareBool(token.get(), m_AbcToken, Py_EQ) != 1)
+		{
+			m_Plans.clear();
+			Py_XDECREF(m_AbcToken);
+			m_AbcToken = token.keep();
+		}
+	}
+
+	PyTypeObject *tp = Py_TYPE(obj);
+	auto iter = m_Plans.find(tp);
+	if (iter != m_Plans.end())
+		return iter->second;
+
+	// The plan is built before it is stored as the instance checks can run
+	// Python which may clear the plans.  Holding the type keeps its address
+	// from being reused.
+	Plan plan;
+	plan.type = JPPyObject::use((PyObject*) tp);
+	for (auto & conversion : conversions)
+	{
+		PyObject *type = conversion->getType();
+		PyObject *meta = (type != nullptr) ? (PyObject*) Py_TYPE(type) : nullptr;
+		if (meta != (PyObject*) & PyType_Type && meta != abcMeta)
+		{
+			// Attributes and other instance checks depend on the object
+			plan.entries.emplace_back(conversion, false);
+			continue;
+		}
+		int result = PyObject_IsInstance(obj, type);
+		if (result < 0)
+		{
+			PyErr_Clear();
+			plan.entries.emplace_back(conversion, false);
+		} else if (result == 1)
+			plan.entries.emplace_back(conversion, true);
+	}
+	if (m_Plans.size() >= JP_HINT_PLAN_LIMIT)
+		m_Plans.clear();
+	return m_Plans[tp] = std::move(plan);
+}
+
+JPClassHints::~JPClassHints()
+{
+	for (auto & conversion : conversions)
+	{
+		delete conversion;
+	}
+	conversions.clear();
+	Py_XDECREF(m_AbcToken);
+}
+
+JPMatch::Type JPClassHints::getConversion(JPMatch& match, JPClass *cls)
+{
+	JPConversion *best = nullptr;
+	if (!conversions.empty())
+	{
+		// Matching can run Python which may clear the plans, so the entries
+		// are copied rather than iterated in place.
+		auto entries = getPlan(match.object).entries;
+		for (auto & entry : entries)
+		{
+			JPMatch::Type quality = entry.second
+					? entry.first->accept(cls, match)
+					: entry.first->matches(cls, match);
+			if (quality > JPMatch::_explicit)
+				return match.type;
+			if (quality != JPMatch::_none)
+				best = entry.first;
+		}
+	}
+	match.conversion = best;
+	if (best == nullptr)
+		return match.type = JPMatch::_none;
+	return match.type = JPMatch::_explicit;
+}
+
 class JPHintsConversion : public JPConversion
 {
 public:
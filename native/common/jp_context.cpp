@@ -21,6 +21,8 @@
 #include "jp_proxy.h"
 #include "jp_platform.h"
 #include "jp_gc.h"
+#include "jp_async.h"
+#include <chrono>
 
 JPResource::~JPResource() = default;
 
@@ -37,12 +39,14 @@ JPContext::JPContext()
 	m_Embedded = false;
 
 	m_GC = new JPGarbageCollection(this);
+	m_Async = new JPAsync(this);
 }
 
 JPContext::~JPContext()
 {
 	delete m_TypeManager;
 	delete m_GC;
+	delete m_Async;
 }
 
 bool JPContext::isRunning()
@@ -248,6 +252,14 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 			"assemble",
 			"([ILjava/lang/Object;)Ljava/lang/Object;");
 
+	m_Context_FillStringsID = frame.GetMethodID(contextClass,
+			"fillStrings",
+			"([Ljava/lang/Object;[I[C[I)V");
+
+	m_Context_StoreRangeID = frame.GetMethodID(contextClass,
+			"storeRange",
+			"([Ljava/lang/Object;[Ljava/lang/Object;II)V");
+
 	m_Context_CreateExceptionID = frame.GetMethodID(contextClass, "createException",
 			"(JJ)Ljava/lang/Exception;");
 	m_Context_GetExcClassID = frame.GetMethodID(contextClass, "getExcClass",
@@ -289,6 +301,7 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 			"()Ljava/lang/Object;");
 
 	m_GC->init(frame);
+	m_Async->init(frame);
 
 	_java_nio_ByteBuffer = this->getTypeManager()->findClassByName("java.nio.ByteBuffer");
 
@@ -302,6 +315,7 @@ void JPContext::initializeResources(JNIEnv* env, bool interrupt)
 void JPContext::onShutdown()
 {
 	m_Running = false;
+	m_Async->stopCallbacks();
 }
 
 void JPContext::shutdownJVM(bool destroyJVM, bool freeJVM)
@@ -312,6 +326,9 @@ void JPContext::shutdownJVM(bool destroyJVM, bool freeJVM)
 	//	if (m_Embedded)
 	//		JP_RAISE(PyExc_RuntimeError, "Cannot shutdown from embedded Python");
 
+	// Threads waiting on queued proxy calls would block the shutdown
+	m_Async->stopCallbacks();
+
 	// Wait for all non-demon threads to terminate
 	if (destroyJVM)
 	{
@@ -351,26 +368,73 @@ void JPContext::ReleaseGlobalRef(jobject obj)
 	JNIEnv* env;
 	jint res = m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION);
 	if (res != JNI_EDETACHED)
+	{
+		JP_COUNT(JPCOUNT_GLOBAL_DELETE);
 		env->functions->DeleteGlobalRef(env, obj);
+	}
 	JP_TRACE_OUT;
 }
 
 /*****************************************************************************/
 // Thread code
 
-void JPContext::attachCurrentThread()
+namespace
 {
-	JNIEnv* env;
-	jint res = m_JavaVM->functions->AttachCurrentThread(m_JavaVM, (void**) &env, nullptr);
+
+/**
+ * Marks a thread that JPype attached so it can be detached on exit.
+ *
+ * The destructor runs when the native thread terminates, after Python has
+ * finished with the thread.
+ */
+class JPThreadAttachment
+{
+public:
+	JPContext *m_Context = nullptr;
+
+	~JPThreadAttachment()
+	{
+		if (m_Context != nullptr)
+			m_Context->onThreadExit();
+	}
+} ;
+
+thread_local JPThreadAttachment jp_thread_attachment;
+
+}
+
+JNIEnv* JPContext::attach(bool daemon)
+{
+	JNIEnv* env = nullptr;
+
+	// Threads which are already attached, whether by us or by Java, are
+	// left as they are and not counted again.
+	if (m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION) == JNI_OK)
+		return env;
+	auto start = std::chrono::steady_clock::now();
+	jint res;
+	if (daemon)
+		res = m_JavaVM->functions->AttachCurrentThreadAsDaemon(m_JavaVM, (void**) &env, nullptr);
+	else
+		res = m_JavaVM->functions->AttachCurrentThread(m_JavaVM, (void**) &env, nullptr);
 	if (res != JNI_OK)
+		return nullptr;
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	m_AttachTime += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	m_Attaches++;
+	jp_thread_attachment.m_Context = this;
+	return env;
+}
+
+void JPContext::attachCurrentThread()
+{
+	if (attach(false) == nullptr)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread");
 }
 
 void JPContext::attachCurrentThreadAsDaemon()
 {
-	JNIEnv* env;
-	jint res = m_JavaVM->functions->AttachCurrentThreadAsDaemon(m_JavaVM, (void**) &env, nullptr);
-	if (res != JNI_OK)
+	if (attach(true) == nullptr)
 		JP_RAISE(PyExc_RuntimeError, "Unable to attach to thread as daemon");
 }
 
@@ -382,7 +446,36 @@ bool JPContext::isThreadAttached()
 
 void JPContext::detachCurrentThread()
 {
-	m_JavaVM->functions->DetachCurrentThread(m_JavaVM);
+	// Only count threads that we attached so the attached count can not go
+	// negative when a thread created by Java is detached.
+	bool ours = jp_thread_attachment.m_Context == this;
+	if (m_JavaVM->functions->DetachCurrentThread(m_JavaVM) == JNI_OK && ours)
+		m_Detaches++;
+	jp_thread_attachment.m_Context = nullptr;
+}
+
+void JPContext::onThreadExit()
+{
+	// Nothing to do if the JVM has already gone
+	if (m_JavaVM == nullptr || !m_Running)
+		return;
+	JNIEnv* env;
+	if (m_JavaVM->functions->GetEnv(m_JavaVM, (void**) &env, USE_JNI_VERSION) != JNI_OK)
+		return;
+	if (m_JavaVM->functions->DetachCurrentThread(m_JavaVM) == JNI_OK)
+	{
+		m_Detaches++;
+		m_AutoDetaches++;
+	}
+}
+
+void JPContext::getAttachStats(JPAttachStats& stats)
+{
+	stats.attaches = m_Attaches;
+	stats.detaches = m_Detaches;
+	stats.auto_detaches = m_AutoDetaches;
+	stats.attached = stats.attaches - stats.detaches;
+	stats.attach_time = m_AttachTime;
 }
 
 JNIEnv* JPContext::getEnv()
@@ -401,8 +494,9 @@ JNIEnv* JPContext::getEnv()
 	{
 		// We will attach as daemon so that the newly attached thread does
 		// not deadlock the shutdown.  The user can convert later if they want.
-		res = m_JavaVM->AttachCurrentThreadAsDaemon((void**) &env, nullptr);
-		if (res != JNI_OK)
+		// The thread is detached automatically when it exits.
+		env = attach(true);
+		if (env == nullptr)
 			JP_RAISE(PyExc_RuntimeError, "Unable to attach to local thread");
 	}
 	return env;
@@ -514,3 +514,61 @@ jconverter getConverter(const char* from, int itemsize, const char* to)
 	PyErr_Format(PyExc_ValueError, "Unable to handle buffer type '%s'", from);
 	JP_RAISE_PYTHON();
 }
+
+JPScalar getScalar(const char* from, int itemsize)
+{
+	if (from == nullptr)
+		from = "B";
+
+	// Only native byte order is handled
+	unsigned int x = 1;
+	bool little = *((char*)&x)==1;
+	switch (from[0])
+	{
+		case '!':
+		case '>':
+			if (little)
+				return JPSCALAR_OTHER;
+			from++;
+			break;
+		case '<':
+			if (!little)
+				return JPSCALAR_OTHER;
+			from++;
+			break;
+		case '@':
+		case '=':
+			from++;
+		default:
+			break;
+	}
+	if (from[0] == 0 || from[1] != 0)
+		return JPSCALAR_OTHER;
+
+	JPScalar out;
+	switch (from[0])
+	{
+		case '?':
+		case 'c':
+		case 'b': out = JPSCALAR_INT8; break;
+		case 'B': out = JPSCALAR_UINT8; break;
+		case 'h': out = JPSCALAR_INT16; break;
+		case 'H': out = JPSCALAR_UINT16; break;
+		case 'i': out = JPSCALAR_INT32; break;
+		case 'I': out = JPSCALAR_UINT32; break;
+		// Standard size for 'l' is 4 in docs, but numpy uses format 'l' for long long
+		case 'l': out = (itemsize == 8) ? JPSCALAR_INT64 : JPSCALAR_INT32; break;
+		case 'L': out = (itemsize == 8) ? JPSCALAR_UINT64 : JPSCALAR_UINT32; break;
+		case 'q': out = JPSCALAR_INT64; break;
+		case 'Q': out = JPSCALAR_UINT64; break;
+		case 'f': out = JPSCALAR_FLOAT32; break;
+		case 'd': out = JPSCALAR_FLOAT64; break;
+		default: return JPSCALAR_OTHER;
+	}
+
+	// Reject items which are not the size of the scalar
+	static const int sizes[] = {0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+	if (sizes[out] != itemsize)
+		return JPSCALAR_OTHER;
+	return out;
+}
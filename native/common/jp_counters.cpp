@@ -0,0 +1,177 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include <algorithm>
+#include <mutex>
+
+std::atomic<bool> JPCounters::s_Enabled{false};
+std::atomic<bool> JPCounters::s_Timing{false};
+
+namespace
+{
+
+/**
+ * Counts for one thread.
+ *
+ * Only the owning thread writes, so updates are a relaxed load and store
+ * rather than a locked add.  Other threads only read.
+ */
+struct JPCounterShard
+{
+	std::atomic<uint64_t> counts[JPCOUNT_SIZE];
+	std::atomic<uint64_t> timeCount[JPTIME_SIZE];
+	std::atomic<uint64_t> timeTotal[JPTIME_SIZE];
+	std::atomic<uint64_t> buckets[JPTIME_SIZE][JPTIME_BUCKETS];
+} ;
+
+inline void bump(std::atomic<uint64_t>& v, uint64_t n)
+{
+	v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+std::mutex s_Lock;
+// Never freed as threads may exit during shutdown
+std::vector<JPCounterShard*> *s_Shards = new std::vector<JPCounterShard*>();
+// Counts from threads that have exited
+JPCounters::Snapshot s_Retired{};
+// Counts at the last reset
+JPCounters::Snapshot s_Base{};
+
+void addShard(JPCounters::Snapshot& out, const JPCounterShard& shard)
+{
+	for (int i = 0; i < JPCOUNT_SIZE; ++i)
+		out.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+	for (int i = 0; i < JPTIME_SIZE; ++i)
+	{
+		JPCounters::Histogram& h = out.timers[i];
+		h.count += shard.timeCount[i].load(std::memory_order_relaxed);
+		h.total += shard.timeTotal[i].load(std::memory_order_relaxed);
+		for (int j = 0; j < JPTIME_BUCKETS; ++j)
+			h.buckets[j] += shard.buckets[i][j].load(std::memory_order_relaxed);
+	}
+}
+
+class JPCounterHolder
+{
+public:
+
+	~JPCounterHolder()
+	{
+		if (m_Shard == nullptr)
+			return;
+		std::lock_guard<std::mutex> guard(s_Lock);
+		addShard(s_Retired, *m_Shard);
+		s_Shards->erase(std::remove(s_Shards->begin(), s_Shards->end(), m_Shard), s_Shards->end());
+		delete m_Shard;
+	}
+
+	JPCounterShard* get()
+	{
+		if (m_Shard == nullptr)
+		{
+			auto *shard = new JPCounterShard();
+			std::lock_guard<std::mutex> guard(s_Lock);
+			s_Shards->push_back(shard);
+			m_Shard = shard;
+		}
+		return m_Shard;
+	}
+
+private:
+	JPCounterShard* m_Shard = nullptr;
+} ;
+
+thread_local JPCounterHolder jp_counter_shard;
+
+}
+
+void JPCounters::setEnabled(bool enabled, bool timing)
+{
+	s_Enabled = enabled;
+	s_Timing = enabled && timing;
+}
+
+void JPCounters::add(JPCounter counter)
+{
+	bump(jp_counter_shard.get()->counts[counter], 1);
+}
+
+void JPCounters::record(JPTimer timer, uint64_t ns)
+{
+	JPCounterShard *shard = jp_counter_shard.get();
+	int bucket = 0;
+	for (uint64_t v = ns; v != 0 && bucket < JPTIME_BUCKETS - 1; v >>= 1)
+		bucket++;
+	bump(shard->timeCount[timer], 1);
+	bump(shard->timeTotal[timer], ns);
+	bump(shard->buckets[timer][bucket], 1);
+}
+
+void JPCounters::snapshot(Snapshot& out, bool reset)
+{
+	Snapshot total{};
+	std::lock_guard<std::mutex> guard(s_Lock);
+	total = s_Retired;
+	for (JPCounterShard *shard : *s_Shards)
+		addShard(total, *shard);
+
+	// Shards are never written by other threads, so a reset is taken as a
+	// new base rather than by clearing them.
+	out = total;
+	for (int i = 0; i < JPCOUNT_SIZE; ++i)
+		out.counts[i] -= s_Base.counts[i];
+	for (int i = 0; i < JPTIME_SIZE; ++i)
+	{
+		out.timers[i].count -= s_Base.timers[i].count;
+		out.timers[i].total -= s_Base.timers[i].total;
+		for (int j = 0; j < JPTIME_BUCKETS; ++j)
+			out.timers[i].buckets[j] -= s_Base.timers[i].buckets[j];
+	}
+	if (reset)
+		s_Base = total;
+}
+
+const char* JPCounters::getName(JPCounter counter)
+{
+	static const char *names[] = {
+		"jni_calls",
+		"frames",
+		"global_refs_created",
+		"global_refs_deleted",
+		"gil_releases",
+		"gil_acquires",
+		"dispatch_cache_hits",
+		"dispatch_cache_misses",
+		"to_java_exact",
+		"to_java_derived",
+		"to_java_implicit",
+		"to_java_explicit",
+		"to_python_primitive",
+		"to_python_string",
+		"to_python_array",
+		"to_python_object",
+	};
+	return names[counter];
+}
+
+const char* JPCounters::getName(JPTimer timer)
+{
+	static const char *names[] = {
+		"java_call",
+		"gil_wait",
+	};
+	return names[timer];
+}
@@ -16,9 +16,12 @@
 #include <Python.h>
 #include "jpype.h"
 #include "pyjp.h"
+#include "jp_classloader.h"
 #include "jp_reference_queue.h"
 #include "jp_gc.h"
 
+#include <chrono>
+
 #ifdef WIN32
 #define USE_PROCESS_INFO
 #include <Windows.h>
@@ -30,18 +33,15 @@
 #include <sys/resource.h>
 #include <mach/mach.h>
 
-#elif __GLIBC__
-// Linux doesn't have an available rss tally so use mallinfo
-#define USE_MALLINFO
-#include <malloc.h>
-
 #elif __linux__
+// Use the resident set from statm rather than the malloc tally as Java
+// allocates outside of malloc.
 #define USE_PROC_INFO
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <fcntl.h>
-static int statm_fd;
+static int statm_fd = -1;
 static int page_size;
 
 #else
@@ -64,9 +64,10 @@ size_t getWorkingSize()
 		current = (size_t) info.resident_size;
 
 #elif defined(USE_PROC_INFO)
+	if (statm_fd < 0)
+		return 0;
 	char bytes[32];
-	lseek(statm_fd, SEEK_SET, 0);
-	int len = read(statm_fd, bytes, 32);
+	int len = (int) pread(statm_fd, bytes, 32, 0);
 	long long sz = 0;
 	int i = 0;
 	for (; i < len; i++)
@@ -83,16 +84,162 @@ size_t getWorkingSize()
 		sz += bytes[i] - '0';
 	}
 	return sz * page_size;
-
-#elif defined(USE_MALLINFO)
-	struct mallinfo mi;
-	mi = mallinfo();
-	current = (size_t) mi.uordblks;
 #endif
 
 	return current;
 }
 
+static long long getTimeMillis()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+JPGCConfig::JPGCConfig()
+{
+	policy = "adaptive";
+	delta = DELTA_LIMIT;
+	heap_fraction = 0.75;
+	interval = 1000;
+	async = true;
+}
+
+/**
+ * Original policy based only on the growth of the process.
+ *
+ * Tracks the high and low water marks of the working set and requests a
+ * collection when the working set passes a limit or is predicted to pass it
+ * soon.
+ */
+class JPGCAdaptivePolicy : public JPGCPolicy
+{
+public:
+
+	void reset(size_t current) override
+	{
+		low_water = current;
+		high_water = current;
+		limit = current + delta;
+		last = 0;
+	}
+
+	bool decide(JPGarbageCollection& gc, size_t current) override
+	{
+		delta = gc.getConfig().delta;
+		bool run_gc = false;
+		if (current > high_water)
+			high_water = current;
+		if (current < low_water)
+			low_water = current;
+
+		// Things are getting better so use high water as limit
+		if (current == low_water)
+		{
+			limit = (limit + high_water) / 2;
+			if ( high_water > low_water + 4 * delta)
+				high_water = low_water + 4 * delta;
+		}
+
+		if (current < last)
+		{
+			last = current;
+			return false;
+		}
+
+		// Decide the policy
+		if (current > limit)
+		{
+			limit = high_water + delta;
+			run_gc = true;
+		}
+
+		// Predict if we will cross the limit soon.
+		Py_ssize_t pred = current + 2 * (current - last);
+		last = current;
+		if ((Py_ssize_t) pred > (Py_ssize_t) limit)
+		{
+			run_gc = true;
+			limit = high_water + (high_water>>3) + 8 * (current - last);
+		}
+
+		// Move up the low water
+		if (run_gc)
+			low_water = (low_water + high_water) / 2;
+		return run_gc;
+	}
+
+private:
+	size_t delta = DELTA_LIMIT;
+	size_t low_water = 0;
+	size_t high_water = 0;
+	size_t limit = 0;
+	size_t last = 0;
+} ;
+
+/**
+ * Policy based on the occupancy of the Java heap.
+ *
+ * The Java heap is only consulted once the process has grown by the delta
+ * since the last decision, so most Python collections cost a single read of
+ * the working set. A collection is requested when the used portion of the
+ * heap exceeds the configured fraction of its maximum.
+ */
+class JPGCHeapPolicy : public JPGCPolicy
+{
+public:
+
+	void reset(size_t current) override
+	{
+		base = current;
+	}
+
+	bool decide(JPGarbageCollection& gc, size_t current) override
+	{
+		const JPGCConfig& config = gc.getConfig();
+		if (current < base)
+			base = current;
+		if ((long long) (current - base) < config.delta)
+			return false;
+		base = current;
+		JPGCHeap heap;
+		if (!gc.getJavaHeap(heap))
+			return false;
+		jlong max = (heap.max > 0) ? heap.max : heap.committed;
+		return heap.used > config.heap_fraction * max;
+	}
+
+private:
+	size_t base = 0;
+} ;
+
+/**
+ * Never request Java collections.
+ */
+class JPGCNonePolicy : public JPGCPolicy
+{
+public:
+
+	void reset(size_t current) override
+	{
+	}
+
+	bool decide(JPGarbageCollection& gc, size_t current) override
+	{
+		return false;
+	}
+} ;
+
+static JPGCPolicy* createPolicy(const string& name)
+{
+	if (name == "adaptive")
+		return new JPGCAdaptivePolicy();
+	if (name == "heap")
+		return new JPGCHeapPolicy();
+	if (name == "none")
+		return new JPGCNonePolicy();
+	return nullptr;
+}
+
 void triggerPythonGC();
 
 void JPGarbageCollection::triggered()
@@ -114,22 +261,32 @@ void JPGarbageCollection::triggered()
 JPGarbageCollection::JPGarbageCollection(JPContext *context)
 {
 	m_Context = context;
+	m_Policy = createPolicy(m_Config.policy);
 	running = false;
 	in_python_gc = false;
 	java_triggered = false;
 	python_gc = nullptr;
 	_SystemClass = nullptr;
+	_ContextClass = nullptr;
+	_MonitorClass = nullptr;
 	_gcMethodID = nullptr;
+	_heapStatsID = nullptr;
+	_requestID = nullptr;
 
 	last_python = 0;
 	last_java = 0;
 	low_water = 0;
 	high_water = 0;
-	limit = 0;
-	last = 0;
+	last_request = 0;
 	java_count = 0;
 	python_count = 0;
 	python_triggered = 0;
+	skipped = 0;
+}
+
+JPGarbageCollection::~JPGarbageCollection()
+{
+	delete m_Policy;
 }
 
 void JPGarbageCollection::init(JPJavaFrame& frame)
@@ -162,19 +319,78 @@ void JPGarbageCollection::init(JPJavaFrame& frame)
 	_usedMemoryID = frame.GetStaticMethodID(ctxt, "getUsedMemory", "()J");
 	_heapMemoryID = frame.GetStaticMethodID(ctxt, "getHeapMemory", "()J");
 
+	// The monitor reads the heap in one call and collects off the Python thread
+	jclass monitor = frame.getContext()->getClassLoader()->findClass(frame, "org.jpype.ref.JPypeHeapMonitor");
+	_MonitorClass = (jclass) frame.NewGlobalRef(monitor);
+	_heapStatsID = frame.GetStaticMethodID(_MonitorClass, "getHeapStats", "()[J");
+	_requestID = frame.GetStaticMethodID(_MonitorClass, "requestCollection", "()Z");
+
 	running = true;
 	high_water = getWorkingSize();
-	limit = high_water + DELTA_LIMIT;
+	low_water = high_water;
+	m_Policy->reset(high_water);
 }
 
 void JPGarbageCollection::shutdown()
 {
 	running = false;
 #if defined(USE_PROC_INFO)
-	close(statm_fd);
+	if (statm_fd >= 0)
+		close(statm_fd);
+	statm_fd = -1;
 #endif
 }
 
+void JPGarbageCollection::setConfig(const JPGCConfig& config)
+{
+	if (config.policy != m_Config.policy)
+	{
+		JPGCPolicy *policy = createPolicy(config.policy);
+		if (policy == nullptr)
+			JP_RAISE(PyExc_ValueError, "Unknown gc policy '" + config.policy + "'");
+		delete m_Policy;
+		m_Policy = policy;
+		m_Policy->reset(getWorkingSize());
+	}
+	m_Config = config;
+}
+
+bool JPGarbageCollection::getJavaHeap(JPGCHeap& heap)
+{
+	if (!running)
+		return false;
+	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
+	jlongArray array = (jlongArray) frame.CallStaticObjectMethodA(_MonitorClass, _heapStatsID, nullptr);
+	jlong values[6];
+	frame.GetLongArrayRegion(array, 0, 6, values);
+	heap.used = values[0];
+	heap.committed = values[1];
+	heap.max = values[2];
+	heap.collections = values[3];
+	heap.collection_time = values[4];
+	heap.used_after_collection = values[5];
+	return true;
+}
+
+void JPGarbageCollection::requestCollection()
+{
+	// Rate limit the requests so a burst of Python collections
+	// can't stall Java.
+	long long now = getTimeMillis();
+	if (last_request != 0 && now - last_request < m_Config.interval)
+	{
+		skipped++;
+		return;
+	}
+	last_request = now;
+	python_triggered++;
+	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
+	if (m_Config.async)
+		frame.CallStaticBooleanMethodA(_MonitorClass, _requestID, nullptr);
+	else
+		frame.CallStaticVoidMethodA(_SystemClass, _gcMethodID, nullptr);
+}
+
 void JPGarbageCollection::onStart()
 {
 	// GCOVR_EXCL_START
@@ -182,7 +398,6 @@ void JPGarbageCollection::onStart()
 	// coverage just creates random statistics.
 	if (!running)
 		return;
-	getWorkingSize();
 	in_python_gc = true;
 	// GCOVR_EXCL_STOP
 }
@@ -198,81 +413,23 @@ void JPGarbageCollection::onEnd()
 	{
 		// Remove our lock so that we can watch for triggers
 		java_triggered = false;
+		last_java = getWorkingSize();
 		return;
 	}
 	if (in_python_gc)
 	{
 		in_python_gc = false;
 		python_count++;
-		int run_gc = 0;
 
 		size_t current = getWorkingSize();
 		if (current > high_water)
 			high_water = current;
 		if (current < low_water)
 			low_water = current;
+		last_python = current;
 
-		if (java_triggered)
-			last_java = current;
-		else
-			last_python = current;
-
-		// Things are getting better so use high water as limit
-		if (current == low_water)
-		{
-			limit = (limit + high_water) / 2;
-			if ( high_water > low_water + 4 * DELTA_LIMIT)
-				high_water = low_water + 4 * DELTA_LIMIT;
-		}
-
-		if (last_python > current)
-			last_python = current;
-
-		if (current < last)
-		{
-			last = current;
-			return;
-		}
-
-		// Decide the policy
-		if (current > limit)
-		{
-			limit = high_water + DELTA_LIMIT;
-			run_gc = 1;
-		}
-
-		// Predict if we will cross the limit soon.
-		Py_ssize_t pred = current + 2 * (current - last);
-		last = current;
-		if ((Py_ssize_t) pred > (Py_ssize_t) limit)
-		{
-			run_gc = 2;
-			limit = high_water + (high_water>>3) + 8 * (current - last);
-		}
-
-#if 0
-		{
-			JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-			jlong totalMemory = frame.CallStaticLongMethodA(_ContextClass, _totalMemoryID, nullptr);
-			jlong freeMemory = frame.CallStaticLongMethodA(_ContextClass, _freeMemoryID, nullptr);
-			jlong maxMemory = frame.CallStaticLongMethodA(_ContextClass, _maxMemoryID, nullptr);
-			jlong usedMemory = frame.CallStaticLongMethodA(_ContextClass, _usedMemoryID, nullptr);
-			jlong heapMemory = frame.CallStaticLongMethodA(_ContextClass, _heapMemoryID, nullptr);
-			printf("consider gc run=%d (current=%ld, low=%ld, high=%ld, limit=%ld) %ld\n", run_gc,
-				current, low_water, high_water, limit, limit - pred);
-			printf(" java total=%ld free=%ld max=%ld used=%ld heap=%ld\n", totalMemory, freeMemory, maxMemory, usedMemory, heapMemory);
-		}
-#endif
-
-		if (run_gc > 0)
-		{
-			// Move up the low water
-			low_water = (low_water + high_water) / 2;
-			// Don't reset the limit if it was count triggered
-			JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-			frame.CallStaticVoidMethodA(_SystemClass, _gcMethodID, nullptr);
-			python_triggered++;
-		}
+		if (m_Policy->decide(*this, current))
+			requestCollection();
 	}
 	// GCOVR_EXCL_STOP
 }
@@ -286,5 +443,16 @@ void JPGarbageCollection::getStats(JPGCStats& stats)
 	stats.java_rss = last_java;
 	stats.python_rss = last_python;
 	stats.python_triggered = python_triggered;
+	stats.python_collections = python_count;
+	stats.java_triggered = java_count;
+	stats.skipped = skipped;
+	JPGCHeap heap;
+	if (!getJavaHeap(heap))
+		heap = JPGCHeap();
+	stats.java_used = heap.used;
+	stats.java_committed = heap.committed;
+	stats.java_max = heap.max;
+	stats.java_collections = heap.collections;
+	stats.java_collection_time = heap.collection_time;
 	// GCOVR_EXCL_STOP
 }
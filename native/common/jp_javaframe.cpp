@@ -42,6 +42,7 @@ JPJavaFrame::JPJavaFrame(JPContext* context, JNIEnv* p_env, int size, bool outer
 
 	// Create a memory management frame to live in
 	m_Env->PushLocalFrame(size);
+	JP_COUNT(JPCOUNT_FRAME);
 	JP_TRACE_JAVA("JavaFrame", (jobject) - 1);
 }
 
@@ -50,6 +51,7 @@ JPJavaFrame::JPJavaFrame(const JPJavaFrame& frame)
 {
 	// Create a memory management frame to live in
 	m_Env->PushLocalFrame(LOCAL_FRAME_DEFAULT);
+	JP_COUNT(JPCOUNT_FRAME);
 	JP_TRACE_JAVA("JavaFrame (copy)", (jobject) - 1);
 }
 
@@ -89,6 +91,7 @@ void JPJavaFrame::DeleteLocalRef(jobject obj)
 void JPJavaFrame::DeleteGlobalRef(jobject obj)
 {
 	JP_TRACE_JAVA("Delete global", obj);
+	JP_COUNT(JPCOUNT_GLOBAL_DELETE);
 	m_Env->DeleteGlobalRef(obj);
 }
 
@@ -119,6 +122,7 @@ jobject JPJavaFrame::NewLocalRef(jobject obj)
 jobject JPJavaFrame::NewGlobalRef(jobject obj)
 {
 	JP_TRACE_JAVA("New Global", obj);
+	JP_COUNT(JPCOUNT_GLOBAL_NEW);
 	obj = m_Env->NewGlobalRef(obj);
 	JP_TRACE_JAVA("Global", obj);
 	return obj;
@@ -173,31 +177,37 @@ jthrowable JPJavaFrame::ExceptionOccurred()
 #ifdef JP_INSTRUMENTATION
 #define JAVA_RETURN(X,Y,Z) \
   PyJPModuleFault_throw(compile_hash(Y)); \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   X ret = Z; \
   check(); \
   return ret;
 #define JAVA_RETURN_OBJ(X,Y,Z) \
   PyJPModuleFault_throw(compile_hash(Y)); \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   X ret = Z; \
   check(); \
   return ret;
 #define JAVA_CHECK(Y,Z) \
   PyJPModuleFault_throw(compile_hash(Y)); \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   Z; \
   check();
 #else
 #define JAVA_RETURN(X,Y,Z) \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   X ret = Z; \
   JP_TRACE_JAVA(Y, 0); \
   check(); \
   return ret;
 #define JAVA_RETURN_OBJ(X,Y,Z) \
   JP_FRAME_CHECK(); \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   X ret = Z; \
   JP_TRACE_JAVA(Y, ret); \
   check(); \
   return ret;
 #define JAVA_CHECK(Y,Z) \
+  JP_COUNT(JPCOUNT_JNI_CALL); \
   Z; \
   JP_TRACE_JAVA(Y, 0); \
   check();
@@ -582,6 +592,11 @@ jclass JPJavaFrame::GetObjectClass(jobject obj)
 			m_Env->GetObjectClass(obj));
 }
 
+bool JPJavaFrame::IsSameObject(jobject obj1, jobject obj2)
+{
+	return m_Env->IsSameObject(obj1, obj2) != 0;
+}
+
 jobject JPJavaFrame::GetStaticObjectField(jclass clazz, jfieldID fid)
 {
 	JAVA_RETURN_OBJ(jobject, "JPJavaFrame::GetStaticObjectField",
@@ -996,6 +1011,18 @@ jsize JPJavaFrame::GetStringUTFLength(jstring a0)
 			m_Env->GetStringUTFLength(a0));
 }
 
+jsize JPJavaFrame::GetStringLength(jstring a0)
+{
+	JAVA_RETURN(jsize, "JPJavaFrame::GetStringLength",
+			m_Env->GetStringLength(a0));
+}
+
+void JPJavaFrame::GetStringRegion(jstring a0, jsize a1, jsize a2, jchar* a3)
+{
+	JAVA_CHECK("JPJavaFrame::GetStringRegion",
+			m_Env->GetStringRegion(a0, a1, a2, a3));
+}
+
 jclass JPJavaFrame::DefineClass(const char* a0, jobject a1, const jbyte* a2, jsize a3)
 {
 	JAVA_RETURN(jclass, "JPJavaFrame::DefineClass",
@@ -1141,6 +1168,28 @@ jobject JPJavaFrame::assemble(jobject dims, jobject parts)
 			m_Context->m_Context_assembleID, v));
 }
 
+void JPJavaFrame::fillStrings(jobjectArray array, jintArray indices, jcharArray chars, jintArray ends)
+{
+	jvalue v[4];
+	v[0].l = (jobject) array;
+	v[1].l = (jobject) indices;
+	v[2].l = (jobject) chars;
+	v[3].l = (jobject) ends;
+	CallVoidMethodA(m_Context->getJavaContext(),
+			m_Context->m_Context_FillStringsID, v);
+}
+
+void JPJavaFrame::storeRange(jobjectArray src, jobjectArray dest, jint start, jint step)
+{
+	jvalue v[4];
+	v[0].l = (jobject) src;
+	v[1].l = (jobject) dest;
+	v[2].i = start;
+	v[3].i = step;
+	CallVoidMethodA(m_Context->getJavaContext(),
+			m_Context->m_Context_StoreRangeID, v);
+}
+
 jobject JPJavaFrame::newArrayInstance(jclass c, jintArray dims)
 {
 	jvalue v[2];
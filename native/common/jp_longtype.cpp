@@ -20,7 +20,7 @@
 #include "jp_longtype.h"
 
 JPLongType::JPLongType()
-: JPPrimitiveType("long")
+: JPPrimitiveTypeImpl("long")
 {
 }
 
@@ -29,6 +29,7 @@ JPLongType::~JPLongType()
 
 JPPyObject JPLongType::convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast)
 {
+	JP_COUNT(JPCOUNT_TO_PYTHON_PRIMITIVE);
 	JPPyObject tmp = JPPyObject::call(PyLong_FromLongLong(field(val)));
 	JPPyObject out = JPPyObject::call(convertLong(getHost(), (PyLongObject*) tmp.get()));
 	PyJPValue_assignJavaSlot(frame, out.get(), JPValue(this, val));
@@ -127,197 +128,7 @@ void JPLongType::getConversionInfo(JPConversionInfo &info)
 	PyList_Append(info.ret, (PyObject*) m_Context->_long->getHost());
 }
 
-jarray JPLongType::newArrayOf(JPJavaFrame& frame, jsize sz)
+jlong JPLongType::convertItem(PyObject* item)
 {
-	return frame.NewLongArray(sz);
-}
-
-JPPyObject JPLongType::getStaticField(JPJavaFrame& frame, jclass c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetStaticLongField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPLongType::getField(JPJavaFrame& frame, jobject c, jfieldID fid)
-{
-	jvalue v;
-	field(v) = frame.GetLongField(c, fid);
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPLongType::invokeStatic(JPJavaFrame& frame, jclass claz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		field(v) = frame.CallStaticLongMethodA(claz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-JPPyObject JPLongType::invoke(JPJavaFrame& frame, jobject obj, jclass clazz, jmethodID mth, jvalue* val)
-{
-	jvalue v;
-	{
-		JPPyCallRelease call;
-		if (clazz == nullptr)
-			field(v) = frame.CallLongMethodA(obj, mth, val);
-		else
-			field(v) = frame.CallNonvirtualLongMethodA(obj, clazz, mth, val);
-	}
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPLongType::setStaticField(JPJavaFrame& frame, jclass c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java int");
-	type_t val = field(match.convert());
-	frame.SetStaticLongField(c, fid, val);
-}
-
-void JPLongType::setField(JPJavaFrame& frame, jobject c, jfieldID fid, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java int");
-	type_t val = field(match.convert());
-	frame.SetLongField(c, fid, val);
-}
-
-void JPLongType::setArrayRange(JPJavaFrame& frame, jarray a,
-		jsize start, jsize length, jsize step,
-		PyObject* sequence)
-{
-	JP_TRACE_IN("JPLongType::setArrayRange");
-	JPPrimitiveArrayAccessor<array_t, type_t*> accessor(frame, a,
-			&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
-
-	type_t* val = accessor.get();
-	// First check if assigning sequence supports buffer API
-	if (PyObject_CheckBuffer(sequence))
-	{
-		JPPyBuffer buffer(sequence, PyBUF_FULL_RO);
-		if (buffer.valid())
-		{
-			Py_buffer& view = buffer.getView();
-			if (view.ndim != 1)
-				JP_RAISE(PyExc_TypeError, "buffer dims incorrect");
-			Py_ssize_t vshape = view.shape[0];
-			Py_ssize_t vstep = view.strides[0];
-			if (vshape != length)
-				JP_RAISE(PyExc_ValueError, "mismatched size");
-
-			char* memory = (char*) view.buf;
-			if (view.suboffsets && view.suboffsets[0] >= 0)
-				memory = *((char**) memory) + view.suboffsets[0];
-			jsize index = start;
-			jconverter conv = getConverter(view.format, (int) view.itemsize, "j");
-			for (Py_ssize_t i = 0; i < length; ++i, index += step)
-			{
-				jvalue r = conv(memory);
-				val[index] = r.j;
-				memory += vstep;
-			}
-			accessor.commit();
-			return;
-		} else
-		{
-			PyErr_Clear();
-		}
-	}
-
-	// Use sequence API
-	JPPySequence seq = JPPySequence::use(sequence);
-	jsize index = start;
-	for (Py_ssize_t i = 0; i < length; ++i, index += step)
-	{
-		PyObject *item = seq[i].get();
-		if (!PyIndex_Check(item))
-		{
-			PyErr_Format(PyExc_TypeError, "Unable to implicitly convert '%s' to long", Py_TYPE(item)->tp_name);
-			JP_RAISE_PYTHON();
-		}
-		jlong v = PyLong_AsLongLong(item);
-		if (v == -1)
-			JP_PY_CHECK()
-			val[index] = (type_t) v;
-	}
-	accessor.commit();
-	JP_TRACE_OUT;
-}
-
-JPPyObject JPLongType::getArrayItem(JPJavaFrame& frame, jarray a, jsize ndx)
-{
-	auto array = (array_t) a;
-	type_t val;
-	frame.GetLongArrayRegion(array, ndx, 1, &val);
-	jvalue v;
-	field(v) = val;
-	return convertToPythonObject(frame, v, false);
-}
-
-void JPLongType::setArrayItem(JPJavaFrame& frame, jarray a, jsize ndx, PyObject* obj)
-{
-	JPMatch match(&frame, obj);
-	if (findJavaConversion(match) < JPMatch::_implicit)
-		JP_RAISE(PyExc_TypeError, "Unable to convert to Java int");
-	type_t val = field(match.convert());
-	frame.SetLongArrayRegion((array_t) a, ndx, 1, &val);
-}
-
-void JPLongType::getView(JPArrayView& view)
-{
-	JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-	view.m_Memory = (void*) frame.GetLongArrayElements(
-			(jlongArray) view.m_Array->getJava(), &view.m_IsCopy);
-	view.m_Buffer.format = "=q";
-	view.m_Buffer.itemsize = sizeof (jlong);
-}
-
-void JPLongType::releaseView(JPArrayView& view)
-{
-	try
-	{
-		JPJavaFrame frame = JPJavaFrame::outer(view.getContext());
-		frame.ReleaseLongArrayElements((jlongArray) view.m_Array->getJava(),
-				(jlong*) view.m_Memory, view.m_Buffer.readonly ? JNI_ABORT : 0);
-	}	catch (JPypeException&)
-	{
-		// This is called as part of the cleanup routine and exceptions
-		// are not permitted
-	}
-}
-
-const char* JPLongType::getBufferFormat()
-{
-	return "=q";
-}
-
-Py_ssize_t JPLongType::getItemSize()
-{
-	return sizeof (jlong);
-}
-
-void JPLongType::copyElements(JPJavaFrame &frame, jarray a, jsize start, jsize len,
-		void* memory, int offset)
-{
-	auto* b = (jlong*) ((char*) memory + offset);
-	frame.GetLongArrayRegion((jlongArray) a, start, len, b);
-}
-
-static void pack(jlong* d, jvalue v)
-{
-	*d = v.j;
-}
-
-PyObject *JPLongType::newMultiArray(JPJavaFrame &frame, JPPyBuffer &buffer, int subs, int base, jobject dims)
-{
-	JP_TRACE_IN("JPLongType::newMultiArray");
-	return convertMultiArray<type_t>(
-			frame, this, &pack, "j",
-			buffer, subs, base, dims);
-	JP_TRACE_OUT;
+	return getIndexItem(item);
 }
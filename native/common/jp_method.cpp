@@ -17,6 +17,7 @@
 #include "jp_arrayclass.h"
 #include "jp_method.h"
 #include "pyjp.h"
+#include "jp_async.h"
 
 JPMethod::JPMethod(JPJavaFrame& frame,
 		JPClass* claz,
@@ -201,16 +202,22 @@ void JPMethod::packArgs(JPJavaFrame &frame, JPMethodMatch &match,
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
 
-JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance)
+JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg, bool instance, bool numpy)
 {
 	JP_TRACE_IN("JPMethod::invoke");
-	// Check if it is caller sensitive
-	if (isCallerSensitive())
-		return invokeCallerSensitive(match, arg, instance);
-
 	size_t alen = m_ParameterTypes.size();
 	JPClass* retType = m_ReturnType;
 
+	// Only one dimensional arrays of primitives can go directly to NumPy
+	JPPrimitiveType *component = nullptr;
+	if (numpy && retType->isArray())
+		component = dynamic_cast<JPPrimitiveType*>(
+			dynamic_cast<JPArrayClass*>(retType)->getComponentType());
+
+	// Check if it is caller sensitive
+	if (isCallerSensitive())
+		return invokeCallerSensitive(match, arg, instance, component);
+
 	// Pack the arguments
 	vector<jvalue> v(alen + 1);
 	packArgs(frame, match, v, arg);
@@ -220,6 +227,9 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 	{
 		JP_TRACE("invoke static", m_Name);
 		jclass claz = m_Class->getJavaClass();
+		JPCounterTimer timer(JPTIME_JAVA_CALL);
+		if (component != nullptr)
+			return invokeNumPy(frame, component, nullptr, claz, &v[0]);
 		return retType->invokeStatic(frame, claz, m_MethodID, &v[0]);
 	} else
 	{
@@ -244,26 +254,52 @@ JPPyObject JPMethod::invoke(JPJavaFrame& frame, JPMethodMatch& match, JPPyObject
 		{
 			JP_TRACE("invoke virtual", m_Name);
 		}
+		JPCounterTimer timer(JPTIME_JAVA_CALL);
+		if (component != nullptr)
+			return invokeNumPy(frame, component, c, clazz, &v[0]);
 		return retType->invoke(frame, c, clazz, m_MethodID, &v[0]);
 	}
 	JP_TRACE_OUT; // GCOVR_EXCL_LINE
 }
 
-JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg, bool instance)
+JPPyObject JPMethod::invokeNumPy(JPJavaFrame& frame, JPPrimitiveType *component,
+		jobject obj, jclass clazz, jvalue* val)
 {
-	JP_TRACE_IN("JPMethod::invokeCallerSensitive");
+	JP_TRACE_IN("JPMethod::invokeNumPy");
+	if (!isStatic() && obj == nullptr)
+		JP_RAISE(PyExc_ValueError, "method called on null object");
+	jobject out;
+	{
+		JPPyCallRelease call;
+		if (isStatic())
+			out = frame.CallStaticObjectMethodA(clazz, m_MethodID, val);
+		else if (clazz == nullptr)
+			out = frame.CallObjectMethodA(obj, m_MethodID, val);
+		else
+			out = frame.CallNonvirtualObjectMethodA(obj, clazz, m_MethodID, val);
+	}
+	if (out == nullptr)
+		return JPPyObject::getNone();
+
+	// Copy straight into NumPy without creating a Java array wrapper
+	JPPyObject result = component->newNumPy(frame, (jarray) out);
+	frame.DeleteLocalRef(out);
+	return result;
+	JP_TRACE_OUT;
+}
+
+jobjectArray JPMethod::packObjectArgs(JPJavaFrame &frame, JPMethodMatch &match,
+		JPPyObjectVector &arg, jobject &self)
+{
+	JP_TRACE_IN("JPMethod::packObjectArgs");
 	JPContext *context = m_Class->getContext();
 	size_t alen = m_ParameterTypes.size();
-	JPJavaFrame frame = JPJavaFrame::outer(context, (int) (8 + alen));
-	JPClass* retType = m_ReturnType;
 
 	// Pack the arguments
 	vector<jvalue> v(alen + 1);
 	packArgs(frame, match, v, arg);
 
-	//Proxy the call to
-	//   public static Object callMethod(Method method, Object obj, Object[] args)
-	jobject self = nullptr;
+	self = nullptr;
 	size_t len = alen;
 	if (!isStatic())
 	{
@@ -294,6 +330,23 @@ JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVecto
 			frame.SetObjectArrayElement(ja, i, v[i].l);
 		}
 	}
+	return ja;
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVector& arg,
+		bool instance, JPPrimitiveType *component)
+{
+	JP_TRACE_IN("JPMethod::invokeCallerSensitive");
+	JPContext *context = m_Class->getContext();
+	size_t alen = m_ParameterTypes.size();
+	JPJavaFrame frame = JPJavaFrame::outer(context, (int) (8 + alen));
+	JPClass* retType = m_ReturnType;
+
+	//Proxy the call to
+	//   public static Object callMethod(Method method, Object obj, Object[] args)
+	jobject self;
+	jobjectArray ja = packObjectArgs(frame, match, arg, self);
 
 	// Call the method
 	jobject o;
@@ -312,6 +365,12 @@ JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVecto
 		JPClass *boxed = (dynamic_cast<JPPrimitiveType*>( retType))->getBoxedClass(context);
 		JPValue out = retType->getValueFromObject(JPValue(boxed, o));
 		return retType->convertToPythonObject(frame, out.getValue(), false);
+	} else if (component != nullptr)
+	{
+		JP_TRACE("Return NumPy");
+		if (o == nullptr)
+			return JPPyObject::getNone();
+		return component->newNumPy(frame, (jarray) o);
 	} else
 	{
 		JP_TRACE("Return object");
@@ -322,6 +381,36 @@ JPPyObject JPMethod::invokeCallerSensitive(JPMethodMatch& match, JPPyObjectVecto
 	JP_TRACE_OUT;
 }
 
+JPPyObject JPMethod::invokeAsync(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg,
+		PyObject *future, jobject executor)
+{
+	JP_TRACE_IN("JPMethod::invokeAsync");
+	JPContext *context = m_Class->getContext();
+	if (isConstructor())
+		JP_RAISE(PyExc_TypeError, "Constructors can not be called asynchronously");
+
+	// Arguments are converted now as they may refer to Python objects
+	jobject self;
+	jobjectArray ja = packObjectArgs(frame, match, arg, self);
+
+	jlong token = context->m_Async->newToken(future, m_ReturnType);
+	jobject out;
+	try
+	{
+		JPPyCallRelease call;
+		out = context->m_Async->call(frame, token, m_Method.get(), self, ja, executor);
+	} catch (...)
+	{
+		// The call was never submitted so the token will not come back
+		context->m_Async->releaseToken(token);
+		throw;
+	}
+	jvalue v;
+	v.l = out;
+	return context->_java_lang_Object->convertToPythonObject(frame, v, false);
+	JP_TRACE_OUT;
+}
+
 JPValue JPMethod::invokeConstructor(JPJavaFrame& frame, JPMethodMatch& match, JPPyObjectVector& arg)
 {
 	JP_TRACE_IN("JPMethod::invokeConstructor");
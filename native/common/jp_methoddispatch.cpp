@@ -60,11 +60,15 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 
 		// Anything better than explicit constitutes a hit on the cache
 		if (bestMatch.m_Type > JPMatch::_explicit)
+		{
+			JP_COUNT(JPCOUNT_DISPATCH_HIT);
+			bestMatch.m_Cached = true;
 			return true;
-		else
+		} else
 			// bad match so forget the overload.
 			bestMatch.m_Overload = nullptr;
 	}
+	JP_COUNT(JPCOUNT_DISPATCH_MISS);
 
 	// We need two copies of the match.  One to hold the best match we have
 	// found, and one to hold the test of the next overload.
@@ -209,20 +213,48 @@ bool JPMethodDispatch::findOverload(JPJavaFrame& frame, JPMethodMatch &bestMatch
 	JP_TRACE_OUT;
 }
 
-JPPyObject JPMethodDispatch::invoke(JPJavaFrame& frame, JPPyObjectVector& args, bool instance)
+JPMethodProfile* JPMethodDispatch::getProfile()
+{
+	if (!JPProfiler::isEnabled())
+		return nullptr;
+	JPMethodProfile *profile = m_Profile.load(std::memory_order_relaxed);
+	if (profile == nullptr)
+	{
+		// Records are unique by name so a race stores the same one
+		profile = JPProfiler::getProfile(m_Class->getCanonicalName(), m_Name);
+		m_Profile.store(profile, std::memory_order_relaxed);
+	}
+	return profile;
+}
+
+JPPyObject JPMethodDispatch::invoke(JPJavaFrame& frame, JPPyObjectVector& args, bool instance, bool numpy)
 {
 	JP_TRACE_IN("JPMethodDispatch::invoke");
+	JPProfileSample sample(getProfile());
+	JPMethodMatch match(frame, args, instance);
+	findOverload(frame, match, args, instance, true);
+	sample.matched(match.m_Cached);
+	return match.m_Overload->invoke(frame, match, args, instance, numpy || m_NumPyReturn);
+	JP_TRACE_OUT;
+}
+
+JPPyObject JPMethodDispatch::invokeAsync(JPJavaFrame& frame, JPPyObjectVector& args, bool instance,
+		PyObject *future, jobject executor)
+{
+	JP_TRACE_IN("JPMethodDispatch::invokeAsync");
 	JPMethodMatch match(frame, args, instance);
 	findOverload(frame, match, args, instance, true);
-	return match.m_Overload->invoke(frame, match, args, instance);
+	return match.m_Overload->invokeAsync(frame, match, args, future, executor);
 	JP_TRACE_OUT;
 }
 
 JPValue JPMethodDispatch::invokeConstructor(JPJavaFrame& frame, JPPyObjectVector& args)
 {
 	JP_TRACE_IN("JPMethodDispatch::invokeConstructor");
+	JPProfileSample sample(getProfile());
 	JPMethodMatch match(frame, args, false);
 	findOverload(frame, match, args, false, true);
+	sample.matched(match.m_Cached);
 	return match.m_Overload->invokeConstructor(frame, match, args);
 	JP_TRACE_OUT;
 }
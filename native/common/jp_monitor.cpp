@@ -16,7 +16,13 @@
 #include "jpype.h"
 #include "jp_monitor.h"
 
-JPMonitor::JPMonitor(JPContext* context, jobject value) : m_Value(context, value)
+namespace
+{
+// Objects whose monitors this thread entered from Python, innermost last
+thread_local std::vector<jobject> jp_monitors_held;
+}
+
+JPMonitor::JPMonitor(JPContext* context, jobject value) : m_Value(value)
 {
 	m_Context = context;
 }
@@ -24,18 +30,44 @@ JPMonitor::JPMonitor(JPContext* context, jobject value) : m_Value(context, value
 JPMonitor::~JPMonitor()
 = default;
 
-void JPMonitor::enter()
+bool JPMonitor::isHeld(JPJavaFrame& frame)
 {
-	// This can hold off for a while so we need to release resource
-	// so that we don't dead lock.
-	JPPyCallRelease call;
-	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-	frame.MonitorEnter(m_Value.get());
+	for (auto iter = jp_monitors_held.rbegin(); iter != jp_monitors_held.rend(); ++iter)
+	{
+		if (*iter == m_Value || frame.IsSameObject(*iter, m_Value))
+			return true;
+	}
+	return false;
 }
 
-void JPMonitor::exit()
+void JPMonitor::enter(JPJavaFrame& frame)
 {
-	JPJavaFrame frame = JPJavaFrame::outer(m_Context);
-	frame.MonitorExit(m_Value.get());
+	// Entering a monitor this thread already holds can't block, so there
+	// is no need to give up the GIL.
+	if (isHeld(frame))
+	{
+		frame.MonitorEnter(m_Value);
+	} else
+	{
+		// This can hold off for a while so we need to release resource
+		// so that we don't dead lock.
+		JPPyCallRelease call;
+		frame.MonitorEnter(m_Value);
+	}
+	jp_monitors_held.push_back(m_Value);
+	m_Entered++;
 }
 
+void JPMonitor::exit(JPJavaFrame& frame)
+{
+	frame.MonitorExit(m_Value);
+	m_Entered--;
+	for (auto iter = jp_monitors_held.rbegin(); iter != jp_monitors_held.rend(); ++iter)
+	{
+		if (*iter == m_Value)
+		{
+			jp_monitors_held.erase(std::next(iter).base());
+			break;
+		}
+	}
+}
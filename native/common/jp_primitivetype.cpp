@@ -28,8 +28,6 @@ bool JPPrimitiveType::isPrimitive() const
 	return true;
 }
 
-extern "C" Py_ssize_t PyJPValue_getJavaSlotOffset(PyObject* self);
-
 // equivalent of long_subtype_new as it isn't exposed
 
 PyObject *JPPrimitiveType::convertLong(PyTypeObject* wrapper, PyLongObject* tmp)
@@ -70,3 +68,17 @@ PyObject *JPPrimitiveType::convertLong(PyTypeObject* wrapper, PyLongObject* tmp)
 	return (PyObject*) newobj;
 }
 
+
+JPPyObject JPPrimitiveType::newNumPyArray(jsize length, const char* dtype)
+{
+	JP_TRACE_IN("JPPrimitiveType::newNumPyArray");
+	// NumPy is optional so it is found on first use rather than at startup
+	static PyObject *empty = nullptr;
+	if (empty == nullptr)
+	{
+		JPPyObject numpy = JPPyObject::call(PyImport_ImportModule("numpy"));
+		empty = JPPyObject::call(PyObject_GetAttrString(numpy.get(), "empty")).keep();
+	}
+	return JPPyObject::call(PyObject_CallFunction(empty, "ns", (Py_ssize_t) length, dtype));
+	JP_TRACE_OUT;
+}
@@ -0,0 +1,161 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+
+std::atomic<bool> JPProfiler::s_Enabled{false};
+std::atomic<uint64_t> JPProfiler::s_Interval{10};
+
+namespace
+{
+
+std::mutex s_Lock;
+// Never freed as dispatches hold pointers to the records
+std::list<JPMethodProfile> *s_Profiles = new std::list<JPMethodProfile>();
+std::map<std::pair<string, string>, JPMethodProfile*> *s_Index
+		= new std::map<std::pair<string, string>, JPMethodProfile*>();
+
+thread_local JPProfileSample* jp_profile_current = nullptr;
+
+inline int64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void bump(std::atomic<uint64_t>& v, int64_t n)
+{
+	v.fetch_add((uint64_t) n, std::memory_order_relaxed);
+}
+
+}
+
+void JPProfiler::setEnabled(bool enabled, uint64_t interval)
+{
+	s_Interval = interval;
+	s_Enabled = enabled;
+}
+
+JPMethodProfile* JPProfiler::getProfile(const string& cls, const string& name)
+{
+	std::lock_guard<std::mutex> guard(s_Lock);
+	auto key = std::make_pair(cls, name);
+	auto iter = s_Index->find(key);
+	if (iter != s_Index->end())
+		return iter->second;
+	s_Profiles->emplace_back(cls, name);
+	JPMethodProfile *profile = &s_Profiles->back();
+	(*s_Index)[key] = profile;
+	return profile;
+}
+
+std::vector<JPMethodProfile*> JPProfiler::getProfiles()
+{
+	std::lock_guard<std::mutex> guard(s_Lock);
+	std::vector<JPMethodProfile*> out;
+	for (JPMethodProfile& profile : *s_Profiles)
+	{
+		if (profile.m_Calls.load(std::memory_order_relaxed) != 0)
+			out.push_back(&profile);
+	}
+	return out;
+}
+
+void JPProfiler::reset(JPMethodProfile& profile)
+{
+	profile.m_Calls = 0;
+	profile.m_CacheHits = 0;
+	profile.m_Sampled = 0;
+	profile.m_MatchTime = 0;
+	profile.m_ConvertTime = 0;
+	profile.m_JavaTime = 0;
+	profile.m_ReturnTime = 0;
+}
+
+JPProfileSample::JPProfileSample(JPMethodProfile* profile)
+: m_Profile(profile), m_Previous(nullptr), m_Timed(false), m_Depth(0),
+m_Start(0), m_Matched(0), m_Released(0), m_Mark(0), m_Java(0)
+{
+	if (profile == nullptr)
+		return;
+	uint64_t calls = profile->m_Calls.fetch_add(1, std::memory_order_relaxed);
+	uint64_t interval = JPProfiler::getInterval();
+	if (interval > 1 && calls % interval != 0)
+		return;
+	m_Timed = true;
+	m_Previous = jp_profile_current;
+	jp_profile_current = this;
+	m_Start = now();
+}
+
+JPProfileSample::~JPProfileSample()
+{
+	if (!m_Timed)
+		return;
+	int64_t end = now();
+	jp_profile_current = m_Previous;
+	bump(m_Profile->m_Sampled, 1);
+	if (m_Matched == 0)
+	{
+		// The match failed
+		bump(m_Profile->m_MatchTime, end - m_Start);
+		return;
+	}
+	bump(m_Profile->m_MatchTime, m_Matched - m_Start);
+	if (m_Released == 0 || m_Depth != 0)
+	{
+		// Failed before Java was called
+		bump(m_Profile->m_ConvertTime, end - m_Matched);
+		return;
+	}
+	bump(m_Profile->m_ConvertTime, m_Released - m_Matched);
+	bump(m_Profile->m_JavaTime, m_Java);
+	bump(m_Profile->m_ReturnTime, end - m_Mark);
+}
+
+void JPProfileSample::matched(bool cached)
+{
+	if (m_Profile == nullptr)
+		return;
+	if (cached)
+		bump(m_Profile->m_CacheHits, 1);
+	if (m_Timed)
+		m_Matched = now();
+}
+
+void JPProfileSample::released()
+{
+	JPProfileSample *sample = jp_profile_current;
+	if (sample == nullptr || sample->m_Depth++ != 0)
+		return;
+	int64_t t = now();
+	if (sample->m_Released == 0)
+		sample->m_Released = t;
+	sample->m_Mark = t;
+}
+
+void JPProfileSample::acquired()
+{
+	JPProfileSample *sample = jp_profile_current;
+	if (sample == nullptr || sample->m_Depth == 0 || --sample->m_Depth != 0)
+		return;
+	int64_t t = now();
+	sample->m_Java += t - sample->m_Mark;
+	sample->m_Mark = t;
+}
@@ -21,6 +21,7 @@
 #include "jp_primitive_accessor.h"
 #include "jp_boxedtype.h"
 #include "jp_functional.h"
+#include "jp_async.h"
 
 JPPyObject getArgs(JPContext* context, jlongArray parameterTypePtrs,
 		jobjectArray args)
@@ -46,6 +47,70 @@ JPPyObject getArgs(JPContext* context, jlongArray parameterTypePtrs,
 	JP_TRACE_OUT;
 }
 
+jobject JPProxy::invoke(JPJavaFrame& frame, jstring name, JPClass* returnClass,
+		jlongArray parameterTypePtrs, jobjectArray args, jobject missing)
+{
+	JP_TRACE_IN("JPProxy::invoke");
+	JPContext *context = m_Context;
+	string cname = frame.toStringUTF8(name);
+	JP_TRACE("Get callable for", cname);
+
+	// Get the callable object
+	JPPyObject callable(getCallable(cname));
+
+	// If method can't be called, throw an exception
+	if (callable.isNull() || callable.get() == Py_None)
+		return missing;
+
+	// Find the return type
+	JP_TRACE("Get return type", returnClass->getCanonicalName());
+
+	// convert the arguments into a python list
+	JP_TRACE("Convert arguments");
+	JPPyObject pyargs = getArgs(context, parameterTypePtrs, args);
+
+	JP_TRACE("Call Python");
+	JPPyObject returnValue = JPPyObject::call(PyObject_Call(callable.get(), pyargs.get(), nullptr));
+
+	JP_TRACE("Handle return", Py_TYPE(returnValue.get())->tp_name);
+	if (returnClass == context->_void)
+	{
+		JP_TRACE("Void return");
+		return nullptr;
+	}
+
+	// This is a SystemError where the caller return null without
+	// setting a Python error.
+	if (returnValue.isNull())
+	{
+		JP_TRACE("Null return");
+		JP_RAISE(PyExc_TypeError, "Return value is null when it cannot be");
+	}
+
+	// We must box here.
+	JPMatch returnMatch(&frame, returnValue.get());
+	if (returnClass->isPrimitive())
+	{
+		JP_TRACE("Box return");
+		if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
+			JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
+		jvalue res = returnMatch.convert();
+		auto *boxed =  dynamic_cast<JPBoxedType *>( (dynamic_cast<JPPrimitiveType*>( returnClass))->getBoxedClass(context));
+		return boxed->box(frame, res);
+	}
+
+	if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
+	{
+		JP_TRACE("Cannot convert");
+		JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
+	}
+
+	JP_TRACE("Convert return to", returnClass->getCanonicalName());
+	jvalue res = returnMatch.convert();
+	return res.l;
+	JP_TRACE_OUT;
+}
+
 extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 		JNIEnv *env, jclass clazz,
 		jlong contextPtr, jstring name,
@@ -56,6 +121,19 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 		jobject missing)
 {
 	auto* context = (JPContext*) contextPtr;
+
+	// Threads that Python has never seen hand queued calls to a Python
+	// thread rather than contending for the GIL.  If no consumer is running
+	// the call is made here instead.
+	if (hostObj != 0 && ((JPProxy*) hostObj)->isQueued()
+			&& PyGILState_GetThisThreadState() == nullptr)
+	{
+		jobject out;
+		if (context->m_Async->queueCallback(env, name, hostObj, returnTypePtr,
+				parameterTypePtrs, args, missing, out))
+			return out;
+	}
+
 	JPJavaFrame frame = JPJavaFrame::external(context, env);
 
 	// We need the resources to be held for the full duration of the proxy.
@@ -77,65 +155,11 @@ extern "C" JNIEXPORT jobject JNICALL Java_org_jpype_proxy_JPypeProxy_hostInvoke(
 			}
 			// GCOVR_EXCL_STOP
 
-			string cname = frame.toStringUTF8(name);
-			JP_TRACE("Get callable for", cname);
-
-			// Get the callable object
-			JPPyObject callable(((JPProxy*) hostObj)->getCallable(cname));
-
-			// If method can't be called, throw an exception
-			if (callable.isNull() || callable.get() == Py_None)
-                return missing;
-
-			// Find the return type
-			auto* returnClass = (JPClass*) returnTypePtr;
-			JP_TRACE("Get return type", returnClass->getCanonicalName());
-
-			// convert the arguments into a python list
-			JP_TRACE("Convert arguments");
-			JPPyObject pyargs = getArgs(context, parameterTypePtrs, args);
-
-			JP_TRACE("Call Python");
-			JPPyObject returnValue = JPPyObject::call(PyObject_Call(callable.get(), pyargs.get(), nullptr));
-
-			JP_TRACE("Handle return", Py_TYPE(returnValue.get())->tp_name);
-			if (returnClass == context->_void)
-			{
-				JP_TRACE("Void return");
-				return nullptr;
-			}
-
-			// This is a SystemError where the caller return null without
-			// setting a Python error.
-			if (returnValue.isNull())
-			{
-				JP_TRACE("Null return");
-				JP_RAISE(PyExc_TypeError, "Return value is null when it cannot be");
-			}
-
-			// We must box here.
-			JPMatch returnMatch(&frame, returnValue.get());
-			if (returnClass->isPrimitive())
-			{
-				JP_TRACE("Box return");
-				if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
-					JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
-				jvalue res = returnMatch.convert();
-				auto *boxed =  dynamic_cast<JPBoxedType *>( (dynamic_cast<JPPrimitiveType*>( returnClass))->getBoxedClass(context));
-				jvalue res2;
-				res2.l = boxed->box(frame, res);
-				return frame.keep(res2.l);
-			}
-
-			if (returnClass->findJavaConversion(returnMatch) == JPMatch::_none)
-			{
-				JP_TRACE("Cannot convert");
-				JP_RAISE(PyExc_TypeError, "Return value is not compatible with required type.");
-			}
-
-			JP_TRACE("Convert return to", returnClass->getCanonicalName());
-			jvalue res = returnMatch.convert();
-			return frame.keep(res.l);
+			jobject out = ((JPProxy*) hostObj)->invoke(frame, name,
+					(JPClass*) returnTypePtr, parameterTypePtrs, args, missing);
+			if (out == missing || out == nullptr)
+				return out;
+			return frame.keep(out);
 		} catch (JPypeException& ex)
 		{
 			JP_TRACE("JPypeException raised");
@@ -25,11 +25,73 @@ JPStringType::JPStringType(JPJavaFrame& frame,
 		jint modifiers)
 : JPClass(frame, clss, name, super, interfaces, modifiers)
 {
+	m_Immutable = true;
 }
 
 JPStringType::~JPStringType()
 = default;
 
+void JPStringType::setCache(size_t size, jsize maxLength)
+{
+	for (CacheEntry &entry : m_Cache)
+		Py_XDECREF(entry.str);
+	m_Cache.clear();
+
+	// Round up to a power of two so the slot is a mask of the hash
+	size_t n = 0;
+	if (size > 0)
+		for (n = 1; n < size; n <<= 1);
+	m_Cache.resize(n, {0, nullptr});
+	m_CacheMaxLength = maxLength;
+	m_CacheHits = 0;
+	m_CacheMisses = 0;
+}
+
+JPPyObject JPStringType::convertCached(JPJavaFrame& frame, jstring jstr)
+{
+	jsize length = frame.GetStringLength(jstr);
+	if (length > m_CacheMaxLength)
+	{
+		string str = frame.toStringUTF8(jstr);
+		return JPPyObject::call(PyUnicode_FromStringAndSize(str.c_str(), str.length()));
+	}
+
+	jchar buffer[256];
+	std::vector<jchar> large;
+	jchar *chars = buffer;
+	if (length > 256)
+	{
+		large.resize(length);
+		chars = large.data();
+	}
+	frame.GetStringRegion(jstr, 0, length, chars);
+
+	// FNV-1a over the code units
+	size_t hash = 2166136261u;
+	for (jsize i = 0; i < length; ++i)
+		hash = (hash ^ chars[i]) * 16777619u;
+
+	CacheEntry &entry = m_Cache[hash & (m_Cache.size() - 1)];
+	if (entry.str != nullptr && entry.hash == hash
+			&& PyJPString_equalsUTF16(entry.str, chars, length))
+	{
+		m_CacheHits++;
+		return JPPyObject::use(entry.str);
+	}
+
+	m_CacheMisses++;
+	int byteorder = PY_LITTLE_ENDIAN ? -1 : 1;
+	PyObject *str = PyUnicode_DecodeUTF16((const char*) chars,
+			2 * (Py_ssize_t) length, "surrogatepass", &byteorder);
+	if (str == nullptr)
+		JP_RAISE_PYTHON();
+	PyUnicode_InternInPlace(&str);
+	Py_XDECREF(entry.str);
+	entry.hash = hash;
+	entry.str = str;
+	return JPPyObject::use(str);
+}
+
 JPPyObject JPStringType::convertToPythonObject(JPJavaFrame& frame, jvalue val, bool cast)
 {
 	JP_TRACE_IN("JPStringType::asHostObject");
@@ -45,6 +107,9 @@ JPPyObject JPStringType::convertToPythonObject(JPJavaFrame& frame, jvalue val, b
 
 		if (context->getConvertStrings())
 		{
+			JP_COUNT(JPCOUNT_TO_PYTHON_STRING);
+			if (!m_Cache.empty())
+				return convertCached(frame, (jstring) val.l);
 			string str = frame.toStringUTF8((jstring) (val.l));
 			return JPPyObject::call(PyUnicode_FromStringAndSize(str.c_str(), str.length()));
 		}
@@ -358,6 +358,169 @@ JNIEXPORT jlong JNICALL Java_org_jpype_manager_TypeFactoryNative_definePrimitive
 	JP_JAVA_CATCH(0);  // GCOVR_EXCL_LINE
 }
 
+// Record kinds used by org.jpype.manager.MemberBatch
+enum
+{
+	MEMBER_FIELD = 1,
+	MEMBER_METHOD = 2,
+	MEMBER_DISPATCH = 3,
+	MEMBER_ASSIGN = 4
+};
+
+/**
+ * Decode a batch of member definitions for a class.
+ *
+ * This creates every field, method and dispatch for a class in a single
+ * call from Java.  See MemberBatch for the record layout.  Negative
+ * references are the complement of an entry index within the batch.
+ */
+JNIEXPORT jlongArray JNICALL Java_org_jpype_manager_TypeFactoryNative_defineMembers(
+		JNIEnv *env, jobject self, jlong contextPtr,
+		jlong clsPtr,
+		jobjectArray objects,
+		jlongArray data)
+{
+	auto* context = (JPContext*) contextPtr;
+	JPJavaFrame frame = JPJavaFrame::external(context, env);
+	JP_JAVA_TRY("JPTypeFactory_defineMembers");
+	auto* cls = (JPClass*) clsPtr;
+	JPPrimitiveArrayAccessor<jlongArray, jlong*> accessor(frame, data,
+			&JPJavaFrame::GetLongArrayElements, &JPJavaFrame::ReleaseLongArrayElements);
+	jlong* values = accessor.get();
+	jsize sz = frame.GetArrayLength(data);
+	vector<jlong> created;
+	vector<int> kinds;
+	bool assigned = false;
+
+	jsize i = 0;
+	auto next = [&]() -> jlong
+	{
+		if (i >= sz)
+			JP_RAISE(PyExc_RuntimeError, "member batch truncated");
+		return values[i++];
+	};
+	auto ref = [&]() -> jlong
+	{
+		jlong v = next();
+		if (v >= 0)
+			return v;
+		size_t j = (size_t) ~v;
+		if (j >= created.size())
+			JP_RAISE(PyExc_RuntimeError, "member batch reference invalid");
+		return created[j];
+	};
+	auto name = [&]() -> string
+	{
+		auto jname = (jstring) frame.GetObjectArrayElement(objects, (jsize) next());
+		string out = frame.toStringUTF8(jname);
+		frame.DeleteLocalRef(jname);
+		return out;
+	};
+	auto refs = [&](vector<jlong>& out)
+	{
+		jlong n = next();
+		out.resize((size_t) n);
+		for (jlong j = 0; j < n; ++j)
+			out[(size_t) j] = ref();
+	};
+
+	try
+	{
+		vector<jlong> list;
+		while (i < sz)
+		{
+			switch ((int) next())
+			{
+				case MEMBER_FIELD:
+				{
+					string cname = name();
+					jobject field = frame.GetObjectArrayElement(objects, (jsize) next());
+					auto* fieldType = (JPClass*) next();
+					auto modifiers = (jint) next();
+					JP_TRACE(cname);
+					jfieldID fid = frame.FromReflectedField(field);
+					kinds.push_back(MEMBER_FIELD);
+					created.push_back((jlong) new JPField(frame, cls, cname,
+							field, fid, fieldType, modifiers));
+					frame.DeleteLocalRef(field);
+					break;
+				}
+				case MEMBER_METHOD:
+				{
+					string cname = name();
+					jobject method = frame.GetObjectArrayElement(objects, (jsize) next());
+					auto modifiers = (jint) next();
+					refs(list);
+					JPMethodList cover;
+					for (jlong v : list)
+						cover.push_back((JPMethod*) v);
+					JP_TRACE(cname);
+					jmethodID mid = frame.FromReflectedMethod(method);
+					kinds.push_back(MEMBER_METHOD);
+					created.push_back((jlong) new JPMethod(frame, cls, cname,
+							method, mid, cover, modifiers));
+					frame.DeleteLocalRef(method);
+					break;
+				}
+				case MEMBER_DISPATCH:
+				{
+					string cname = name();
+					auto modifiers = (jint) next();
+					refs(list);
+					JPMethodList overloadList;
+					for (jlong v : list)
+						overloadList.push_back((JPMethod*) v);
+					JP_TRACE(cname);
+					kinds.push_back(MEMBER_DISPATCH);
+					created.push_back((jlong) new JPMethodDispatch(cls, cname,
+							overloadList, modifiers));
+					break;
+				}
+				case MEMBER_ASSIGN:
+				{
+					auto* ctor = (JPMethodDispatch*) ref();
+					refs(list);
+					JPMethodDispatchList methodList;
+					for (jlong v : list)
+						methodList.push_back((JPMethodDispatch*) v);
+					refs(list);
+					JPFieldList fieldList;
+					for (jlong v : list)
+						fieldList.push_back((JPField*) v);
+					cls->assignMembers(ctor, methodList, fieldList);
+					assigned = true;
+					break;
+				}
+				default:
+					JP_RAISE(PyExc_RuntimeError, "member batch record invalid");
+			}
+		}
+
+		jlongArray out = frame.NewLongArray((jsize) created.size());
+		if (!created.empty())
+			frame.SetLongArrayRegion(out, 0, (jsize) created.size(), created.data());
+		return out;
+	} catch (...)
+	{
+		// Java never receives the pointers, so release them here.
+		if (assigned)
+		{
+			JPMethodDispatchList methodList;
+			JPFieldList fieldList;
+			cls->assignMembers(nullptr, methodList, fieldList);
+		}
+		for (size_t j = 0; j < created.size(); ++j)
+		{
+			if (kinds[j] == MEMBER_FIELD)
+				delete (JPField*) created[j];
+			else
+				delete (JPResource*) created[j];
+		}
+		throw;
+	}
+	JP_JAVA_CATCH(nullptr);  // GCOVR_EXCL_LINE
+}
+
 JNIEXPORT void JNICALL Java_org_jpype_manager_TypeFactoryNative_assignMembers(
 		JNIEnv *env, jobject self,
 		jlong contextPtr,
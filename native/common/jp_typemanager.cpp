@@ -25,6 +25,7 @@ JPTypeManager::JPTypeManager(JPJavaFrame& frame)
 	m_FindClass = frame.GetMethodID(cls, "findClass", "(Ljava/lang/Class;)J");
 	m_FindClassByName = frame.GetMethodID(cls, "findClassByName", "(Ljava/lang/String;)J");
 	m_FindClassForObject = frame.GetMethodID(cls, "findClassForObject", "(Ljava/lang/Object;)J");
+	m_FindClassesForArray = frame.GetMethodID(cls, "findClassesForArray", "([Ljava/lang/Object;III[Ljava/lang/Object;)[J");
 	m_PopulateMethod = frame.GetMethodID(cls, "populateMethod", "(JLjava/lang/reflect/Executable;)V");
 	m_PopulateMembers = frame.GetMethodID(cls, "populateMembers", "(Ljava/lang/Class;)V");
     m_InterfaceParameterCount = frame.GetMethodID(cls, "interfaceParameterCount", "(Ljava/lang/Class;)I");
@@ -73,6 +74,28 @@ JPClass* JPTypeManager::findClassForObject(jobject obj)
 	JP_TRACE_OUT;
 }
 
+jobjectArray JPTypeManager::findClassesForArray(JPJavaFrame& frame, jobjectArray array,
+		jsize start, jsize length, jsize step, std::vector<JPClass*>& out)
+{
+	JP_TRACE_IN("JPTypeManager::findClassesForArray");
+	auto snapshot = (jobjectArray) m_Context->_java_lang_Object->newArrayOf(frame, length);
+	jvalue val[5];
+	val[0].l = array;
+	val[1].i = start;
+	val[2].i = length;
+	val[3].i = step;
+	val[4].l = snapshot;
+	auto ptrs = (jlongArray) frame.CallObjectMethodA(m_JavaTypeManager.get(), m_FindClassesForArray, val);
+	std::vector<jlong> values(length);
+	frame.GetLongArrayRegion(ptrs, 0, length, values.data());
+	frame.DeleteLocalRef(ptrs);
+	out.resize(length);
+	for (jsize i = 0; i < length; ++i)
+		out[i] = (JPClass*) values[i];
+	return snapshot;
+	JP_TRACE_OUT;
+}
+
 void JPTypeManager::populateMethod(void* method, jobject obj)
 {
 	JP_TRACE_IN("JPTypeManager::populateMethod");
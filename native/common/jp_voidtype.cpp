@@ -154,3 +154,8 @@ PyObject *JPVoidType::newMultiArray(JPJavaFrame &frame,
 }
 
 // GCOVR_EXCL_STOP
+
+JPPyObject JPVoidType::newNumPy(JPJavaFrame &frame, jarray a)
+{
+	return {};
+}
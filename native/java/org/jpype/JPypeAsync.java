@@ -0,0 +1,112 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype;
+
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.CompletionStage;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Java side of asynchronous calls from Python.
+ * <p>
+ * Calls are run on an executor so that the Python thread never waits on
+ * Java. Each completion is handed to native code with a token naming the
+ * Python future. The native side queues it without taking the GIL and wakes
+ * the Python event loop once per batch.
+ * <p>
+ * The shared pool uses daemon threads so that outstanding calls do not hold
+ * up the shutdown of the JVM.
+ *
+ * @author nelson85
+ */
+public class JPypeAsync
+{
+
+  private static final AtomicInteger count = new AtomicInteger();
+  private static ExecutorService executor;
+
+  static synchronized Executor getExecutor()
+  {
+    if (executor == null)
+    {
+      executor = Executors.newCachedThreadPool((Runnable r) ->
+      {
+        Thread t = new Thread(r, "JPype Async-" + count.incrementAndGet());
+        t.setDaemon(true);
+        return t;
+      });
+    }
+    return executor;
+  }
+
+  /**
+   * Invoke a method on an executor.
+   *
+   * @param context is the C++ context.
+   * @param token identifies the Python future to complete.
+   * @param method is the method to call.
+   * @param obj is the object to operate on, or null if the method is static.
+   * @param args are the arguments to the method.
+   * @param exec is the executor to use, or null for the shared pool.
+   * @return the future for the call.
+   */
+  public static CompletableFuture<Object> call(long context, long token,
+          Method method, Object obj, Object[] args, Executor exec)
+  {
+    if (exec == null)
+      exec = getExecutor();
+    CompletableFuture<Object> future = CompletableFuture.supplyAsync(() ->
+    {
+      try
+      {
+        return method.invoke(obj, args);
+      } catch (InvocationTargetException ex)
+      {
+        throw new CompletionException(ex.getCause());
+      } catch (IllegalAccessException ex)
+      {
+        throw new CompletionException(ex);
+      }
+    }, exec);
+    watch(context, token, future);
+    return future;
+  }
+
+  /**
+   * Report the completion of a stage to Python.
+   *
+   * @param context is the C++ context.
+   * @param token identifies the Python future to complete.
+   * @param stage is the stage to watch.
+   */
+  public static void watch(long context, long token, CompletionStage<?> stage)
+  {
+    stage.whenComplete((value, ex) ->
+    {
+      if (ex instanceof CompletionException && ex.getCause() != null)
+        ex = ex.getCause();
+      complete(context, token, value, ex);
+    });
+  }
+
+  private static native void complete(long context, long token, Object value, Throwable ex);
+}
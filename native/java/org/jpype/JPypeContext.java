@@ -15,7 +15,6 @@
 **************************************************************************** */
 package org.jpype;
 
-import java.io.File;
 import java.lang.reflect.Array;
 import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
@@ -24,7 +23,6 @@ import java.nio.Buffer;
 import java.nio.ByteOrder;
 import java.nio.file.Files;
 import java.nio.file.Path;
-import java.nio.file.Paths;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
@@ -35,6 +33,7 @@ import org.jpype.manager.TypeFactory;
 import org.jpype.manager.TypeFactoryNative;
 import org.jpype.manager.TypeManager;
 import org.jpype.pkg.JPypePackage;
+import org.jpype.pkg.JPypePackageIndex;
 import org.jpype.pkg.JPypePackageManager;
 import org.jpype.ref.JPypeReferenceQueue;
 
@@ -110,7 +109,10 @@ public class JPypeContext
     INSTANCE.typeManager = new TypeManager(context, INSTANCE.typeFactory);
     INSTANCE.initialize(interrupt);
 
-    scanExistingJars();
+    // Index the classpath and recreate missing directory entries for the
+    // class loader in the background
+    String classPath = System.getProperty("java.class.path");
+    JPypePackageIndex.start(classPath, INSTANCE.classLoader.scanClassPath(classPath));
     return INSTANCE;
   }
 
@@ -456,6 +458,49 @@ public class JPypeContext
     return parts;
   }
 
+  /**
+   * Store a group of strings into an object array.
+   * <p>
+   * Used when assigning a sequence of Python strings to an array. The text
+   * of all of the strings is packed into one char array so that the whole
+   * group crosses JNI in a single call.
+   *
+   * @param array is the array to fill.
+   * @param indices is the array index for each string.
+   * @param chars is the packed UTF-16 text.
+   * @param ends is the end offset of each string in chars.
+   */
+  public void fillStrings(Object[] array, int[] indices, char[] chars, int[] ends)
+  {
+    int begin = 0;
+    for (int i = 0; i < indices.length; ++i)
+    {
+      array[indices[i]] = new String(chars, begin, ends[i] - begin);
+      begin = ends[i];
+    }
+  }
+
+  /**
+   * Copy converted elements into a slice of an array.
+   *
+   * @param src holds the converted elements.
+   * @param dest is the array to store into.
+   * @param start is the first index in dest.
+   * @param step is the distance between indices in dest.
+   */
+  public void storeRange(Object[] src, Object[] dest, int start, int step)
+  {
+    if (step == 1)
+    {
+      System.arraycopy(src, 0, dest, start, src.length);
+      return;
+    }
+    for (int i = 0, j = start; i < src.length; ++i, j += step)
+    {
+      dest[j] = src[i];
+    }
+  }
+
   public boolean isShutdown()
   {
     return shutdownFlag.get() > 0;
@@ -627,16 +672,6 @@ public class JPypeContext
     }
   }
 
-  private static void scanExistingJars()
-  {
-    // Scan existing jars for missing directory entries
-    String[] paths = System.getProperty("java.class.path").split(File.pathSeparator);
-    for (String path : paths)
-    {
-      INSTANCE.classLoader.scanJar(Paths.get(path));
-    }
-  }
-
   private static long getTotalMemory() 
   {
     return Runtime.getRuntime().totalMemory();
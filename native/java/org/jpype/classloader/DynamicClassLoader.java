@@ -1,6 +1,6 @@
 package org.jpype.classloader;
 
-import java.io.ByteArrayOutputStream;
+import java.io.File;
 import java.io.FileNotFoundException;
 import java.io.IOException;
 import java.io.InputStream;
@@ -14,15 +14,20 @@ import java.nio.file.FileVisitResult;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.PathMatcher;
+import java.nio.file.Paths;
 import java.nio.file.SimpleFileVisitor;
 import java.nio.file.attribute.BasicFileAttributes;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.Enumeration;
 import java.util.HashMap;
+import java.util.IdentityHashMap;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Set;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.FutureTask;
 import java.util.jar.JarEntry;
 import java.util.jar.JarFile;
 
@@ -32,6 +37,21 @@ public class DynamicClassLoader extends ClassLoader
   List<URLClassLoader> loaders = new LinkedList<>();
   HashMap<String, ArrayList<URL>> map = new HashMap<>();
 
+  // Index of jar entry names to the first loader holding them.  Jars are
+  // queued when added and only scanned when the next lookup arrives.
+  private final HashMap<String, URLClassLoader> index = new HashMap<>();
+  private final List<Path> pendingPaths = new ArrayList<>();
+  private final List<URLClassLoader> pendingLoaders = new ArrayList<>();
+
+  // Loaders holding directories or other unindexed content.
+  private final List<URLClassLoader> unindexed = new ArrayList<>();
+
+  // Position of each loader in the order added.
+  private final IdentityHashMap<URLClassLoader, Integer> order = new IdentityHashMap<>();
+
+  // Scan of the startup classpath for missing directory entries.
+  private volatile FutureTask<Void> classPathScan;
+
   public DynamicClassLoader(ClassLoader parent)
   {
     super(parent);
@@ -54,6 +74,7 @@ public class DynamicClassLoader extends ClassLoader
     final PathMatcher pathMatcher = FileSystems.getDefault().getPathMatcher(glob);
 
     List<URL> urls = new LinkedList<>();
+    List<Path> paths = new ArrayList<>();
     Files.walkFileTree(root, new SimpleFileVisitor<Path>()
     {
 
@@ -65,6 +86,7 @@ public class DynamicClassLoader extends ClassLoader
         {
           URL url = path.toUri().toURL();
           urls.add(url);
+          paths.add(path);
         }
         return FileVisitResult.CONTINUE;
       }
@@ -77,7 +99,16 @@ public class DynamicClassLoader extends ClassLoader
       }
     });
 
-    loaders.add(new URLClassLoader(urls.toArray(new URL[urls.size()])));
+    URLClassLoader loader = new URLClassLoader(urls.toArray(new URL[urls.size()]));
+    loaders.add(loader);
+    synchronized (index)
+    {
+      order.put(loader, order.size());
+      for (Path path : paths)
+      {
+        enqueue(loader, path);
+      }
+    }
   }
 
   public void addFile(Path path) throws FileNotFoundException
@@ -90,7 +121,13 @@ public class DynamicClassLoader extends ClassLoader
       {
         path.toUri().toURL()
       };
-      loaders.add(new URLClassLoader(urls));
+      URLClassLoader loader = new URLClassLoader(urls);
+      loaders.add(loader);
+      synchronized (index)
+      {
+        order.put(loader, order.size());
+        enqueue(loader, path);
+      }
 
       // Scan the file for directory entries
       this.scanJar(path);
@@ -122,16 +159,7 @@ public class DynamicClassLoader extends ClassLoader
       URLConnection connection = url.openConnection();
       try ( InputStream is = connection.getInputStream())
       {
-        ByteArrayOutputStream buffer = new ByteArrayOutputStream();
-        int bytes;
-        byte[] d = new byte[1024];
-        while ((bytes = is.read(d, 0, d.length)) != -1)
-        {
-          buffer.write(d, 0, bytes);
-        }
-
-        buffer.flush();
-        byte[] data = buffer.toByteArray();
+        byte[] data = readAll(is, connection.getContentLength());
         return defineClass(name, data, 0, data.length);
       }
     } catch (IOException ex)
@@ -146,17 +174,18 @@ public class DynamicClassLoader extends ClassLoader
     URL url = this.getParent().getResource(name);
     if (url != null)
       return url;
-    for (ClassLoader cl : this.loaders)
-    {
-      url = cl.getResource(name);
-      if (url != null)
-        return url;
-    }
+    url = findIndexed(name);
+    if (url != null)
+      return url;
     // Both with and without / should generate the same result
     if (name.endsWith("/"))
       name = name.substring(0, name.length() - 1);
-    if (map.containsKey(name))
-      return map.get(name).get(0);
+    awaitClassPathScan();
+    synchronized (map)
+    {
+      if (map.containsKey(name))
+        return map.get(name).get(0);
+    }
     return null;
   }
 
@@ -174,16 +203,212 @@ public class DynamicClassLoader extends ClassLoader
     // Both with and without / should generate the same result
     if (name.endsWith("/"))
       name = name.substring(0, name.length() - 1);
-    if (map.containsKey(name))
-      out.addAll(map.get(name));
+    awaitClassPathScan();
+    synchronized (map)
+    {
+      if (map.containsKey(name))
+        out.addAll(map.get(name));
+    }
     return Collections.enumeration(out);
   }
 
+  /**
+   * Locate a resource in the added jars.
+   *
+   * Jars are searched through the entry index. Only loaders that could not
+   * be indexed, such as those for directories, are searched linearly.
+   *
+   * @param name is the resource name.
+   * @return the resource url or null if not found.
+   */
+  private URL findIndexed(String name)
+  {
+    URLClassLoader indexed;
+    List<URLClassLoader> linear = Collections.emptyList();
+    synchronized (index)
+    {
+      buildIndex();
+      indexed = index.get(name);
+      if (indexed == null && name.endsWith("/"))
+        indexed = index.get(name.substring(0, name.length() - 1));
+
+      // Preserve the order in which the loaders were added.
+      int last = indexed == null ? Integer.MAX_VALUE : order.get(indexed);
+      for (URLClassLoader cl : unindexed)
+      {
+        if (order.get(cl) > last)
+          break;
+        if (linear.isEmpty())
+          linear = new ArrayList<>();
+        linear.add(cl);
+      }
+    }
+
+    URL url;
+    for (URLClassLoader cl : linear)
+    {
+      url = cl.getResource(name);
+      if (url != null)
+        return url;
+    }
+    if (indexed != null)
+    {
+      url = indexed.getResource(name);
+      if (url != null)
+        return url;
+    }
+    return null;
+  }
+
+  private void enqueue(URLClassLoader loader, Path path)
+  {
+    if (Files.isDirectory(path))
+    {
+      addUnindexed(loader);
+      return;
+    }
+    pendingPaths.add(path);
+    pendingLoaders.add(loader);
+  }
+
+  /**
+   * Scan jars added since the last lookup into the index.
+   *
+   * Must be called holding the index lock.
+   */
+  private void buildIndex()
+  {
+    for (int i = 0; i < pendingPaths.size(); ++i)
+    {
+      Path path = pendingPaths.get(i);
+      URLClassLoader loader = pendingLoaders.get(i);
+      try ( JarFile jf = new JarFile(path.toFile()))
+      {
+        boolean multirelease = jf.getManifest() != null
+                && "true".equalsIgnoreCase(jf.getManifest().getMainAttributes().getValue("Multi-Release"));
+        Enumeration<JarEntry> entries = jf.entries();
+        while (entries.hasMoreElements())
+        {
+          String entry = entries.nextElement().getName();
+          if (multirelease && entry.startsWith("META-INF/versions/"))
+          {
+            // Versioned entries are also visible under their base name
+            int j = entry.indexOf('/', 18);
+            if (j != -1)
+              putIndex(entry.substring(j + 1), loader);
+          }
+          putIndex(entry, loader);
+        }
+      } catch (IOException ex)
+      {
+        // Unable to read the jar so fall back to searching it directly
+        addUnindexed(loader);
+      }
+    }
+    pendingPaths.clear();
+    pendingLoaders.clear();
+  }
+
+  /**
+   * Add a loader to be searched linearly.
+   *
+   * The list is kept in the order the loaders were added so that lookups
+   * follow the classpath precedence.
+   *
+   * Must be called holding the index lock.
+   */
+  private void addUnindexed(URLClassLoader loader)
+  {
+    if (unindexed.contains(loader))
+      return;
+    int position = order.get(loader);
+    int i = unindexed.size();
+    while (i > 0 && order.get(unindexed.get(i - 1)) > position)
+      --i;
+    unindexed.add(i, loader);
+  }
+
+  private void putIndex(String entry, URLClassLoader loader)
+  {
+    if (entry.isEmpty())
+      return;
+    if (entry.endsWith("/"))
+      entry = entry.substring(0, entry.length() - 1);
+    index.putIfAbsent(entry, loader);
+  }
+
+  private static byte[] readAll(InputStream is, int size) throws IOException
+  {
+    // Read directly into a buffer of the reported size when known
+    byte[] data = new byte[size > 0 ? size : 4096];
+    int total = 0;
+    while (true)
+    {
+      if (total == data.length)
+      {
+        int next = is.read();
+        if (next == -1)
+          return data;
+        data = Arrays.copyOf(data, data.length * 2);
+        data[total++] = (byte) next;
+      }
+      int bytes = is.read(data, total, data.length - total);
+      if (bytes == -1)
+        break;
+      total += bytes;
+    }
+    return total == data.length ? data : Arrays.copyOf(data, total);
+  }
+
   public void addResource(String name, URL url)
   {
-    if (!this.map.containsKey(name))
-      this.map.put(name, new ArrayList<>());
-    this.map.get(name).add(url);
+    synchronized (map)
+    {
+      if (!this.map.containsKey(name))
+        this.map.put(name, new ArrayList<>());
+      this.map.get(name).add(url);
+    }
+  }
+
+  /**
+   * Create a task recreating missing directory entries for the startup
+   * classpath.
+   *
+   * The task is meant to be run in the background. Resource lookups wait for
+   * it to complete, or run it themselves if it has not been started.
+   *
+   * @param classPath is the startup classpath.
+   * @return the task to run.
+   */
+  public Runnable scanClassPath(String classPath)
+  {
+    FutureTask<Void> task = new FutureTask<>(() ->
+    {
+      for (String path : classPath.split(File.pathSeparator))
+      {
+        scanJar(Paths.get(path));
+      }
+    }, null);
+    classPathScan = task;
+    return task;
+  }
+
+  private void awaitClassPathScan()
+  {
+    FutureTask<Void> task = classPathScan;
+    if (task == null)
+      return;
+    task.run();
+    try
+    {
+      task.get();
+    } catch (InterruptedException ex)
+    {
+      Thread.currentThread().interrupt();
+    } catch (ExecutionException ex)
+    {
+      // The scan is best effort
+    }
   }
 
   /**
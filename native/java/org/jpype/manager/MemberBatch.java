@@ -0,0 +1,225 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.manager;
+
+import java.lang.reflect.Executable;
+import java.lang.reflect.Field;
+import java.util.ArrayList;
+import java.util.Arrays;
+
+/**
+ * Packed description of the members of a class.
+ * <p>
+ * Rather than crossing into C++ once per field, method and dispatch, the
+ * TypeManager records every member of a class here and passes the whole
+ * batch to the TypeFactory in one call.
+ * <p>
+ * The batch holds an object table (names and reflected members) and a packed
+ * array of records. Each record starts with its kind followed by:
+ * <ul>
+ * <li>FIELD: name, field, type, modifiers</li>
+ * <li>METHOD: name, executable, modifiers, count, precedence...</li>
+ * <li>DISPATCH: name, modifiers, count, overloads...</li>
+ * <li>ASSIGN: constructor, count, dispatches..., count, fields...</li>
+ * </ul>
+ * Names and members are indices into the object table. References to members
+ * are either wrapper pointers created earlier or local references to entries
+ * created earlier in the same batch. Local references are encoded as the
+ * complement of the entry index so they are always negative. The factory
+ * returns the pointers for each FIELD, METHOD and DISPATCH entry in order.
+ *
+ * @author nelson85
+ */
+public class MemberBatch
+{
+
+  public static final int FIELD = 1;
+  public static final int METHOD = 2;
+  public static final int DISPATCH = 3;
+  public static final int ASSIGN = 4;
+
+  final ArrayList<Object> objects = new ArrayList<>();
+  long[] data = new long[256];
+  int size = 0;
+  int entries = 0;
+
+  long addField(String name, Field field, long type, int modifiers)
+  {
+    add(FIELD, addObject(name), addObject(field), type, modifiers);
+    return local(entries++);
+  }
+
+  long addMethod(String name, Executable method, long[] precedence, int modifiers)
+  {
+    add(METHOD, addObject(name), addObject(method), modifiers, precedence.length);
+    add(precedence);
+    return local(entries++);
+  }
+
+  long addDispatch(String name, long[] overloads, int modifiers)
+  {
+    add(DISPATCH, addObject(name), modifiers, overloads.length);
+    add(overloads);
+    return local(entries++);
+  }
+
+  void assign(long ctor, long[] dispatches, long[] fields)
+  {
+    add(ASSIGN, ctor, dispatches.length);
+    add(dispatches);
+    add(fields.length);
+    add(fields);
+  }
+
+  Object[] getObjects()
+  {
+    return objects.toArray();
+  }
+
+  long[] getData()
+  {
+    return Arrays.copyOf(data, size);
+  }
+
+  /**
+   * Convert a reference into a wrapper pointer.
+   *
+   * @param ref is a pointer or local reference.
+   * @param ptrs are the pointers returned by the factory.
+   * @return the wrapper pointer.
+   */
+  static long resolve(long ref, long[] ptrs)
+  {
+    if (ref < 0)
+      return ptrs[(int) ~ref];
+    return ref;
+  }
+
+  static long[] resolve(long[] refs, long[] ptrs)
+  {
+    if (refs == null)
+      return null;
+    long[] out = new long[refs.length];
+    for (int i = 0; i < refs.length; ++i)
+    {
+      out[i] = resolve(refs[i], ptrs);
+    }
+    return out;
+  }
+
+  private static long local(int index)
+  {
+    return ~(long) index;
+  }
+
+  private int addObject(Object obj)
+  {
+    objects.add(obj);
+    return objects.size() - 1;
+  }
+
+  private void add(long... values)
+  {
+    if (size + values.length > data.length)
+      data = Arrays.copyOf(data, Math.max(data.length * 2, size + values.length));
+    System.arraycopy(values, 0, data, size, values.length);
+    size += values.length;
+  }
+
+  /**
+   * Decode a batch using the per member calls of a TypeFactory.
+   * <p>
+   * This is the reference implementation of the batch protocol used by
+   * factories that do not decode the batch natively.
+   *
+   * @param factory is the factory to create the members.
+   * @param context is the C++ context.
+   * @param cls is the class pointer.
+   * @param objects is the object table.
+   * @param data is the packed records.
+   * @return the pointers for each entry.
+   */
+  static long[] decode(TypeFactory factory, long context, long cls, Object[] objects, long[] data)
+  {
+    ArrayList<Long> created = new ArrayList<>();
+    int i = 0;
+    while (i < data.length)
+    {
+      int kind = (int) data[i++];
+      switch (kind)
+      {
+        case FIELD:
+        {
+          String name = (String) objects[(int) data[i++]];
+          Field field = (Field) objects[(int) data[i++]];
+          long type = data[i++];
+          int modifiers = (int) data[i++];
+          created.add(factory.defineField(context, cls, name, field, type, modifiers));
+          break;
+        }
+        case METHOD:
+        {
+          String name = (String) objects[(int) data[i++]];
+          Executable method = (Executable) objects[(int) data[i++]];
+          int modifiers = (int) data[i++];
+          long[] precedence = readRefs(data, i, created);
+          i += precedence.length + 1;
+          created.add(factory.defineMethod(context, cls, name, method, precedence, modifiers));
+          break;
+        }
+        case DISPATCH:
+        {
+          String name = (String) objects[(int) data[i++]];
+          int modifiers = (int) data[i++];
+          long[] overloads = readRefs(data, i, created);
+          i += overloads.length + 1;
+          created.add(factory.defineMethodDispatch(context, cls, name, overloads, modifiers));
+          break;
+        }
+        case ASSIGN:
+        {
+          long ctor = data[i++];
+          ctor = (ctor < 0) ? created.get((int) ~ctor) : ctor;
+          long[] dispatches = readRefs(data, i, created);
+          i += dispatches.length + 1;
+          long[] fields = readRefs(data, i, created);
+          i += fields.length + 1;
+          factory.assignMembers(context, cls, ctor, dispatches, fields);
+          break;
+        }
+        default:
+          throw new RuntimeException("Bad member record " + kind);
+      }
+    }
+    long[] ptrs = new long[created.size()];
+    for (int j = 0; j < ptrs.length; ++j)
+    {
+      ptrs[j] = created.get(j);
+    }
+    return ptrs;
+  }
+
+  private static long[] readRefs(long[] data, int i, ArrayList<Long> created)
+  {
+    long[] out = new long[(int) data[i++]];
+    for (int j = 0; j < out.length; ++j)
+    {
+      long ref = data[i++];
+      out[j] = (ref < 0) ? created.get((int) ~ref) : ref;
+    }
+    return out;
+  }
+}
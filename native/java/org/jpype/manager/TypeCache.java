@@ -0,0 +1,512 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.manager;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.lang.reflect.Executable;
+import java.lang.reflect.Method;
+import java.net.URL;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
+import java.security.CodeSource;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Enumeration;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.LinkedList;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeSet;
+import java.util.jar.JarEntry;
+import java.util.jar.JarFile;
+import java.util.zip.CRC32;
+
+/**
+ * Persistent cache of member metadata computed by the TypeManager.
+ * <p>
+ * The TypeManager filters and orders the members of each class before passing
+ * them to JPype. For classes with many overloads the ordering is quadratic in
+ * the number of overloads. This cache stores the result on disk so that warm
+ * starts can replay it. Each entry is keyed by the class name and holds a
+ * fingerprint combining the checksums of the jars holding the class, its
+ * supertypes, and the parameter types of its members along with their
+ * supertypes. Upgrading any of those jars invalidates the entry. Checksums are
+ * computed once per jar per run. Members are recorded by their position in the
+ * reflected array and verified against their full signature, as the order of
+ * the reflected members is not guaranteed.
+ * <p>
+ * The cache is enabled by setting the system property
+ * {@code org.jpype.typecache} to the path of the cache file.
+ *
+ * @author nelson85
+ */
+public class TypeCache
+{
+
+  static final int MAGIC = 0x4a505443;
+  static final int VERSION = 3;
+
+  final Path path;
+  final HashMap<String, Entry> entries = new HashMap<>();
+  // Checksums for each code source, computed once per run.
+  final HashMap<String, Long> checksums = new HashMap<>();
+  // Jars holding each class and its supertypes, null if not cacheable.
+  final IdentityHashMap<Class<?>, TreeSet<String>> hierarchies = new IdentityHashMap<>();
+  boolean dirty = false;
+  int hits = 0;
+  int misses = 0;
+
+  static class Entry
+  {
+
+    long fingerprint;
+    // Number of members the entry was computed from
+    int count;
+    // Position of each member in the unprocessed members
+    int[] index;
+    // Signature of each member to verify the positions
+    String[] signatures;
+    int[][] children;
+  }
+
+  TypeCache(Path path)
+  {
+    this.path = path;
+  }
+
+  /**
+   * Open the cache selected by the {@code org.jpype.typecache} property.
+   *
+   * @return the cache or null if caching is not enabled.
+   */
+  static TypeCache open()
+  {
+    String name = System.getProperty("org.jpype.typecache");
+    if (name == null || name.isEmpty())
+      return null;
+    TypeCache cache = new TypeCache(Paths.get(name));
+    cache.load();
+    return cache;
+  }
+
+  void load()
+  {
+    if (!Files.exists(path))
+      return;
+    try (DataInputStream is = new DataInputStream(new BufferedInputStream(Files.newInputStream(path))))
+    {
+      if (is.readInt() != MAGIC || is.readInt() != VERSION)
+        return;
+      int n = is.readInt();
+      for (int i = 0; i < n; ++i)
+      {
+        String key = is.readUTF();
+        Entry entry = new Entry();
+        entry.fingerprint = is.readLong();
+        entry.count = is.readInt();
+        int m = is.readInt();
+        entry.index = new int[m];
+        entry.signatures = new String[m];
+        entry.children = new int[m][];
+        for (int j = 0; j < m; ++j)
+        {
+          entry.index[j] = is.readInt();
+          entry.signatures[j] = is.readUTF();
+          int[] ch = new int[is.readInt()];
+          for (int k = 0; k < ch.length; ++k)
+          {
+            ch[k] = is.readInt();
+          }
+          entry.children[j] = ch;
+        }
+        entries.put(key, entry);
+      }
+    } catch (IOException | RuntimeException ex)
+    {
+      // A corrupt cache is simply discarded.
+      entries.clear();
+    }
+  }
+
+  /**
+   * Write the cache if anything has changed.
+   */
+  void save()
+  {
+    if (!dirty)
+      return;
+    try
+    {
+      Path parent = path.toAbsolutePath().getParent();
+      if (parent != null)
+        Files.createDirectories(parent);
+      Path tmp = Files.createTempFile(parent, "typecache", ".tmp");
+      try (DataOutputStream os = new DataOutputStream(new BufferedOutputStream(Files.newOutputStream(tmp))))
+      {
+        os.writeInt(MAGIC);
+        os.writeInt(VERSION);
+        os.writeInt(entries.size());
+        for (Map.Entry<String, Entry> e : entries.entrySet())
+        {
+          Entry entry = e.getValue();
+          os.writeUTF(e.getKey());
+          os.writeLong(entry.fingerprint);
+          os.writeInt(entry.count);
+          os.writeInt(entry.index.length);
+          for (int j = 0; j < entry.index.length; ++j)
+          {
+            os.writeInt(entry.index[j]);
+            os.writeUTF(entry.signatures[j]);
+            os.writeInt(entry.children[j].length);
+            for (int k : entry.children[j])
+            {
+              os.writeInt(k);
+            }
+          }
+        }
+      }
+      // Replace atomically so concurrent processes never see a partial file
+      Files.move(tmp, path, StandardCopyOption.REPLACE_EXISTING);
+      dirty = false;
+    } catch (IOException | RuntimeException ex)
+    {
+      // The cache is only an optimization.
+    }
+  }
+
+  /**
+   * Replay a cached member filter.
+   *
+   * @param <T>
+   * @param cls is the class holding the members.
+   * @param key identifies the filter.
+   * @param members are the unfiltered members.
+   * @return the filtered members, or null if there is no valid entry.
+   */
+  <T extends Executable> LinkedList<T> filter(Class<?> cls, String key, T[] members)
+  {
+    Entry entry = find(cls, key, members);
+    if (entry == null)
+      return null;
+    LinkedList<T> out = new LinkedList<>();
+    for (int i = 0; i < entry.index.length; ++i)
+    {
+      T member = get(entry, i, members);
+      if (member == null)
+        return null;
+      out.add(member);
+    }
+    hits++;
+    return out;
+  }
+
+  <T extends Executable> void storeFilter(Class<?> cls, String key, T[] members, List<T> filtered)
+  {
+    long fingerprint = fingerprint(cls, members);
+    if (fingerprint == 0)
+      return;
+    IdentityHashMap<T, Integer> position = positions(members);
+    Entry entry = create(fingerprint, members.length, filtered.size());
+    int i = 0;
+    for (T member : filtered)
+    {
+      record(entry, i++, position.get(member), member);
+    }
+    entries.put(cls.getName() + key, entry);
+    dirty = true;
+  }
+
+  /**
+   * Replay a cached overload ordering.
+   *
+   * @param <T>
+   * @param cls is the class holding the dispatch.
+   * @param key is the dispatch name.
+   * @param methods are the overloads to be ordered.
+   * @return the ordered overloads, or null if there is no valid entry.
+   */
+  <T extends Executable> List<MethodResolution> sortMethods(Class<?> cls, String key, List<T> methods)
+  {
+    Executable[] members = methods.toArray(new Executable[methods.size()]);
+    Entry entry = find(cls, "." + key, members);
+    if (entry == null)
+      return null;
+    List<MethodResolution> out = new ArrayList<>(members.length);
+    for (int i = 0; i < entry.index.length; ++i)
+    {
+      Executable method = get(entry, i, members);
+      if (method == null)
+        return null;
+      MethodResolution ov = new MethodResolution(method);
+      for (int j : entry.children[i])
+      {
+        ov.children.add(out.get(j));
+      }
+      out.add(ov);
+    }
+    hits++;
+    return out;
+  }
+
+  <T extends Executable> void storeMethods(Class<?> cls, String key, List<T> methods, List<MethodResolution> sorted)
+  {
+    Executable[] members = methods.toArray(new Executable[methods.size()]);
+    long fingerprint = fingerprint(cls, members);
+    if (fingerprint == 0)
+      return;
+    IdentityHashMap<Executable, Integer> index = positions(members);
+    Entry entry = create(fingerprint, methods.size(), sorted.size());
+    HashMap<MethodResolution, Integer> position = new HashMap<>();
+    int i = 0;
+    for (MethodResolution ov : sorted)
+    {
+      position.put(ov, i);
+      record(entry, i, index.get(ov.executable), ov.executable);
+      entry.children[i] = new int[ov.children.size()];
+      for (int j = 0; j < ov.children.size(); ++j)
+      {
+        entry.children[i][j] = position.get(ov.children.get(j));
+      }
+      i++;
+    }
+    entries.put(cls.getName() + "." + key, entry);
+    dirty = true;
+  }
+
+  /**
+   * Get the combined checksum of the jars a member ordering depends on.
+   *
+   * This covers the class, the parameter types of the members, and the
+   * supertypes of each.
+   *
+   * @param cls is the class holding the members.
+   * @param members are the unprocessed members.
+   * @return the fingerprint, or 0 if any source can not be checksummed.
+   */
+  long fingerprint(Class<?> cls, Executable[] members)
+  {
+    TreeSet<String> sources = new TreeSet<>();
+    if (!addSources(cls, sources))
+      return 0;
+    for (Executable member : members)
+    {
+      for (Class<?> p : member.getParameterTypes())
+      {
+        if (!addSources(p, sources))
+          return 0;
+      }
+    }
+    long out = 17;
+    for (String source : sources)
+    {
+      long sum = checksum(source);
+      if (sum == 0)
+        return 0;
+      out = out * 31 + sum;
+    }
+    return (out == 0) ? 1 : out;
+  }
+
+  private boolean addSources(Class<?> cls, TreeSet<String> out)
+  {
+    while (cls.isArray())
+    {
+      cls = cls.getComponentType();
+    }
+    TreeSet<String> sources = hierarchy(cls);
+    if (sources == null)
+      return false;
+    out.addAll(sources);
+    return true;
+  }
+
+  /**
+   * Get the jars holding a class and all of its supertypes.
+   *
+   * @param cls is the class to examine.
+   * @return the sources, or null if any can not be checksummed.
+   */
+  private TreeSet<String> hierarchy(Class<?> cls)
+  {
+    if (hierarchies.containsKey(cls))
+      return hierarchies.get(cls);
+    TreeSet<String> out = new TreeSet<>();
+    String source = getSource(cls);
+    if (source == null)
+      out = null;
+    else
+      out.add(source);
+    ArrayList<Class<?>> supers = new ArrayList<>();
+    if (cls.getSuperclass() != null)
+      supers.add(cls.getSuperclass());
+    supers.addAll(Arrays.asList(cls.getInterfaces()));
+    for (Class<?> sup : supers)
+    {
+      if (out == null)
+        break;
+      TreeSet<String> sources = hierarchy(sup);
+      if (sources == null)
+        out = null;
+      else
+        out.addAll(sources);
+    }
+    hierarchies.put(cls, out);
+    return out;
+  }
+
+  private Entry find(Class<?> cls, String key, Executable[] members)
+  {
+    Entry entry = entries.get(cls.getName() + key);
+    if (entry == null || entry.count != members.length
+            || entry.fingerprint != fingerprint(cls, members))
+    {
+      misses++;
+      return null;
+    }
+    return entry;
+  }
+
+  private <T extends Executable> T get(Entry entry, int i, T[] members)
+  {
+    int j = entry.index[i];
+    if (j < 0 || j >= members.length
+            || !signature(members[j]).equals(entry.signatures[i]))
+    {
+      misses++;
+      return null;
+    }
+    return members[j];
+  }
+
+  private static Entry create(long fingerprint, int count, int n)
+  {
+    Entry entry = new Entry();
+    entry.fingerprint = fingerprint;
+    entry.count = count;
+    entry.index = new int[n];
+    entry.signatures = new String[n];
+    entry.children = new int[n][];
+    return entry;
+  }
+
+  private static void record(Entry entry, int i, int index, Executable member)
+  {
+    entry.index[i] = index;
+    entry.signatures[i] = signature(member);
+    entry.children[i] = new int[0];
+  }
+
+  /**
+   * Get a descriptor that identifies a member.
+   *
+   * The return type is included so that bridge methods can be told apart.
+   */
+  private static String signature(Executable member)
+  {
+    StringBuilder sb = new StringBuilder();
+    sb.append(member.getDeclaringClass().getName())
+            .append('.')
+            .append(member.getName())
+            .append('(');
+    for (Class<?> p : member.getParameterTypes())
+    {
+      sb.append(p.getName()).append(';');
+    }
+    sb.append(')');
+    if (member instanceof Method)
+      sb.append(((Method) member).getReturnType().getName());
+    return sb.toString();
+  }
+
+  private static <T> IdentityHashMap<T, Integer> positions(T[] members)
+  {
+    IdentityHashMap<T, Integer> out = new IdentityHashMap<>();
+    for (int i = 0; i < members.length; ++i)
+    {
+      out.put(members[i], i);
+    }
+    return out;
+  }
+
+  private static String getSource(Class<?> cls)
+  {
+    ClassLoader cl = cls.getClassLoader();
+    CodeSource cs = cls.getProtectionDomain().getCodeSource();
+    URL location = (cs == null) ? null : cs.getLocation();
+    // Only classes from the runtime image are safe without a jar
+    if (location == null)
+      return (cl == null) ? "jdk" : null;
+    if ("jrt".equals(location.getProtocol()))
+      return "jdk";
+    if (!"file".equals(location.getProtocol()))
+      return null;
+    return location.toString();
+  }
+
+  private long checksum(String source)
+  {
+    Long sum = checksums.get(source);
+    if (sum != null)
+      return sum;
+    long out = 0;
+    CRC32 crc = new CRC32();
+    if ("jdk".equals(source))
+    {
+      String runtime = System.getProperty("java.home") + ":" + System.getProperty("java.runtime.version");
+      crc.update(runtime.getBytes(StandardCharsets.UTF_8));
+      out = crc.getValue() | 0x100000000L;
+    } else
+    {
+      try
+      {
+        Path p = Paths.get(new URL(source).toURI());
+        // Only jars can be checksummed without walking the tree.  The entry
+        // crcs are held in the central directory so no inflation is needed.
+        if (Files.isRegularFile(p))
+        {
+          try (JarFile jf = new JarFile(p.toFile()))
+          {
+            Enumeration<JarEntry> e = jf.entries();
+            while (e.hasMoreElements())
+            {
+              JarEntry entry = e.nextElement();
+              crc.update(entry.getName().getBytes(StandardCharsets.UTF_8));
+              long v = entry.getCrc() ^ (entry.getSize() << 32);
+              for (int i = 0; i < 8; ++i)
+              {
+                crc.update((int) (v >>> (8 * i)));
+              }
+            }
+          }
+          out = crc.getValue() | 0x100000000L;
+        }
+      } catch (Exception ex)
+      {
+        out = 0;
+      }
+    }
+    checksums.put(source, out);
+    return out;
+  }
+}
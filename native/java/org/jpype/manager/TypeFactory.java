@@ -97,6 +97,27 @@ public interface TypeFactory
 
 //</editor-fold>
 //<editor-fold desc="members" defaultstate="collapsed">
+  /**
+   * Create all of the members of a class in one call.
+   * <p>
+   * The batch format is described in MemberBatch. The default implementation
+   * decodes the batch into the per member calls.
+   *
+   * @param context JPContext object
+   * @param cls is the JPClass to populate
+   * @param objects is the table of names and reflected members.
+   * @param data is the packed member records.
+   * @return the pointers for each field, method and dispatch in order.
+   */
+  default long[] defineMembers(
+          long context,
+          long cls,
+          Object[] objects,
+          long[] data)
+  {
+    return MemberBatch.decode(this, context, cls, objects, data);
+  }
+
   /**
    * Called after a class is constructed to populate the required fields and
    * methods.
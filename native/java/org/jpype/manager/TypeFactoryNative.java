@@ -57,6 +57,13 @@ public class TypeFactoryNative implements TypeFactory
           long boxedPtr,
           int modifiers);
 
+  @Override
+  public native long[] defineMembers(
+          long context,
+          long cls,
+          Object[] objects,
+          long[] data);
+
   @Override
   public native void assignMembers(
           long context,
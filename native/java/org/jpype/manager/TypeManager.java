@@ -25,6 +25,7 @@ import java.lang.reflect.Member;
 import java.lang.reflect.Method;
 import java.lang.reflect.Modifier;
 import java.lang.reflect.Proxy;
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.nio.Buffer;
 import java.util.HashMap;
@@ -33,7 +34,10 @@ import java.util.LinkedList;
 import java.util.List;
 import java.util.TreeSet;
 import org.jpype.JPypeContext;
+import org.jpype.JPypeKeywords;
 import org.jpype.JPypeUtilities;
+import org.jpype.pkg.JPypePackage;
+import org.jpype.pkg.JPypePackageManager;
 import org.jpype.proxy.JPypeProxy;
 
 /**
@@ -48,6 +52,7 @@ public class TypeManager
   public HashMap<Class, ClassDescriptor> classMap = new HashMap<>();
   public TypeFactory typeFactory = null;
   public TypeAudit audit = null;
+  public TypeCache cache = null;
   private ClassDescriptor java_lang_Object;
   // For reasons that are less than clear, this object cannot be created
   // during shutdown
@@ -61,6 +66,7 @@ public class TypeManager
   {
     this.context = context;
     this.typeFactory = typeFactory;
+    this.cache = TypeCache.open();
   }
 
 //<editor-fold desc="interface">
@@ -251,6 +257,56 @@ public class TypeManager
     return null;
   }
 
+  /**
+   * Load the wrappers for all public classes in a set of packages.
+   * <p>
+   * The class wrappers and their members are created in a single pass while
+   * holding the type manager lock. Classes which fail to load are skipped.
+   * Classes are not initialized, so no static initializers run under the
+   * lock.
+   *
+   * @param packages is a list of package names.
+   * @return the classes that were loaded.
+   */
+  public synchronized Class<?>[] preload(String[] packages)
+  {
+    ClassLoader classLoader = JPypeContext.getInstance().getClassLoader();
+    List<Class<?>> out = new ArrayList<>();
+    for (String pkg : packages)
+    {
+      if (!JPypePackageManager.isPackage(pkg))
+        continue;
+      for (String name : new JPypePackage(pkg).getContents())
+      {
+        try
+        {
+          Class<?> cls = Class.forName(pkg + "." + JPypeKeywords.unwrap(name), false, classLoader);
+          if (!Modifier.isPublic(cls.getModifiers()))
+            continue;
+          if (this.findClass(cls) == 0)
+            continue;
+          this.populateMembers(cls);
+          out.add(cls);
+        } catch (ClassNotFoundException | LinkageError ex)
+        {
+          // Subpackages and classes that cannot be loaded are skipped.
+        }
+      }
+    }
+    if (cache != null)
+      cache.save();
+    return out.toArray(new Class<?>[out.size()]);
+  }
+
+  /**
+   * Write the type cache to disk if enabled.
+   */
+  public synchronized void saveCache()
+  {
+    if (cache != null)
+      cache.save();
+  }
+
   public synchronized void populateMethod(long wrapper, Executable method)
   {
     if (method == null)
@@ -326,6 +382,60 @@ public class TypeManager
     return this.findClass(cls);
   }
 
+  /**
+   * Get the wrappers for a range of an object array.
+   * <p>
+   * This is used to convert an array range to Python in one call. Each
+   * distinct class is resolved once. The elements are copied to the snapshot
+   * so that the classes still match if the array is modified while the
+   * caller converts them.
+   *
+   * @param array is the array to inspect.
+   * @param start is the first index.
+   * @param length is the number of elements.
+   * @param step is the stride between elements.
+   * @param snapshot receives the elements inspected.
+   * @return the JPClass for each element, or 0 for null elements.
+   * @throws InterruptedException
+   */
+  public long[] findClassesForArray(Object[] array, int start, int length, int step, Object[] snapshot) throws InterruptedException
+  {
+    JPypeContext.clearInterrupt(true);
+    long[] out = new long[length];
+    HashMap<Class<?>, Long> resolved = new HashMap<>();
+    Class<?> last = null;
+    long lastPtr = 0;
+    for (int i = 0, index = start; i < length; ++i, index += step)
+    {
+      Object object = array[index];
+      snapshot[i] = object;
+      if (object == null)
+        continue;
+      Class<?> cls = object.getClass();
+      if (cls == last)
+      {
+        out[i] = lastPtr;
+        continue;
+      }
+      // Proxies are resolved by their handler
+      if (Proxy.isProxyClass(cls))
+      {
+        out[i] = findClassForObject(object);
+        continue;
+      }
+      Long ptr = resolved.get(cls);
+      if (ptr == null)
+      {
+        ptr = this.findClass(cls);
+        resolved.put(cls, ptr);
+      }
+      last = cls;
+      lastPtr = ptr;
+      out[i] = lastPtr;
+    }
+    return out;
+  }
+
   /**
    * Called to delete all C++ resources
    */
@@ -334,6 +444,8 @@ public class TypeManager
     // First and most important, we can't operate from this
     // point forward.
     this.isShutdown = true;
+    if (cache != null)
+      cache.save();
 
     // Destroy all the resources held in C++
     for (ClassDescriptor entry : this.classMap.values())
@@ -544,24 +656,47 @@ public class TypeManager
 
   private void createMembers(ClassDescriptor desc)
   {
-    this.createFields(desc);
-    this.createConstructorDispatch(desc);
-    this.createMethodDispatches(desc);
+    // Members are collected in a batch and created with a single call to
+    // the type factory.  Until the batch is executed the descriptor holds
+    // local references into the batch.
+    MemberBatch batch = new MemberBatch();
+    try
+    {
+      this.createFields(desc, batch);
+      this.createConstructorDispatch(desc, batch);
+      this.createMethodDispatches(desc, batch);
+      batch.assign(desc.constructorDispatch, desc.methodDispatch, desc.fields);
+
+      // Pass this to JPype
+      long[] ptrs = this.typeFactory.defineMembers(context,
+              desc.classPtr,
+              batch.getObjects(),
+              batch.getData());
+
+      desc.constructorDispatch = MemberBatch.resolve(desc.constructorDispatch, ptrs);
+      desc.constructors = MemberBatch.resolve(desc.constructors, ptrs);
+      desc.methodDispatch = MemberBatch.resolve(desc.methodDispatch, ptrs);
+      desc.methods = MemberBatch.resolve(desc.methods, ptrs);
+      desc.fields = MemberBatch.resolve(desc.fields, ptrs);
+    } catch (RuntimeException ex)
+    {
+      // Leave the class unpopulated
+      desc.constructorDispatch = 0;
+      desc.constructors = null;
+      desc.methodDispatch = null;
+      desc.methods = null;
+      desc.methodCounter = 0;
+      desc.fields = null;
+      throw ex;
+    }
 
     // Verify integrity
     if (audit != null)
       audit.verifyMembers(desc);
-
-    // Pass this to JPype
-    this.typeFactory.assignMembers(context,
-            desc.classPtr,
-            desc.constructorDispatch,
-            desc.methodDispatch,
-            desc.fields);
   }
 
 //<editor-fold desc="fields" defaultstate="collapsed">
-  private void createFields(ClassDescriptor desc)
+  private void createFields(ClassDescriptor desc, MemberBatch batch)
   {
     // We only need declared fields as the wrappers for previous classes hold
     // members declared earlier
@@ -571,9 +706,7 @@ public class TypeManager
     int i = 0;
     for (Field field : fields)
     {
-      fieldPtr[i++] = this.typeFactory.defineField(context,
-              desc.classPtr,
-              field.getName(),
+      fieldPtr[i++] = batch.addField(field.getName(),
               field,
               getClass(field.getType()).classPtr,
               field.getModifiers() & 0xffff);
@@ -587,8 +720,9 @@ public class TypeManager
    * Load the constructors for a class.
    *
    * @param desc
+   * @param batch
    */
-  public void createConstructorDispatch(ClassDescriptor desc)
+  void createConstructorDispatch(ClassDescriptor desc, MemberBatch batch)
   {
     Class cls = desc.cls;
 
@@ -600,18 +734,15 @@ public class TypeManager
       return;
 
     // Sort them by precedence order
-    List<MethodResolution> overloads = MethodResolution.sortMethods(constructors);
+    List<MethodResolution> overloads = sortMethods(cls, "<init>", constructors);
 
     // Convert overload list to a list of overloads pointers
-    desc.constructors = this.createConstructors(desc, overloads);
+    desc.constructors = this.createConstructors(desc, batch, overloads);
 
     // Create the dispatch for it
-    desc.constructorDispatch = typeFactory
-            .defineMethodDispatch(context,
-                    desc.classPtr,
-                    "<init>",
-                    desc.constructors,
-                    ModifierCode.PUBLIC.value | ModifierCode.CTOR.value);
+    desc.constructorDispatch = batch.addDispatch("<init>",
+            desc.constructors,
+            ModifierCode.PUBLIC.value | ModifierCode.CTOR.value);
   }
 
   /**
@@ -620,10 +751,11 @@ public class TypeManager
    * These will be added to the shutdown destruction list.
    *
    * @param desc
+   * @param batch
    * @param overloads
    * @return
    */
-  private long[] createConstructors(ClassDescriptor desc,
+  private long[] createConstructors(ClassDescriptor desc, MemberBatch batch,
           List<MethodResolution> overloads)
   {
     int n = overloads.size();
@@ -641,9 +773,7 @@ public class TypeManager
 
       int modifiers = constructor.getModifiers() & 0xffff;
       modifiers |= ModifierCode.CTOR.value;
-      ov.ptr = typeFactory.defineMethod(context,
-              desc.classPtr,
-              constructor.toString(),
+      ov.ptr = batch.addMethod(constructor.toString(),
               constructor,
               precedencePtrs,
               modifiers);
@@ -658,16 +788,17 @@ public class TypeManager
    * Load the methods for a class.
    *
    * @param desc
+   * @param batch
    */
-  public void createMethodDispatches(ClassDescriptor desc)
+  void createMethodDispatches(ClassDescriptor desc, MemberBatch batch)
   {
     Class<?> cls = desc.cls;
 
     // Get the list of all public, non-overrided methods we will process
-    LinkedList<Method> methods = filterOverridden(cls, cls.getMethods());
+    LinkedList<Method> methods = filterOverridden(cls, cls.getMethods(), "#methods");
 
     // Get the list of public declared methods
-    LinkedList<Method> declaredMethods = filterOverridden(cls, cls.getDeclaredMethods());
+    LinkedList<Method> declaredMethods = filterOverridden(cls, cls.getDeclaredMethods(), "#declared");
 
     // We only need one dispatch per name
     TreeSet<String> resolve = new TreeSet<>();
@@ -684,12 +815,13 @@ public class TypeManager
     int i = 0;
     for (String name : resolve)
     {
-      desc.methodDispatch[i++] = this.createMethodDispatch(desc, name, methods);
+      desc.methodDispatch[i++] = this.createMethodDispatch(desc, batch, name, methods);
     }
   }
 
   private long createMethodDispatch(
           ClassDescriptor desc,
+          MemberBatch batch,
           String key,
           LinkedList<Method> candidates)
   {
@@ -714,16 +846,9 @@ public class TypeManager
     }
 
     // Convert overload list to a list of overloads pointers
-    List<MethodResolution> overloads = MethodResolution.sortMethods(methods);
-    long[] overloadPtrs = this.createMethods(desc, overloads);
-
-    long methodContainer = typeFactory.defineMethodDispatch(context,
-            desc.classPtr,
-            key,
-            overloadPtrs,
-            modifiers);
-
-    return methodContainer;
+    List<MethodResolution> overloads = sortMethods(desc.cls, key, methods);
+    long[] overloadPtrs = this.createMethods(desc, batch, overloads);
+    return batch.addDispatch(key, overloadPtrs, modifiers);
   }
 
   /**
@@ -733,11 +858,13 @@ public class TypeManager
    * These will be added to the shutdown destruction list.
    *
    * @param desc
+   * @param batch
    * @param overloads
    * @return a list of method overload wrappers.
    */
   private long[] createMethods(
           ClassDescriptor desc,
+          MemberBatch batch,
           List<MethodResolution> overloads)
   {
     int n = overloads.size();
@@ -778,9 +905,7 @@ public class TypeManager
       if (isCallerSensitive(method))
         modifiers |= ModifierCode.CALLER_SENSITIVE.value;
 
-      ov.ptr = typeFactory.defineMethod(context,
-              desc.classPtr,
-              method.toString(),
+      ov.ptr = batch.addMethod(method.toString(),
               method,
               precedencePtrs,
               modifiers);
@@ -849,6 +974,39 @@ public class TypeManager
 //</editor-fold>
 //<editor-fold desc="containers" defaultstate="collapsed">
 //</editor-fold>
+  /**
+   * Order overloads, replaying the result from the type cache if possible.
+   *
+   * @param <T>
+   * @param cls is the class holding the dispatch.
+   * @param key is the dispatch name.
+   * @param methods are the overloads.
+   * @return the overloads ordered from most to least specific.
+   */
+  private <T extends Executable> List<MethodResolution> sortMethods(Class<?> cls, String key, List<T> methods)
+  {
+    if (cache == null)
+      return MethodResolution.sortMethods(methods);
+    List<MethodResolution> out = cache.sortMethods(cls, key, methods);
+    if (out != null)
+      return out;
+    out = MethodResolution.sortMethods(methods);
+    cache.storeMethods(cls, key, methods, out);
+    return out;
+  }
+
+  private LinkedList<Method> filterOverridden(Class<?> cls, Method[] methods, String key)
+  {
+    if (cache == null)
+      return filterOverridden(cls, methods);
+    LinkedList<Method> out = cache.filter(cls, key, methods);
+    if (out != null)
+      return out;
+    out = filterOverridden(cls, methods);
+    cache.storeFilter(cls, key, methods, out);
+    return out;
+  }
+
 //</editor-fold>
 //<editor-fold desc="filters" defaultstate="collapsed">
   /**
@@ -0,0 +1,607 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.pkg;
+
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.nio.file.FileSystem;
+import java.nio.file.FileSystems;
+import java.nio.file.FileVisitResult;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayList;
+import java.util.Enumeration;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.FutureTask;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.jar.JarEntry;
+import java.util.jar.JarFile;
+import java.util.jar.Manifest;
+import org.jpype.JPypeKeywords;
+
+/**
+ * Background index of the packages held in the classpath jars and modules.
+ * <p>
+ * Walking a jar file system the first time a package is imported is slow and
+ * happens while Python holds the import lock. Instead each jar on the startup
+ * classpath and each runtime module is scanned on a small thread pool when the
+ * context is created. Readers only wait on the sources they consult, and if a
+ * source has not been picked up by a worker yet the reader scans it directly,
+ * so a lookup is never slower than the synchronous walk.
+ * <p>
+ * The index holds for each directory the names of its subdirectories and
+ * top level classes together with the entry holding them. If the system
+ * property {@code org.jpype.pkgcache} names a file, the index is saved there
+ * once complete and reused by later runs for any jar whose size and
+ * modification time are unchanged.
+ *
+ * @author nelson85
+ */
+public class JPypePackageIndex
+{
+
+  static final int MAGIC = 0x4a50504b;
+  static final int VERSION = 1;
+
+  // Jar sources in classpath order.
+  static final List<Source> sources = new ArrayList<>();
+  static final Map<Path, Source> jars = new HashMap<>();
+  static final Map<String, Source> modules = new HashMap<>();
+  // Directories found in completed jar sources.
+  static final Set<String> packages = ConcurrentHashMap.newKeySet();
+  static final AtomicInteger remaining = new AtomicInteger();
+  // Number of times a source answered a lookup from its index.
+  static final AtomicLong hits = new AtomicLong();
+  static volatile boolean complete = false;
+  static volatile boolean dirty = false;
+  static Path cachePath;
+  static Map<String, Cached> cache;
+
+  static class Cached
+  {
+
+    long size;
+    long modified;
+    Map<String, Map<String, String>> contents;
+  }
+
+  /**
+   * One jar or module to be indexed.
+   */
+  static class Source implements Callable<Map<String, Map<String, String>>>
+  {
+
+    final String key;
+    final Path path;
+    final boolean module;
+    final FutureTask<Map<String, Map<String, String>>> task = new FutureTask<>(this);
+    long size;
+    long modified;
+    volatile Map<String, Map<String, String>> contents;
+
+    Source(String key, Path path, boolean module)
+    {
+      this.key = key;
+      this.path = path;
+      this.module = module;
+    }
+
+    /**
+     * Get the index for this source.
+     *
+     * @return the index or null if the source could not be scanned.
+     */
+    Map<String, Map<String, String>> get()
+    {
+      // Take the work ourselves if no worker has started it yet.
+      task.run();
+      try
+      {
+        return task.get();
+      } catch (InterruptedException ex)
+      {
+        Thread.currentThread().interrupt();
+      } catch (ExecutionException ex)
+      {
+      }
+      return null;
+    }
+
+    @Override
+    public Map<String, Map<String, String>> call() throws IOException
+    {
+      try
+      {
+        if (!module)
+        {
+          size = Files.size(path);
+          modified = Files.getLastModifiedTime(path).toMillis();
+        }
+        Map<String, Map<String, String>> out = lookupCache(this);
+        if (out == null)
+        {
+          out = module ? scanModule(path) : scanJar(path);
+          dirty = true;
+        }
+        if (!module)
+          packages.addAll(out.keySet());
+        contents = out;
+        return out;
+      } finally
+      {
+        if (remaining.decrementAndGet() == 0)
+        {
+          complete = true;
+          saveCache();
+        }
+      }
+    }
+
+    URI toURI(String entry)
+    {
+      if (module)
+      {
+        if (entry.endsWith("/"))
+          entry = entry.substring(0, entry.length() - 1);
+        return JPypePackageManager.toURI(path.resolve(entry));
+      }
+      try
+      {
+        URI uri = new URI("jar", "file:" + path.toUri().getSchemeSpecificPart() + "!/" + entry, null);
+        return new URI(uri.toASCIIString());
+      } catch (URISyntaxException ex)
+      {
+        throw new RuntimeException("Failed to encode URI: " + entry, ex);
+      }
+    }
+
+    /**
+     * Add the contents of a package to a content map.
+     *
+     * @param out is the map to store the result in.
+     * @param packageName is the package with '/' separators.
+     * @return false if the source could not be indexed.
+     */
+    boolean collect(Map<String, URI> out, String packageName)
+    {
+      Map<String, Map<String, String>> index = get();
+      if (index == null)
+        return false;
+      hits.incrementAndGet();
+      Map<String, String> children = index.get(packageName);
+      if (children == null)
+        return true;
+      for (Map.Entry<String, String> child : children.entrySet())
+      {
+        String name = child.getKey();
+        if (name.endsWith("/"))
+          name = name.substring(0, name.length() - 1);
+        else
+          name = name.substring(0, name.length() - 6);
+        out.put(JPypeKeywords.wrap(name), toURI(child.getValue()));
+      }
+      return true;
+    }
+  }
+
+  /**
+   * Start indexing the classpath and runtime modules.
+   *
+   * This is called once when the context is created.
+   *
+   * @param classPath is the startup classpath.
+   * @param tasks are other startup scans to run on the same pool.
+   */
+  static public synchronized void start(String classPath, Runnable... tasks)
+  {
+    if (!sources.isEmpty() || !modules.isEmpty())
+      return;
+    String name = System.getProperty("org.jpype.pkgcache");
+    if (name != null && !name.isEmpty())
+      cachePath = Paths.get(name);
+
+    List<Source> all = new ArrayList<>();
+    if (classPath != null)
+    {
+      for (String entry : classPath.split(File.pathSeparator))
+      {
+        if (entry.isEmpty())
+          continue;
+        Path path = Paths.get(entry).toAbsolutePath().normalize();
+        // Directories are cheap to walk and may change, so skip them.
+        if (!Files.isRegularFile(path) || jars.containsKey(path))
+          continue;
+        Source source = new Source(path.toString(), path, false);
+        sources.add(source);
+        jars.put(path, source);
+        all.add(source);
+      }
+    }
+
+    try
+    {
+      FileSystem fs = FileSystems.getFileSystem(URI.create("jrt:/"));
+      String runtime = "jrt:" + System.getProperty("java.home")
+              + ":" + System.getProperty("java.runtime.version") + "/";
+      for (Path module : Files.newDirectoryStream(fs.getPath("modules")))
+      {
+        String moduleName = module.getFileName().toString();
+        Source source = new Source(runtime + moduleName, module, true);
+        modules.put(moduleName, source);
+        all.add(source);
+      }
+    } catch (RuntimeException | IOException ex)
+    {
+      // Java 8 has no module file system.
+    }
+
+    if (all.isEmpty())
+      complete = true;
+    if (all.isEmpty() && tasks.length == 0)
+      return;
+    remaining.set(all.size());
+    int threads = Math.max(1, Math.min(4, Runtime.getRuntime().availableProcessors()));
+    ExecutorService executor = Executors.newFixedThreadPool(threads, (Runnable r) ->
+    {
+      Thread th = new Thread(r, "JPype package index");
+      th.setDaemon(true);
+      return th;
+    });
+    for (Runnable task : tasks)
+    {
+      executor.execute(task);
+    }
+    for (Source source : all)
+    {
+      executor.execute(source.task);
+    }
+    // Workers exit once the queue drains.
+    executor.shutdown();
+  }
+
+  /**
+   * Get the number of lookups answered by the index.
+   *
+   * Each jar or module consulted counts once per lookup.
+   *
+   * @return the count since the JVM was started.
+   */
+  public static long getHits()
+  {
+    return hits.get();
+  }
+
+  /**
+   * Check if a name is a directory in any of the indexed jars.
+   *
+   * @param name is the package name with '/' separators.
+   * @return true if the name is found.
+   */
+  static boolean isPackage(String name)
+  {
+    if (name.isEmpty())
+      return false;
+    if (packages.contains(name))
+      return true;
+    if (complete)
+      return false;
+    for (Source source : sources)
+    {
+      source.get();
+    }
+    return packages.contains(name);
+  }
+
+  /**
+   * Check if a jar was indexed successfully.
+   *
+   * @param path is the location of the jar.
+   * @return true if the index covers the jar.
+   */
+  static boolean isIndexed(Path path)
+  {
+    Source source = jars.get(path);
+    return source != null && source.get() != null;
+  }
+
+  /**
+   * Collect the contents of a package from all indexed jars.
+   *
+   * @param out is the map to store the result in.
+   * @param packageName is the package name with '/' separators.
+   */
+  static void getJarContents(Map<String, URI> out, String packageName)
+  {
+    for (Source source : sources)
+    {
+      source.collect(out, packageName);
+    }
+  }
+
+  /**
+   * Collect the contents of a package in a module.
+   *
+   * @param out is the map to store the result in.
+   * @param module is the name of the module.
+   * @param packageName is the package name with '/' separators.
+   * @return false if the module is not indexed.
+   */
+  static boolean getModuleContents(Map<String, URI> out, String module, String packageName)
+  {
+    Source source = modules.get(module);
+    return source != null && source.collect(out, packageName);
+  }
+
+//<editor-fold desc="scan" defaultstate="collapsed">
+  static Map<String, Map<String, String>> scanJar(Path path) throws IOException
+  {
+    Map<String, Map<String, String>> out = new HashMap<>();
+    try (JarFile jf = new JarFile(path.toFile()))
+    {
+      Manifest manifest = jf.getManifest();
+      boolean multirelease = manifest != null
+              && "true".equalsIgnoreCase(manifest.getMainAttributes().getValue("Multi-Release"));
+      Map<String, Integer> versions = multirelease ? new HashMap<>() : null;
+      int feature = getFeatureVersion();
+      Enumeration<JarEntry> entries = jf.entries();
+      while (entries.hasMoreElements())
+      {
+        String entry = entries.nextElement().getName();
+        String name = entry;
+        int version = 0;
+        if (multirelease && entry.startsWith("META-INF/versions/"))
+        {
+          // Versioned entries overlay the base entries up to the running version.
+          int j = entry.indexOf('/', 18);
+          if (j == -1)
+            continue;
+          try
+          {
+            version = Integer.parseInt(entry.substring(18, j));
+          } catch (NumberFormatException ex)
+          {
+            continue;
+          }
+          if (version > feature)
+            continue;
+          name = entry.substring(j + 1);
+        }
+        addEntry(out, versions, name, entry, version);
+      }
+    }
+    return out;
+  }
+
+  static Map<String, Map<String, String>> scanModule(Path module) throws IOException
+  {
+    Map<String, Map<String, String>> out = new HashMap<>();
+    Files.walkFileTree(module, new SimpleFileVisitor<Path>()
+    {
+      @Override
+      public FileVisitResult preVisitDirectory(Path dir, BasicFileAttributes attrs)
+      {
+        if (!dir.equals(module))
+        {
+          String name = module.relativize(dir).toString() + "/";
+          addEntry(out, null, name, name, 0);
+        }
+        return FileVisitResult.CONTINUE;
+      }
+
+      @Override
+      public FileVisitResult visitFile(Path file, BasicFileAttributes attrs)
+      {
+        String name = module.relativize(file).toString();
+        addEntry(out, null, name, name, 0);
+        return FileVisitResult.CONTINUE;
+      }
+    });
+    return out;
+  }
+
+  private static void addEntry(Map<String, Map<String, String>> out,
+          Map<String, Integer> versions, String name, String entry, int version)
+  {
+    boolean directory = name.endsWith("/");
+    if (directory)
+      name = name.substring(0, name.length() - 1);
+    if (name.isEmpty())
+      return;
+    if (directory)
+    {
+      addDirectory(out, name);
+      return;
+    }
+    int i = name.lastIndexOf('/');
+    String parent = (i == -1) ? "" : name.substring(0, i);
+    String child = name.substring(i + 1);
+    addDirectory(out, parent);
+
+    // Skip inner classes and resources
+    if (child.indexOf('$') != -1 || !child.endsWith(".class"))
+      return;
+    if (versions != null)
+    {
+      Integer previous = versions.get(name);
+      if (previous != null && previous > version)
+        return;
+      versions.put(name, version);
+    }
+    out.get(parent).put(child, entry);
+  }
+
+  private static void addDirectory(Map<String, Map<String, String>> out, String dir)
+  {
+    // Jars are not required to hold directory entries, so create the parents.
+    if (out.containsKey(dir))
+      return;
+    out.put(dir, new HashMap<>());
+    if (dir.isEmpty())
+      return;
+    int i = dir.lastIndexOf('/');
+    String parent = (i == -1) ? "" : dir.substring(0, i);
+    addDirectory(out, parent);
+    out.get(parent).put(dir.substring(i + 1) + "/", dir + "/");
+  }
+
+  private static int getFeatureVersion()
+  {
+    String spec = System.getProperty("java.specification.version", "8");
+    if (spec.startsWith("1."))
+      spec = spec.substring(2);
+    try
+    {
+      return Integer.parseInt(spec);
+    } catch (NumberFormatException ex)
+    {
+      return 8;
+    }
+  }
+
+//</editor-fold>
+//<editor-fold desc="cache" defaultstate="collapsed">
+  private static synchronized Map<String, Map<String, String>> lookupCache(Source source)
+  {
+    if (cachePath == null)
+      return null;
+    if (cache == null)
+      cache = loadCache(cachePath);
+    Cached cached = cache.get(source.key);
+    if (cached == null || cached.size != source.size || cached.modified != source.modified)
+      return null;
+    return cached.contents;
+  }
+
+  private static Map<String, Cached> loadCache(Path path)
+  {
+    Map<String, Cached> out = new HashMap<>();
+    if (!Files.exists(path))
+      return out;
+    try (DataInputStream is = new DataInputStream(new BufferedInputStream(Files.newInputStream(path))))
+    {
+      if (is.readInt() != MAGIC || is.readInt() != VERSION)
+        return out;
+      int n = is.readInt();
+      for (int i = 0; i < n; ++i)
+      {
+        String key = is.readUTF();
+        Cached cached = new Cached();
+        cached.size = is.readLong();
+        cached.modified = is.readLong();
+        cached.contents = new HashMap<>();
+        int dirs = is.readInt();
+        for (int j = 0; j < dirs; ++j)
+        {
+          String dir = is.readUTF();
+          String prefix = dir.isEmpty() ? "" : dir + "/";
+          int m = is.readInt();
+          Map<String, String> children = new HashMap<>();
+          for (int k = 0; k < m; ++k)
+          {
+            String child = is.readUTF();
+            String entry = is.readUTF();
+            children.put(child, entry.isEmpty() ? prefix + child : entry);
+          }
+          cached.contents.put(dir, children);
+        }
+        out.put(key, cached);
+      }
+    } catch (IOException | RuntimeException ex)
+    {
+      // A corrupt cache is simply discarded.
+      out.clear();
+    }
+    return out;
+  }
+
+  /**
+   * Write the index of the current sources if anything was rescanned.
+   */
+  private static synchronized void saveCache()
+  {
+    if (cachePath == null || !dirty)
+      return;
+    List<Source> all = new ArrayList<>(sources);
+    all.addAll(modules.values());
+    try
+    {
+      Path parent = cachePath.toAbsolutePath().getParent();
+      if (parent != null)
+        Files.createDirectories(parent);
+      Path tmp = Files.createTempFile(parent, "pkgcache", ".tmp");
+      try (DataOutputStream os = new DataOutputStream(new BufferedOutputStream(Files.newOutputStream(tmp))))
+      {
+        int n = 0;
+        for (Source source : all)
+        {
+          if (source.contents != null)
+            n++;
+        }
+        os.writeInt(MAGIC);
+        os.writeInt(VERSION);
+        os.writeInt(n);
+        for (Source source : all)
+        {
+          if (source.contents == null)
+            continue;
+          os.writeUTF(source.key);
+          os.writeLong(source.size);
+          os.writeLong(source.modified);
+          os.writeInt(source.contents.size());
+          for (Map.Entry<String, Map<String, String>> dir : source.contents.entrySet())
+          {
+            String prefix = dir.getKey().isEmpty() ? "" : dir.getKey() + "/";
+            os.writeUTF(dir.getKey());
+            os.writeInt(dir.getValue().size());
+            for (Map.Entry<String, String> child : dir.getValue().entrySet())
+            {
+              os.writeUTF(child.getKey());
+              // Most entries are implied by the directory and name
+              String entry = child.getValue();
+              os.writeUTF(entry.equals(prefix + child.getKey()) ? "" : entry);
+            }
+          }
+        }
+      }
+      // Replace atomically so concurrent processes never see a partial file
+      Files.move(tmp, cachePath, StandardCopyOption.REPLACE_EXISTING);
+      dirty = false;
+    } catch (IOException | RuntimeException ex)
+    {
+      // The cache is only an optimization.
+    }
+  }
+//</editor-fold>
+}
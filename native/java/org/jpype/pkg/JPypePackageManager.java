@@ -71,7 +71,8 @@ public class JPypePackageManager
   {
     if (name.indexOf('.') != -1)
       name = name.replace(".", "/");
-    if (isModulePackage(name) || isBasePackage(name) || isJarPackage(name))
+    if (isModulePackage(name) || isBasePackage(name)
+            || JPypePackageIndex.isPackage(name) || isJarPackage(name))
       return true;
     return false;
   }
@@ -87,6 +88,7 @@ public class JPypePackageManager
     Map<String, URI> out = new HashMap<>();
     packageName = packageName.replace(".", "/");
     // We need to merge all the file systems into one view like the classloader
+    JPypePackageIndex.getJarContents(out, packageName);
     getJarContents(out, packageName);
     getBaseContents(out, packageName);
     getModuleContents(out, packageName);
@@ -279,6 +281,9 @@ public class JPypePackageManager
     {
       if (module.contains(search))
       {
+        // Use the background index if it covers the module
+        if (JPypePackageIndex.getModuleContents(out, module.name, name))
+          continue;
         Path path2 = module.modulePath.resolve(name);
         if (Files.isDirectory(path2))
           collectContents(out, path2);
@@ -298,10 +303,12 @@ public class JPypePackageManager
 
     List<String> contents = new ArrayList<>();
     private final Path modulePath;
+    private final String name;
 
     ModuleDirectory(Path module)
     {
       this.modulePath = module;
+      this.name = module.getFileName().toString();
       listPackages(contents, module, module, 0);
     }
 
@@ -385,6 +392,10 @@ public class JPypePackageManager
       {
         URI resource = resources.nextElement().toURI();
 
+        // Jars on the startup classpath are covered by the index
+        if (isIndexedJar(resource))
+          continue;
+
         // Handle MRJAR format
         //   MRJAR may not report every directory but instead just the overlay.
         //   So we need to find the original and interogate it first before
@@ -412,6 +423,24 @@ public class JPypePackageManager
     }
   }
 
+  private static boolean isIndexedJar(URI resource)
+  {
+    if (!resource.getScheme().equals("jar"))
+      return false;
+    String schemePart = resource.getSchemeSpecificPart();
+    int index = schemePart.indexOf("!");
+    if (index == -1)
+      return false;
+    try
+    {
+      Path jar = Paths.get(new URI(schemePart.substring(0, index)));
+      return JPypePackageIndex.isIndexed(jar.toAbsolutePath().normalize());
+    } catch (URISyntaxException | RuntimeException ex)
+    {
+      return false;
+    }
+  }
+
 //</editor-fold>
 //<editor-fold desc="utility" defaultstate="collapsed">
   /**
@@ -459,7 +488,7 @@ public class JPypePackageManager
     }
   }
 
-  private static URI toURI(Path path)
+  static URI toURI(Path path)
   {
     URI uri = path.toUri();
 
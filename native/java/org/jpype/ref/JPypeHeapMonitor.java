@@ -0,0 +1,142 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.ref;
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.util.concurrent.atomic.AtomicLong;
+import javax.management.NotificationEmitter;
+
+/**
+ * Java side of the garbage collection coordinator.
+ * <p>
+ * The C++ coordinator decides after each Python collection whether Java should
+ * also collect. This class supplies the Java heap figures for that decision in
+ * a single call, counts the collections Java performs on its own using the
+ * collector notifications, and runs requested collections on a daemon thread
+ * so that the Python thread is never blocked by a full collection.
+ * <p>
+ * The collector beans are only registered on first use so that processes
+ * using the default policy do not pay for starting the management support.
+ *
+ * @author nelson85
+ */
+public class JPypeHeapMonitor
+{
+
+  private static final Object lock = new Object();
+  private static final AtomicLong collections = new AtomicLong();
+  private static volatile long usedAfterCollection = 0;
+  private static boolean listening = false;
+  private static boolean pending = false;
+  private static Thread worker;
+
+  /**
+   * Get the current heap figures.
+   *
+   * @return used, committed, max, the number of collections observed, the
+   * total collection time in ms, and the heap used after the last collection.
+   */
+  public static long[] getHeapStats()
+  {
+    listen();
+    Runtime rt = Runtime.getRuntime();
+    long committed = rt.totalMemory();
+    long time = 0;
+    for (GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans())
+    {
+      long t = bean.getCollectionTime();
+      if (t > 0)
+        time += t;
+    }
+    return new long[]
+    {
+      committed - rt.freeMemory(), committed, rt.maxMemory(),
+      collections.get(), time, usedAfterCollection
+    };
+  }
+
+  /**
+   * Ask Java to collect without waiting for it.
+   * <p>
+   * Requests made while a collection is already pending are merged.
+   *
+   * @return true if a new collection was scheduled.
+   */
+  public static boolean requestCollection()
+  {
+    synchronized (lock)
+    {
+      if (pending)
+        return false;
+      pending = true;
+      if (worker == null)
+      {
+        worker = new Thread(JPypeHeapMonitor::run, "Python GC Coordinator");
+        worker.setDaemon(true);
+        worker.start();
+      }
+      lock.notifyAll();
+      return true;
+    }
+  }
+
+  private static void run()
+  {
+    while (true)
+    {
+      synchronized (lock)
+      {
+        try
+        {
+          while (!pending)
+          {
+            lock.wait();
+          }
+        } catch (InterruptedException ex)
+        {
+          worker = null;
+          return;
+        }
+      }
+      System.gc();
+      synchronized (lock)
+      {
+        pending = false;
+      }
+    }
+  }
+
+  private static void listen()
+  {
+    synchronized (lock)
+    {
+      if (listening)
+        return;
+      listening = true;
+    }
+    for (GarbageCollectorMXBean bean : ManagementFactory.getGarbageCollectorMXBeans())
+    {
+      if (!(bean instanceof NotificationEmitter))
+        continue;
+      ((NotificationEmitter) bean).addNotificationListener((notification, handback) ->
+      {
+        collections.incrementAndGet();
+        usedAfterCollection = ManagementFactory.getMemoryMXBean().getHeapMemoryUsage().getUsed();
+      }, null, null);
+    }
+  }
+}
@@ -0,0 +1,184 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.sql;
+
+import java.sql.ParameterMetaData;
+import java.sql.PreparedStatement;
+import java.sql.SQLException;
+import java.sql.Statement;
+import java.sql.Types;
+
+/**
+ * Columnar parameter binding for batched statements.
+ *
+ * The dbapi2 cursor binds parameters one cell at a time which costs a JNI
+ * call and an overload resolution per cell. This helper receives every
+ * column as a single Java array and runs the bind and addBatch loop entirely
+ * in Java.
+ */
+public class JPypeBatch
+{
+
+  private interface Binder
+  {
+
+    void bind(PreparedStatement ps, int row) throws SQLException;
+  }
+
+  /**
+   * Bind column arrays to a prepared statement and execute them as batches.
+   *
+   * Each entry in columns must be an array holding the values for one
+   * parameter. Primitive arrays are bound with the matching typed setter.
+   * String arrays use setString and other object arrays use setObject. Null
+   * entries in object arrays are bound with setNull.
+   *
+   * @param ps is the prepared statement.
+   * @param columns is an array of column arrays, one per parameter.
+   * @param batchSize is the number of rows per executeBatch call, or 0 to
+   * execute all rows as one batch.
+   * @return the total number of rows affected, or -1 if the driver did not
+   * report counts.
+   * @throws SQLException if the driver fails to bind or execute.
+   */
+  public static long execute(PreparedStatement ps, Object[] columns, int batchSize)
+          throws SQLException
+  {
+    int rows = -1;
+    Binder[] binders = new Binder[columns.length];
+    for (int i = 0; i < columns.length; ++i)
+    {
+      Object column = columns[i];
+      if (column == null || !column.getClass().isArray())
+        throw new IllegalArgumentException("column " + (i + 1) + " is not an array");
+      int length = java.lang.reflect.Array.getLength(column);
+      if (rows == -1)
+        rows = length;
+      else if (rows != length)
+        throw new IllegalArgumentException("column " + (i + 1) + " length mismatch ("
+                + length + "!=" + rows + ")");
+      binders[i] = createBinder(ps, i + 1, column);
+    }
+    if (rows <= 0)
+      return 0;
+    if (batchSize <= 0)
+      batchSize = rows;
+
+    long total = 0;
+    boolean known = true;
+    int pending = 0;
+    for (int row = 0; row < rows; ++row)
+    {
+      for (Binder binder : binders)
+      {
+        binder.bind(ps, row);
+      }
+      ps.addBatch();
+      pending++;
+      if (pending == batchSize || row == rows - 1)
+      {
+        for (int count : ps.executeBatch())
+        {
+          if (count == Statement.SUCCESS_NO_INFO || count < 0)
+            known = false;
+          else
+            total += count;
+        }
+        pending = 0;
+      }
+    }
+    return known ? total : -1;
+  }
+
+  private static Binder createBinder(PreparedStatement ps, int col, Object column)
+          throws SQLException
+  {
+    if (column instanceof int[])
+    {
+      final int[] v = (int[]) column;
+      return (p, r) -> p.setInt(col, v[r]);
+    }
+    if (column instanceof long[])
+    {
+      final long[] v = (long[]) column;
+      return (p, r) -> p.setLong(col, v[r]);
+    }
+    if (column instanceof double[])
+    {
+      final double[] v = (double[]) column;
+      return (p, r) -> p.setDouble(col, v[r]);
+    }
+    if (column instanceof float[])
+    {
+      final float[] v = (float[]) column;
+      return (p, r) -> p.setFloat(col, v[r]);
+    }
+    if (column instanceof short[])
+    {
+      final short[] v = (short[]) column;
+      return (p, r) -> p.setShort(col, v[r]);
+    }
+    if (column instanceof byte[])
+    {
+      final byte[] v = (byte[]) column;
+      return (p, r) -> p.setByte(col, v[r]);
+    }
+    if (column instanceof boolean[])
+    {
+      final boolean[] v = (boolean[]) column;
+      return (p, r) -> p.setBoolean(col, v[r]);
+    }
+    if (column instanceof char[])
+    {
+      final char[] v = (char[]) column;
+      return (p, r) -> p.setString(col, String.valueOf(v[r]));
+    }
+    if (column instanceof String[])
+    {
+      final String[] v = (String[]) column;
+      return (p, r) ->
+      {
+        if (v[r] == null)
+          p.setNull(col, Types.VARCHAR);
+        else
+          p.setString(col, v[r]);
+      };
+    }
+    final Object[] v = (Object[]) column;
+    final int sqlType = getNullType(ps, col);
+    return (p, r) ->
+    {
+      if (v[r] == null)
+        p.setNull(col, sqlType);
+      else
+        p.setObject(col, v[r]);
+    };
+  }
+
+  private static int getNullType(PreparedStatement ps, int col)
+  {
+    // Not all drivers track parameter types, so fall back to NULL.
+    try
+    {
+      ParameterMetaData meta = ps.getParameterMetaData();
+      if (meta != null)
+        return meta.getParameterType(col);
+    } catch (SQLException | RuntimeException ex)
+    {
+    }
+    return Types.NULL;
+  }
+}
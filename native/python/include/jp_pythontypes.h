@@ -354,6 +354,7 @@ public:
 	~JPPyCallRelease();
 private:
     PyThreadState* m_State1;
+	bool m_Profiled;
 } ;
 
 class JPPyBuffer
@@ -136,6 +136,7 @@ extern PyTypeObject *PyJPNumberLong_Type;
 extern PyTypeObject *PyJPNumberFloat_Type;
 extern PyTypeObject *PyJPNumberBool_Type;
 extern PyTypeObject *PyJPChar_Type;
+extern PyTypeObject *PyJPString_Type;
 
 
 // JPype resources
@@ -161,6 +162,18 @@ extern JPContext* JPContext_global;
 int        PyJPClass_Check(PyObject* obj);
 PyObject  *PyJPClass_FromSpecWithBases(PyType_Spec *spec, PyObject *bases);
 
+/**
+ * The storage appended to objects allocated by PyJPValue_alloc.
+ *
+ * The hash is only cached for instances of immutable classes and is -1
+ * until it has been computed.
+ */
+struct PyJPSlot
+{
+	JPValue value;
+	Py_hash_t hash;
+} ;
+
 // Class methods to add to the spec tables
 PyObject  *PyJPValue_alloc(PyTypeObject* type, Py_ssize_t nitems );
 void       PyJPValue_free(void* obj);
@@ -173,6 +186,7 @@ PyObject  *PyJPValue_str(PyObject* self);
 bool       PyJPValue_hasJavaSlot(PyTypeObject* type);
 Py_ssize_t PyJPValue_getJavaSlotOffset(PyObject* self);
 JPValue   *PyJPValue_getJavaSlot(PyObject* obj);
+Py_hash_t *PyJPValue_getHashSlot(PyObject* obj);
 
 // Access point for creating classes
 PyObject  *PyJPModule_getClass(PyObject* module, PyObject *obj);
@@ -194,6 +208,9 @@ JPPyObject PyJPNumber_create(JPJavaFrame &frame, JPPyObject& wrapper, const JPVa
 JPPyObject PyJPField_create(JPField* m);
 JPPyObject PyJPMethod_create(JPMethodDispatch *m, PyObject *instance);
 
+JPPyObject PyJPString_decode(JPJavaFrame &frame, jstring jstr, jsize start, jsize length);
+bool       PyJPString_equalsUTF16(PyObject *str, const jchar *chars, jsize length);
+
 JPClass*   PyJPClass_getJPClass(PyObject* obj);
 JPProxy*   PyJPProxy_getJPProxy(PyObject* obj);
 void       PyJPModule_rethrow(const JPStackInfo& info);
@@ -202,6 +219,18 @@ bool       PyJPValue_isSetJavaSlot(PyObject* self);
 JPPyObject PyTrace_FromJavaException(JPJavaFrame& frame, jthrowable th, jthrowable prev);
 void       PyJPException_normalize(JPJavaFrame frame, JPPyObject exc, jthrowable th, jthrowable enclosing);
 
+// Hooks for external tools on calls to Java methods
+typedef PyObject* (*PyJPCallFunc)(PyObject *self, PyObject *args, PyObject *kwargs);
+enum
+{
+	PyJPInstrument_PERF_MAP = 1,
+	PyJPInstrument_MONITORING = 2
+} ;
+extern std::atomic<int> PyJPInstrument_flags;
+PyObject*  PyJPInstrument_call(JPMethodDispatch *method, PyJPCallFunc func,
+		PyObject *self, PyObject *args, PyObject *kwargs);
+int        PyJPInstrument_supported();
+
 #define _ASSERT_JVM_RUNNING(context) assertJVMRunning((JPContext*)context, JP_STACKINFO())
 
 /**
@@ -392,6 +392,8 @@ void JPPyErr::restore(JPPyObject& exceptionClass, JPPyObject& exceptionValue, JP
 
 JPPyCallAcquire::JPPyCallAcquire()
 {
+	JP_COUNT(JPCOUNT_GIL_ACQUIRE);
+	JPCounterTimer timer(JPTIME_GIL_WAIT);
 	m_State = (long) PyGILState_Ensure();
 }
 
@@ -405,13 +407,24 @@ JPPyCallAcquire::~JPPyCallAcquire()
 JPPyCallRelease::JPPyCallRelease()
 {
 	// Release the lock and set the thread state to NULL
+	JP_COUNT(JPCOUNT_GIL_RELEASE);
+	// Sample once so both hooks agree if profiling is toggled during the call
+	m_Profiled = JPProfiler::isEnabled();
+	if (m_Profiled)
+		JPProfileSample::released();
 	m_State1 = PyEval_SaveThread();
 }
 
 JPPyCallRelease::~JPPyCallRelease()
 {
 	// Re-acquire the lock
-	PyEval_RestoreThread(m_State1);
+	JP_COUNT(JPCOUNT_GIL_ACQUIRE);
+	{
+		JPCounterTimer timer(JPTIME_GIL_WAIT);
+		PyEval_RestoreThread(m_State1);
+	}
+	if (m_Profiled)
+		JPProfileSample::acquired();
 }
 
 JPPyBuffer::JPPyBuffer(PyObject* obj, int flags)
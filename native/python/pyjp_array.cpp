@@ -192,6 +192,124 @@ static PyObject *PyJPArray_getItem(PyJPArray *self, PyObject *item)
 	JP_PY_CATCH(nullptr);
 }
 
+static PyObject *PyJPArray_toList(PyJPArray *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPArray_toList");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	if (self->m_Array == nullptr)
+		JP_RAISE(PyExc_ValueError, "Null array");
+	JPPyObject out = self->m_Array->getRange(0, self->m_Array->getLength());
+
+	// Convert nested arrays as well to match numpy
+	if (dynamic_cast<JPArrayClass*> (self->m_Array->getClass()->getComponentType()) != nullptr)
+	{
+		Py_ssize_t n = PyList_Size(out.get());
+		for (Py_ssize_t i = 0; i < n; ++i)
+		{
+			PyObject *item = PyList_GetItem(out.get(), i);
+			if (!PyObject_IsInstance(item, (PyObject*) PyJPArray_Type))
+				continue;
+			JPPyObject sub = JPPyObject::call(PyJPArray_toList((PyJPArray*) item, nullptr));
+			PyList_SetItem(out.get(), i, sub.keep());
+		}
+	}
+	return out.keep();
+	JP_PY_CATCH(nullptr);
+}
+
+/**
+ * Iterator over a Java array.
+ *
+ * Elements are converted in chunks so that each step of the iteration does
+ * not need to enter Java.  Changes made to the array by Java during the
+ * iteration may not be seen until the next chunk is fetched.
+ */
+struct PyJPArrayIter
+{
+	PyObject_HEAD
+	PyJPArray *m_Array;
+	PyObject *m_Chunk;
+	jsize m_Index;
+	Py_ssize_t m_Offset;
+} ;
+
+static const jsize PyJPArrayIter_chunk = 256;
+static PyTypeObject *PyJPArrayIter_Type = nullptr;
+
+static PyObject *PyJPArray_iter(PyJPArray *self)
+{
+	JP_PY_TRY("PyJPArray_iter");
+	PyJPModule_getContext();
+	if (self->m_Array == nullptr)
+		JP_RAISE(PyExc_ValueError, "Null array");
+	auto *iter = (PyJPArrayIter*) PyJPArrayIter_Type->tp_alloc(PyJPArrayIter_Type, 0);
+	JP_PY_CHECK();
+	Py_INCREF(self);
+	iter->m_Array = self;
+	iter->m_Chunk = nullptr;
+	iter->m_Index = 0;
+	iter->m_Offset = 0;
+	return (PyObject*) iter;
+	JP_PY_CATCH(nullptr);
+}
+
+static void PyJPArrayIter_dealloc(PyJPArrayIter *self)
+{
+	Py_CLEAR(self->m_Chunk);
+	Py_CLEAR(self->m_Array);
+	PyTypeObject *type = Py_TYPE(self);
+	type->tp_free(self);
+	Py_DECREF(type);
+}
+
+static PyObject *PyJPArrayIter_next(PyJPArrayIter *self)
+{
+	JP_PY_TRY("PyJPArrayIter_next");
+	if (self->m_Chunk != nullptr && self->m_Offset < PyList_GET_SIZE(self->m_Chunk))
+	{
+		PyObject *item = PyList_GET_ITEM(self->m_Chunk, self->m_Offset++);
+		Py_INCREF(item);
+		return item;
+	}
+	Py_CLEAR(self->m_Chunk);
+	if (self->m_Array == nullptr)
+		return nullptr;
+	JPArray *array = self->m_Array->m_Array;
+	jsize length = array->getLength();
+	if (self->m_Index >= length)
+	{
+		Py_CLEAR(self->m_Array);
+		return nullptr;
+	}
+	PyJPModule_getContext();
+	jsize n = length - self->m_Index;
+	if (n > PyJPArrayIter_chunk)
+		n = PyJPArrayIter_chunk;
+	self->m_Chunk = array->getRange(self->m_Index, n).keep();
+	self->m_Index += n;
+	self->m_Offset = 1;
+	PyObject *item = PyList_GET_ITEM(self->m_Chunk, 0);
+	Py_INCREF(item);
+	return item;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyType_Slot arrayIterSlots[] = {
+	{ Py_tp_dealloc,  (void*) PyJPArrayIter_dealloc},
+	{ Py_tp_iter,     (void*) PyObject_SelfIter},
+	{ Py_tp_iternext, (void*) PyJPArrayIter_next},
+	{0}
+};
+
+static PyType_Spec arrayIterSpec = {
+	"_jpype._JArrayIter",
+	sizeof (PyJPArrayIter),
+	0,
+	Py_TPFLAGS_DEFAULT,
+	arrayIterSlots
+};
+
 static int PyJPArray_assignSubscript(PyJPArray *self, PyObject *item, PyObject *value)
 {
 	JP_PY_TRY("PyJPArray_assignSubscript");
@@ -405,6 +523,12 @@ int PyJPArrayPrimitive_getBuffer(PyJPArray *self, Py_buffer *view, int flags)
 	JP_PY_CATCH(-1);
 }
 
+static const char *tolist_doc =
+		"Convert the Java array to a Python list\n"
+		"\n"
+		"Elements are converted in a single pass. Nested arrays are\n"
+		"converted recursively in the same way as ``numpy.ndarray.tolist``.\n";
+
 static const char *length_doc =
 		"Get the length of a Java array\n"
 		"\n"
@@ -413,6 +537,7 @@ static const char *length_doc =
 
 static PyMethodDef arrayMethods[] = {
 	{"__getitem__", (PyCFunction) (&PyJPArray_getItem), METH_O | METH_COEXIST, ""},
+	{"tolist", (PyCFunction) (&PyJPArray_toList), METH_NOARGS, tolist_doc},
 	{nullptr},
 };
 
@@ -429,6 +554,7 @@ static PyType_Slot arraySlots[] = {
 	{ Py_tp_methods,  (void*) &arrayMethods},
 	{ Py_mp_subscript, (void*) &PyJPArray_getItem},
 	{ Py_sq_length,   (void*) &PyJPArray_len},
+	{ Py_tp_iter,     (void*) &PyJPArray_iter},
 	{ Py_tp_getset,   (void*) &arrayGetSets},
 	{ Py_mp_ass_subscript, (void*) &PyJPArray_assignSubscript},
 #if PY_VERSION_HEX >= 0x03090000
@@ -503,6 +629,11 @@ void PyJPArray_initType(PyObject * module)
 	PyModule_AddObject(module, "_JArrayPrimitive",
 			(PyObject*) PyJPArrayPrimitive_Type);
 	JP_PY_CHECK();
+
+	PyJPArrayIter_Type = (PyTypeObject*) PyType_FromSpec(&arrayIterSpec);
+	JP_PY_CHECK();
+	PyModule_AddObject(module, "_JArrayIter", (PyObject*) PyJPArrayIter_Type);
+	JP_PY_CHECK();
 }
 
 JPPyObject PyJPArray_create(JPJavaFrame &frame, PyTypeObject *type, const JPValue & value)
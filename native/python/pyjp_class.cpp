@@ -26,6 +26,7 @@
 #include "jp_method.h"
 #include "jp_methoddispatch.h"
 #include "jp_primitive_accessor.h"
+#include "jp_stringtype.h"
 
 struct PyJPClass
 {
@@ -152,6 +153,12 @@ PyObject* PyJPClass_FromSpecWithBases(PyType_Spec *spec, PyObject *bases)
 			case Py_sq_length:
 				heap->as_sequence.sq_length = (lenfunc) slot->pfunc;
 				break;
+			case Py_sq_contains:
+				heap->as_sequence.sq_contains = (objobjproc) slot->pfunc;
+				break;
+			case Py_mp_length:
+				heap->as_mapping.mp_length = (lenfunc) slot->pfunc;
+				break;
 			case Py_mp_ass_subscript:
 				heap->as_mapping.mp_ass_subscript = (objobjargproc) slot->pfunc;
 				break;
@@ -221,6 +228,9 @@ PyObject* PyJPClass_FromSpecWithBases(PyType_Spec *spec, PyObject *bases)
 			case Py_tp_getset:
 				type->tp_getset = (PyGetSetDef*) slot->pfunc;
 				break;
+			case Py_tp_iter:
+				type->tp_iter = (getiterfunc) slot->pfunc;
+				break;
 #if PY_VERSION_HEX >= 0x03090000
 			case Py_bf_getbuffer:
 				type->tp_as_buffer->bf_getbuffer = (getbufferproc) slot->pfunc;
@@ -656,6 +666,31 @@ static int PyJPClass_setHints(PyObject *self, PyObject *value, PyObject *closure
 	JP_PY_CATCH(-1);
 }
 
+static PyObject *PyJPClass_immutable(PyJPClass *self, PyObject *closure)
+{
+	JP_PY_TRY("PyJPClass_immutable");
+	PyJPModule_getContext();
+	return PyBool_FromLong(self->m_Class->isImmutable());
+	JP_PY_CATCH(nullptr);
+}
+
+static int PyJPClass_setImmutable(PyObject *self, PyObject *value, PyObject *closure)
+{
+	JP_PY_TRY("PyJPClass_setImmutable", self);
+	PyJPModule_getContext();
+	if (value == nullptr)
+	{
+		PyErr_SetString(PyExc_AttributeError, "_immutable can't be deleted");
+		return -1;
+	}
+	int v = PyObject_IsTrue(value);
+	if (v == -1)
+		return -1;
+	((PyJPClass*) self)->m_Class->setImmutable(v == 1);
+	return 0;
+	JP_PY_CATCH(-1);
+}
+
 PyObject* PyJPClass_instancecheck(PyTypeObject *self, PyObject *test)
 {
 	// JInterface is a meta
@@ -1009,6 +1044,7 @@ static PyMethodDef classMethods[] = {
 static PyGetSetDef classGetSets[] = {
 	{"class_", (getter) PyJPClass_class, (setter) PyJPClass_setClass, ""},
 	{"_hints", (getter) PyJPClass_hints, (setter) PyJPClass_setHints, ""},
+	{"_immutable", (getter) PyJPClass_immutable, (setter) PyJPClass_setImmutable, ""},
 	{"__doc__", (getter) PyJPClass_getDoc, (setter) PyJPClass_setDoc, nullptr, nullptr},
 	{nullptr}
 };
@@ -1120,6 +1156,9 @@ JPPyObject PyJPClass_getBases(JPJavaFrame &frame, JPClass* cls)
 			baseType = JPPyObject::use((PyObject*) PyJPArrayPrimitive_Type);
 		else
 			baseType = JPPyObject::use((PyObject*) PyJPArray_Type);
+	} else if (cls == context->_java_lang_String)
+	{
+		baseType = JPPyObject::use((PyObject*) PyJPString_Type);
 	} else if (cls->getCanonicalName() == "java.lang.Comparable")
 	{
 		baseType = JPPyObject::use((PyObject*) PyJPComparable_Type);
@@ -0,0 +1,243 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_methoddispatch.h"
+#include <cinttypes>
+#include <cstring>
+#include <mutex>
+
+/*
+ * Hooks that let external tools see Java method calls by name.
+ *
+ * For perf, each method called is given a small trampoline in executable
+ * memory which calls the real entry point.  The address range of the
+ * trampoline is written to the perf map with the name of the method, so
+ * the native stack shows the method rather than PyJPMethod_call.  This is
+ * the technique CPython uses for Python frames.
+ *
+ * For sys.monitoring, each method is given an empty code object named for
+ * the class and method, and PY_START, PY_RETURN and PY_UNWIND are fired
+ * around the call.  The interpreter already fires CALL for the method
+ * object itself.
+ */
+
+std::atomic<int> PyJPInstrument_flags{0};
+
+typedef PyObject* (*PyJPTrampoline)(PyObject *self, PyObject *args, PyObject *kwargs, PyJPCallFunc func);
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define JP_HAVE_TRAMPOLINE
+#include <sys/mman.h>
+#include <unistd.h>
+
+extern "C" char jp_trampoline_start[];
+extern "C" char jp_trampoline_end[];
+
+// Calls the fourth argument with the first three, keeping a frame pointer
+// so that unwinders can walk through it.
+__asm__(
+		".pushsection .text\n"
+		".globl jp_trampoline_start\n"
+		".hidden jp_trampoline_start\n"
+		".globl jp_trampoline_end\n"
+		".hidden jp_trampoline_end\n"
+		".p2align 4\n"
+		"jp_trampoline_start:\n"
+#if defined(__x86_64__)
+		"endbr64\n"
+		"push %rbp\n"
+		"mov %rsp, %rbp\n"
+		"call *%rcx\n"
+		"pop %rbp\n"
+		"ret\n"
+#else
+		"hint #34\n"
+		"stp x29, x30, [sp, #-16]!\n"
+		"mov x29, sp\n"
+		"blr x3\n"
+		"ldp x29, x30, [sp], #16\n"
+		"ret\n"
+#endif
+		"jp_trampoline_end:\n"
+		".popsection\n"
+		);
+
+namespace
+{
+
+const size_t JP_TRAMPOLINE_SLOT = 32;
+const size_t JP_TRAMPOLINE_CHUNK = 1 << 16;
+
+std::mutex s_TrampolineLock;
+char *s_Chunk = nullptr;
+size_t s_ChunkUsed = JP_TRAMPOLINE_CHUNK;
+
+/**
+ * Get a new copy of the trampoline.
+ *
+ * Chunks are filled with copies and made executable before use, so memory
+ * is never writable and executable at once.  Trampolines are never freed.
+ */
+char* allocateTrampoline()
+{
+	size_t size = jp_trampoline_end - jp_trampoline_start;
+	std::lock_guard<std::mutex> guard(s_TrampolineLock);
+	if (s_ChunkUsed + JP_TRAMPOLINE_SLOT > JP_TRAMPOLINE_CHUNK)
+	{
+		void *mem = mmap(nullptr, JP_TRAMPOLINE_CHUNK, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mem == MAP_FAILED)
+			return nullptr;
+		char *chunk = (char*) mem;
+		for (size_t i = 0; i + JP_TRAMPOLINE_SLOT <= JP_TRAMPOLINE_CHUNK; i += JP_TRAMPOLINE_SLOT)
+			memcpy(chunk + i, jp_trampoline_start, size);
+		if (mprotect(chunk, JP_TRAMPOLINE_CHUNK, PROT_READ | PROT_EXEC) != 0)
+		{
+			munmap(chunk, JP_TRAMPOLINE_CHUNK);
+			return nullptr;
+		}
+		__builtin___clear_cache(chunk, chunk + JP_TRAMPOLINE_CHUNK);
+		s_Chunk = chunk;
+		s_ChunkUsed = 0;
+	}
+	char *out = s_Chunk + s_ChunkUsed;
+	s_ChunkUsed += JP_TRAMPOLINE_SLOT;
+	return out;
+}
+
+void writePerfMap(const void *addr, size_t size, const string &name)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+	// Shares the file and its lock with the Python trampoline
+	PyUnstable_WritePerfMapEntry(addr, (unsigned int) size, name.c_str());
+#else
+	static FILE *map = nullptr;
+	if (map == nullptr)
+	{
+		char filename[64];
+		snprintf(filename, sizeof (filename), "/tmp/perf-%d.map", (int) getpid());
+		map = fopen(filename, "a");
+		if (map == nullptr)
+			return;
+	}
+	fprintf(map, "%" PRIxPTR " %zx %s\n", (uintptr_t) addr, size, name.c_str());
+	fflush(map);
+#endif
+}
+
+PyJPTrampoline getTrampoline(JPMethodDispatch *method)
+{
+	void *trampoline = method->getTrampoline();
+	if (trampoline != nullptr)
+		return (PyJPTrampoline) trampoline;
+	char *code = allocateTrampoline();
+	if (code == nullptr)
+		return nullptr;
+	string name = "java::" + method->getClass()->getCanonicalName() + "." + method->getName();
+	writePerfMap(code, jp_trampoline_end - jp_trampoline_start, name);
+	method->setTrampoline(code);
+	return (PyJPTrampoline) code;
+}
+
+}
+#endif
+
+#if PY_VERSION_HEX >= 0x030D0000
+#define JP_HAVE_MONITORING
+
+namespace
+{
+
+const uint8_t s_Events[] = {
+	PY_MONITORING_EVENT_PY_START,
+	PY_MONITORING_EVENT_PY_RETURN,
+	PY_MONITORING_EVENT_PY_UNWIND
+};
+
+// All Java methods share one scope as they have no locations of their own
+PyMonitoringState s_State[3];
+uint64_t s_Version = 0;
+
+PyObject* getCode(JPMethodDispatch *method)
+{
+	JPPyObject &code = method->getCode();
+	if (code.isNull())
+	{
+		string cls = method->getClass()->getCanonicalName();
+		code = JPPyObject::call((PyObject*) PyCode_NewEmpty(cls.c_str(),
+				method->getName().c_str(), 0));
+	}
+	return code.get();
+}
+
+}
+#endif
+
+static PyObject* PyJPInstrument_invoke(JPMethodDispatch *method, PyJPCallFunc func,
+		PyObject *self, PyObject *args, PyObject *kwargs)
+{
+#ifdef JP_HAVE_TRAMPOLINE
+	if (PyJPInstrument_flags & PyJPInstrument_PERF_MAP)
+	{
+		PyJPTrampoline trampoline = getTrampoline(method);
+		if (trampoline != nullptr)
+			return trampoline(self, args, kwargs, func);
+	}
+#endif
+	return func(self, args, kwargs);
+}
+
+PyObject* PyJPInstrument_call(JPMethodDispatch *method, PyJPCallFunc func,
+		PyObject *self, PyObject *args, PyObject *kwargs)
+{
+	JP_PY_TRY("PyJPInstrument_call");
+#ifdef JP_HAVE_MONITORING
+	if (PyJPInstrument_flags & PyJPInstrument_MONITORING)
+	{
+		if (PyMonitoring_EnterScope(s_State, &s_Version, s_Events, 3) < 0)
+			return nullptr;
+		PyObject *code = getCode(method);
+		PyObject *out = nullptr;
+		if (PyMonitoring_FirePyStartEvent(&s_State[0], code, 0) == 0)
+		{
+			out = PyJPInstrument_invoke(method, func, self, args, kwargs);
+			if (out != nullptr)
+			{
+				if (PyMonitoring_FirePyReturnEvent(&s_State[1], code, 0, out) < 0)
+					Py_CLEAR(out);
+			} else
+				PyMonitoring_FirePyUnwindEvent(&s_State[2], code, 0);
+		}
+		PyMonitoring_ExitScope();
+		return out;
+	}
+#endif
+	return PyJPInstrument_invoke(method, func, self, args, kwargs);
+	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
+}
+
+int PyJPInstrument_supported()
+{
+	int out = 0;
+#ifdef JP_HAVE_TRAMPOLINE
+	out |= PyJPInstrument_PERF_MAP;
+#endif
+#ifdef JP_HAVE_MONITORING
+	out |= PyJPInstrument_MONITORING;
+#endif
+	return out;
+}
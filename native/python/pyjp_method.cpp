@@ -87,9 +87,9 @@ static PyObject *PyJPMethod_get(PyJPMethod *self, PyObject *obj, PyObject *type)
 	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
 }
 
-static PyObject *PyJPMethod_call(PyJPMethod *self, PyObject *args, PyObject *kwargs)
+static PyObject *PyJPMethod_invokeWith(PyJPMethod *self, PyObject *args, bool numpy)
 {
-	JP_PY_TRY("PyJPMethod_call");
+	JP_PY_TRY("PyJPMethod_invoke");
 	JPContext *context = PyJPModule_getContext();
 	JPJavaFrame frame = JPJavaFrame::outer(context);
 	JP_TRACE(self->m_Method->getName());
@@ -100,16 +100,74 @@ static PyObject *PyJPMethod_call(PyJPMethod *self, PyObject *args, PyObject *kwa
 	if (self->m_Instance == nullptr)
 	{
 		JPPyObjectVector vargs(args);
-		out = self->m_Method->invoke(frame, vargs, false).keep();
+		out = self->m_Method->invoke(frame, vargs, false, numpy).keep();
 	} else
 	{
 		JPPyObjectVector vargs(self->m_Instance, args);
-		out = self->m_Method->invoke(frame, vargs, true).keep();
+		out = self->m_Method->invoke(frame, vargs, true, numpy).keep();
 	}
 	return out;
 	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
 }
 
+static PyObject *PyJPMethod_invoke(PyJPMethod *self, PyObject *args, PyObject *kwargs)
+{
+	return PyJPMethod_invokeWith(self, args, false);
+}
+
+static PyObject *PyJPMethod_invokeNumPy(PyJPMethod *self, PyObject *args, PyObject *kwargs)
+{
+	return PyJPMethod_invokeWith(self, args, true);
+}
+
+static PyObject *PyJPMethod_callNumPy(PyJPMethod *self, PyObject *args)
+{
+	// Instrumented the same as an ordinary call
+	if (PyJPInstrument_flags.load(std::memory_order_relaxed) != 0)
+		return PyJPInstrument_call(self->m_Method, (PyJPCallFunc) PyJPMethod_invokeNumPy,
+			(PyObject*) self, args, nullptr);
+	return PyJPMethod_invokeNumPy(self, args, nullptr);
+}
+
+static PyObject *PyJPMethod_call(PyJPMethod *self, PyObject *args, PyObject *kwargs)
+{
+	if (PyJPInstrument_flags.load(std::memory_order_relaxed) != 0)
+		return PyJPInstrument_call(self->m_Method, (PyJPCallFunc) PyJPMethod_invoke,
+			(PyObject*) self, args, kwargs);
+	return PyJPMethod_invoke(self, args, kwargs);
+}
+
+static PyObject *PyJPMethod_callAsync(PyJPMethod *self, PyObject *args)
+{
+	JP_PY_TRY("PyJPMethod_callAsync");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	JP_TRACE(self->m_Method->getName());
+	if (PyTuple_Size(args) < 2)
+		JP_RAISE(PyExc_TypeError, "future and executor are required");
+	PyObject *future = PyTuple_GetItem(args, 0);
+	PyObject *pyexecutor = PyTuple_GetItem(args, 1);
+	jobject executor = nullptr;
+	if (pyexecutor != Py_None)
+	{
+		JPValue *value = PyJPValue_getJavaSlot(pyexecutor);
+		if (value == nullptr)
+			JP_RAISE(PyExc_TypeError, "executor must be a java.util.concurrent.Executor");
+		executor = value->getJavaObject();
+	}
+	JPPyObject rest = JPPyObject::call(PyTuple_GetSlice(args, 2, PyTuple_Size(args)));
+	if (self->m_Instance == nullptr)
+	{
+		JPPyObjectVector vargs(rest.get());
+		return self->m_Method->invokeAsync(frame, vargs, false, future, executor).keep();
+	} else
+	{
+		JPPyObjectVector vargs(self->m_Instance, rest.get());
+		return self->m_Method->invokeAsync(frame, vargs, true, future, executor).keep();
+	}
+	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
+}
+
 static PyObject *PyJPMethod_matches(PyJPMethod *self, PyObject *args, PyObject *kwargs)
 {
 	JP_PY_TRY("PyJPMethod_matches");
@@ -235,6 +293,28 @@ int PyJPMethod_setDoc(PyJPMethod *self, PyObject *obj, void *ctxt)
 	JP_PY_CATCH(-1); // GCOVR_EXCL_LINE
 }
 
+PyObject *PyJPMethod_getNumPyReturn(PyJPMethod *self, void *ctxt)
+{
+	JP_PY_TRY("PyJPMethod_getNumPyReturn");
+	PyJPModule_getContext();
+	return PyBool_FromLong(self->m_Method->isNumPyReturn());
+	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
+}
+
+int PyJPMethod_setNumPyReturn(PyJPMethod *self, PyObject *obj, void *ctxt)
+{
+	JP_PY_TRY("PyJPMethod_setNumPyReturn");
+	PyJPModule_getContext();
+	if (obj == nullptr)
+		JP_RAISE(PyExc_AttributeError, "cannot delete _returnNumPy");
+	int v = PyObject_IsTrue(obj);
+	if (v == -1)
+		return -1;
+	self->m_Method->setNumPyReturn(v != 0);
+	return 0;
+	JP_PY_CATCH(-1); // GCOVR_EXCL_LINE
+}
+
 PyObject *PyJPMethod_getAnnotations(PyJPMethod *self, void *ctxt)
 {
 	JP_PY_TRY("PyJPMethod_getAnnotations");
@@ -346,6 +426,8 @@ static PyMethodDef methodMethods[] = {
 	{"matchReport", (PyCFunction) (&PyJPMethod_matchReport), METH_VARARGS, ""},
 	// This is  currently private but may be promoted
 	{"_matches", (PyCFunction) (&PyJPMethod_matches), METH_VARARGS, ""},
+	{"_callAsync", (PyCFunction) (&PyJPMethod_callAsync), METH_VARARGS, ""},
+	{"_callNumPy", (PyCFunction) (&PyJPMethod_callNumPy), METH_VARARGS, ""},
 	{nullptr},
 };
 
@@ -354,6 +436,7 @@ struct PyGetSetDef methodGetSet[] = {
 	{"__name__", (getter) (&PyJPMethod_getName), nullptr, nullptr, nullptr},
 	{"__doc__", (getter) (&PyJPMethod_getDoc), (setter) (&PyJPMethod_setDoc), nullptr, nullptr},
 	{"__annotations__", (getter) (&PyJPMethod_getAnnotations), (setter) (&PyJPMethod_setAnnotations), nullptr, nullptr},
+	{"_returnNumPy", (getter) (&PyJPMethod_getNumPyReturn), (setter) (&PyJPMethod_setNumPyReturn), nullptr, nullptr},
 	{"__closure__", (getter) (&PyJPMethod_getClosure), nullptr, nullptr, nullptr},
 	{"__code__", (getter) (&PyJPMethod_getCode), nullptr, nullptr, nullptr},
 	{"__defaults__", (getter) (&PyJPMethod_getNone), nullptr, nullptr, nullptr},
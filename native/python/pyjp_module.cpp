@@ -18,6 +18,7 @@
 #include "jp_arrayclass.h"
 #include "jp_primitive_accessor.h"
 #include "jp_gc.h"
+#include "jp_async.h"
 #include "jp_stringtype.h"
 #include "jp_classloader.h"
 
@@ -37,6 +38,7 @@ extern void PyJPNumber_initType(PyObject* module);
 extern void PyJPClassHints_initType(PyObject* module);
 extern void PyJPPackage_initType(PyObject* module);
 extern void PyJPChar_initType(PyObject* module);
+extern void PyJPString_initType(PyObject* module);
 extern void PyJPValue_initType(PyObject* module);
 
 static PyObject *PyJPModule_convertBuffer(JPPyBuffer& buffer, PyObject *dtype);
@@ -297,6 +299,10 @@ static PyObject* PyJPModule_shutdown(PyObject* obj, PyObject* pyargs, PyObject*
 	if (!PyArg_ParseTuple(pyargs, "bb", &destroyJVM, &freeJVM))
 		return nullptr;
 
+	// The string cache holds Python objects so it must be released while
+	// we still hold the GIL.
+	if (JPContext_global->_java_lang_String != nullptr)
+		JPContext_global->_java_lang_String->setCache(0, 0);
 	JPContext_global->shutdownJVM(destroyJVM, freeJVM);
 	Py_RETURN_NONE;
 	JP_PY_CATCH(nullptr);
@@ -518,6 +524,7 @@ static PyObject *PyJPModule_arrayFromBuffer(PyObject *module, PyObject *args, Py
 
 PyObject *PyJPModule_collect(PyObject* module, PyObject *obj)
 {
+	JP_PY_TRY("PyJPModule_collect");
 	JPContext* context = JPContext_global;
 	if (!context->isRunning())
 		Py_RETURN_NONE;
@@ -535,32 +542,419 @@ PyObject *PyJPModule_collect(PyObject* module, PyObject *obj)
 		context->m_GC->onEnd();
 	}
 	Py_RETURN_NONE;
+	JP_PY_CATCH(nullptr); // GCOVR_EXCL_LINE
+}
+
+static void PyJPModule_setStat(PyObject *out, const char *name, long long value)
+{
+	PyObject *res = PyLong_FromLongLong(value);
+	PyDict_SetItemString(out, name, res);
+	Py_DECREF(res);
 }
 
 // GCOVR_EXCL_START
 
 PyObject *PyJPModule_gcStats(PyObject* module, PyObject *obj)
 {
+	JP_PY_TRY("PyJPModule_gcStats");
 	JPContext *context = PyJPModule_getContext();
 	JPGCStats stats;
 	context->m_GC->getStats(stats);
 	PyObject *out = PyDict_New();
-	PyObject *res;
-	PyDict_SetItemString(out, "current", res = PyLong_FromSsize_t((Py_ssize_t)(stats.current_rss)));
-	Py_DECREF(res);
-	PyDict_SetItemString(out, "java", res = PyLong_FromSsize_t((Py_ssize_t)(stats.java_rss)));
-	Py_DECREF(res);
-	PyDict_SetItemString(out, "python", res = PyLong_FromSsize_t((Py_ssize_t)(stats.python_rss)));
-	Py_DECREF(res);
-	PyDict_SetItemString(out, "max", res = PyLong_FromSsize_t((Py_ssize_t)(stats.max_rss)));
-	Py_DECREF(res);
-	PyDict_SetItemString(out, "min", res = PyLong_FromSsize_t((Py_ssize_t)(stats.min_rss)));
+	PyJPModule_setStat(out, "current", stats.current_rss);
+	PyJPModule_setStat(out, "java", stats.java_rss);
+	PyJPModule_setStat(out, "python", stats.python_rss);
+	PyJPModule_setStat(out, "max", stats.max_rss);
+	PyJPModule_setStat(out, "min", stats.min_rss);
+	PyJPModule_setStat(out, "triggered", stats.python_triggered);
+	PyJPModule_setStat(out, "skipped", stats.skipped);
+	PyJPModule_setStat(out, "python_collections", stats.python_collections);
+	PyJPModule_setStat(out, "java_triggered", stats.java_triggered);
+	PyJPModule_setStat(out, "java_used", stats.java_used);
+	PyJPModule_setStat(out, "java_committed", stats.java_committed);
+	PyJPModule_setStat(out, "java_max", stats.java_max);
+	PyJPModule_setStat(out, "java_collections", stats.java_collections);
+	PyJPModule_setStat(out, "java_collection_time", stats.java_collection_time);
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+// GCOVR_EXCL_STOP
+
+static PyObject* PyJPModule_gcConfig(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_gcConfig");
+	JPContext *context = PyJPModule_getContext();
+	PyObject *update = nullptr;
+	if (!PyArg_ParseTuple(args, "|O!", &PyDict_Type, &update))
+		return nullptr;
+	JPGCConfig config = context->m_GC->getConfig();
+	if (update != nullptr)
+	{
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(update, &pos, &key, &value))
+		{
+			string name = JPPyString::asStringUTF8(key);
+			if (name == "policy")
+				config.policy = JPPyString::asStringUTF8(value);
+			else if (name == "delta")
+				config.delta = PyLong_AsLongLong(value);
+			else if (name == "heap_fraction")
+				config.heap_fraction = PyFloat_AsDouble(value);
+			else if (name == "interval")
+				config.interval = PyLong_AsLongLong(value);
+			else if (name == "async")
+				config.async = PyObject_IsTrue(value) == 1;
+			else
+			{
+				PyErr_Format(PyExc_KeyError, "Unknown gc setting '%s'", name.c_str());
+				return nullptr;
+			}
+			JP_PY_CHECK();
+		}
+		if (config.heap_fraction <= 0 || config.heap_fraction > 1)
+			JP_RAISE(PyExc_ValueError, "heap_fraction must be in (0, 1]");
+		if (config.delta < 0)
+			JP_RAISE(PyExc_ValueError, "delta must not be negative");
+		if (config.interval < 0)
+			JP_RAISE(PyExc_ValueError, "interval must not be negative");
+		context->m_GC->setConfig(config);
+	}
+
+	PyObject *out = PyDict_New();
+	PyObject *res = JPPyString::fromStringUTF8(config.policy).keep();
+	PyDict_SetItemString(out, "policy", res);
 	Py_DECREF(res);
-	PyDict_SetItemString(out, "triggered", res = PyLong_FromSsize_t((Py_ssize_t)(stats.python_triggered)));
+	PyJPModule_setStat(out, "delta", config.delta);
+	res = PyFloat_FromDouble(config.heap_fraction);
+	PyDict_SetItemString(out, "heap_fraction", res);
 	Py_DECREF(res);
+	PyJPModule_setStat(out, "interval", config.interval);
+	PyDict_SetItemString(out, "async", config.async ? Py_True : Py_False);
 	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_stringCache(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_stringCache");
+	JPContext *context = PyJPModule_getContext();
+	PyObject *update = nullptr;
+	if (!PyArg_ParseTuple(args, "|O!", &PyDict_Type, &update))
+		return nullptr;
+	JPStringType *type = context->_java_lang_String;
+	if (update != nullptr)
+	{
+		long long size = type->getCacheSize();
+		long long maxLength = type->getCacheMaxLength();
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(update, &pos, &key, &value))
+		{
+			string name = JPPyString::asStringUTF8(key);
+			if (name == "size")
+				size = PyLong_AsLongLong(value);
+			else if (name == "max_length")
+				maxLength = PyLong_AsLongLong(value);
+			else
+			{
+				PyErr_Format(PyExc_KeyError, "Unknown string cache setting '%s'", name.c_str());
+				return nullptr;
+			}
+			JP_PY_CHECK();
+		}
+		if (size < 0 || size > (1 << 24))
+			JP_RAISE(PyExc_ValueError, "size must be between 0 and 2**24");
+		if (maxLength < 0 || maxLength > (1 << 16))
+			JP_RAISE(PyExc_ValueError, "max_length must be between 0 and 2**16");
+		type->setCache((size_t) size, (jsize) maxLength);
+	}
+
+	PyObject *out = PyDict_New();
+	PyJPModule_setStat(out, "size", type->getCacheSize());
+	PyJPModule_setStat(out, "max_length", type->getCacheMaxLength());
+	PyJPModule_setStat(out, "hits", type->getCacheHits());
+	PyJPModule_setStat(out, "misses", type->getCacheMisses());
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_threadStats(PyObject* module, PyObject *obj)
+{
+	JP_PY_TRY("PyJPModule_threadStats");
+	JPContext *context = PyJPModule_getContext();
+	JPAttachStats stats;
+	context->getAttachStats(stats);
+	PyObject *out = PyDict_New();
+	PyJPModule_setStat(out, "attached", stats.attached);
+	PyJPModule_setStat(out, "attaches", stats.attaches);
+	PyJPModule_setStat(out, "detaches", stats.detaches);
+	PyJPModule_setStat(out, "auto_detaches", stats.auto_detaches);
+	PyJPModule_setStat(out, "attach_time", stats.attach_time);
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_counterConfig(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_counterConfig");
+	PyObject *update = nullptr;
+	if (!PyArg_ParseTuple(args, "|O!", &PyDict_Type, &update))
+		return nullptr;
+	bool enabled = JPCounters::isEnabled();
+	bool timing = JPCounters::isTiming();
+	if (update != nullptr)
+	{
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(update, &pos, &key, &value))
+		{
+			string name = JPPyString::asStringUTF8(key);
+			if (name == "enabled")
+				enabled = PyObject_IsTrue(value) == 1;
+			else if (name == "timing")
+				timing = PyObject_IsTrue(value) == 1;
+			else
+			{
+				PyErr_Format(PyExc_KeyError, "Unknown counter setting '%s'", name.c_str());
+				return nullptr;
+			}
+			JP_PY_CHECK();
+		}
+		JPCounters::setEnabled(enabled, timing);
+	}
+
+	PyObject *out = PyDict_New();
+	PyDict_SetItemString(out, "enabled", JPCounters::isEnabled() ? Py_True : Py_False);
+	PyDict_SetItemString(out, "timing", JPCounters::isTiming() ? Py_True : Py_False);
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_counterStats(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_counterStats");
+	int reset = 0;
+	if (!PyArg_ParseTuple(args, "|p", &reset))
+		return nullptr;
+	JPCounters::Snapshot stats;
+	JPCounters::snapshot(stats, reset != 0);
+	JPPyObject out = JPPyObject::call(PyDict_New());
+	for (int i = 0; i < JPCOUNT_SIZE; ++i)
+		PyJPModule_setStat(out.get(), JPCounters::getName((JPCounter) i), stats.counts[i]);
+
+	// Histograms use buckets of powers of two in nanoseconds
+	JPPyObject timers = JPPyObject::call(PyDict_New());
+	for (int i = 0; i < JPTIME_SIZE; ++i)
+	{
+		JPCounters::Histogram &h = stats.timers[i];
+		JPPyObject timer = JPPyObject::call(PyDict_New());
+		PyJPModule_setStat(timer.get(), "count", h.count);
+		PyJPModule_setStat(timer.get(), "total_ns", h.total);
+		JPPyObject buckets = JPPyObject::call(PyList_New(JPTIME_BUCKETS));
+		for (int j = 0; j < JPTIME_BUCKETS; ++j)
+			PyList_SetItem(buckets.get(), j, PyLong_FromUnsignedLongLong(h.buckets[j]));
+		PyDict_SetItemString(timer.get(), "buckets", buckets.get());
+		PyDict_SetItemString(timers.get(), JPCounters::getName((JPTimer) i), timer.get());
+	}
+	PyDict_SetItemString(out.get(), "timers", timers.get());
+	return out.keep();
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_profileConfig(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_profileConfig");
+	PyObject *update = nullptr;
+	if (!PyArg_ParseTuple(args, "|O!", &PyDict_Type, &update))
+		return nullptr;
+	bool enabled = JPProfiler::isEnabled();
+	long long interval = (long long) JPProfiler::getInterval();
+	if (update != nullptr)
+	{
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(update, &pos, &key, &value))
+		{
+			string name = JPPyString::asStringUTF8(key);
+			if (name == "enabled")
+				enabled = PyObject_IsTrue(value) == 1;
+			else if (name == "interval")
+				interval = PyLong_AsLongLong(value);
+			else
+			{
+				PyErr_Format(PyExc_KeyError, "Unknown profile setting '%s'", name.c_str());
+				return nullptr;
+			}
+			JP_PY_CHECK();
+		}
+		if (interval < 1)
+			JP_RAISE(PyExc_ValueError, "interval must be positive");
+		JPProfiler::setEnabled(enabled, (uint64_t) interval);
+	}
+
+	PyObject *out = PyDict_New();
+	PyDict_SetItemString(out, "enabled", JPProfiler::isEnabled() ? Py_True : Py_False);
+	PyJPModule_setStat(out, "interval", (long long) JPProfiler::getInterval());
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_profileStats(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_profileStats");
+	int reset = 0;
+	if (!PyArg_ParseTuple(args, "|p", &reset))
+		return nullptr;
+	JPPyObject out = JPPyObject::call(PyDict_New());
+	for (JPMethodProfile *profile : JPProfiler::getProfiles())
+	{
+		// Times are sums over the sampled calls
+		JPPyObject entry = JPPyObject::call(PyDict_New());
+		PyJPModule_setStat(entry.get(), "calls", profile->m_Calls);
+		PyJPModule_setStat(entry.get(), "cache_hits", profile->m_CacheHits);
+		PyJPModule_setStat(entry.get(), "sampled", profile->m_Sampled);
+		PyJPModule_setStat(entry.get(), "match_ns", profile->m_MatchTime);
+		PyJPModule_setStat(entry.get(), "convert_ns", profile->m_ConvertTime);
+		PyJPModule_setStat(entry.get(), "java_ns", profile->m_JavaTime);
+		PyJPModule_setStat(entry.get(), "return_ns", profile->m_ReturnTime);
+		JPPyObject key = JPPyObject::call(Py_BuildValue("(ss)",
+				profile->m_Class.c_str(), profile->m_Name.c_str()));
+		PyDict_SetItem(out.get(), key.get(), entry.get());
+		if (reset)
+			JPProfiler::reset(*profile);
+	}
+	return out.keep();
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_instrumentConfig(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_instrumentConfig");
+	PyObject *update = nullptr;
+	if (!PyArg_ParseTuple(args, "|O!", &PyDict_Type, &update))
+		return nullptr;
+	int flags = PyJPInstrument_flags;
+	if (update != nullptr)
+	{
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(update, &pos, &key, &value))
+		{
+			string name = JPPyString::asStringUTF8(key);
+			int flag;
+			if (name == "perf_map")
+				flag = PyJPInstrument_PERF_MAP;
+			else if (name == "monitoring")
+				flag = PyJPInstrument_MONITORING;
+			else
+			{
+				PyErr_Format(PyExc_KeyError, "Unknown instrument setting '%s'", name.c_str());
+				return nullptr;
+			}
+			int enable = PyObject_IsTrue(value);
+			JP_PY_CHECK();
+			if (enable && (PyJPInstrument_supported() & flag) == 0)
+			{
+				PyErr_Format(PyExc_NotImplementedError, "'%s' is not supported on this platform", name.c_str());
+				return nullptr;
+			}
+			flags = enable ? (flags | flag) : (flags & ~flag);
+		}
+		PyJPInstrument_flags = flags;
+	}
+
+	PyObject *out = PyDict_New();
+	PyDict_SetItemString(out, "perf_map", (flags & PyJPInstrument_PERF_MAP) ? Py_True : Py_False);
+	PyDict_SetItemString(out, "monitoring", (flags & PyJPInstrument_MONITORING) ? Py_True : Py_False);
+	return out;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_asyncWakeup(PyObject* module, PyObject *fd)
+{
+	JP_PY_TRY("PyJPModule_asyncWakeup");
+	JPContext *context = PyJPModule_getContext();
+	long long value = PyLong_AsLongLong(fd);
+	JP_PY_CHECK();
+	context->m_Async->setWakeup(value);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_callbackWakeup(PyObject* module, PyObject *fd)
+{
+	JP_PY_TRY("PyJPModule_callbackWakeup");
+	JPContext *context = PyJPModule_getContext();
+	long long value = PyLong_AsLongLong(fd);
+	JP_PY_CHECK();
+	context->m_Async->setCallbackWakeup(value);
+	Py_RETURN_NONE;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_asyncWatch(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_asyncWatch");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	PyObject *future;
+	PyObject *stage;
+	if (!PyArg_ParseTuple(args, "OO", &future, &stage))
+		return nullptr;
+	JPValue *value = PyJPValue_getJavaSlot(stage);
+	if (value == nullptr || value->getValue().l == nullptr
+			|| !frame.IsInstanceOf(value->getJavaObject(),
+			frame.FindClass("java/util/concurrent/CompletionStage")))
+		JP_RAISE(PyExc_TypeError, "java.util.concurrent.CompletionStage is required");
+	jlong token = context->m_Async->newToken(future, context->_java_lang_Object);
+	try
+	{
+		context->m_Async->watch(frame, token, value->getJavaObject());
+	} catch (...)
+	{
+		context->m_Async->releaseToken(token);
+		throw;
+	}
+	Py_RETURN_NONE;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_asyncDrain(PyObject* module, PyObject *obj)
+{
+	JP_PY_TRY("PyJPModule_asyncDrain");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	return context->m_Async->drain(frame).keep();
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_runCallbacks(PyObject* module, PyObject *args)
+{
+	JP_PY_TRY("PyJPModule_runCallbacks");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	double timeout = 0;
+	if (!PyArg_ParseTuple(args, "|d", &timeout))
+		return nullptr;
+	return PyLong_FromLong(context->m_Async->runCallbacks(frame, timeout));
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject* PyJPModule_serveCallbacks(PyObject* module, PyObject *enabled)
+{
+	JP_PY_TRY("PyJPModule_serveCallbacks");
+	JPContext *context = PyJPModule_getContext();
+	int add = PyObject_IsTrue(enabled);
+	JP_PY_CHECK();
+	return PyLong_FromLong(context->m_Async->setConsumer(add != 0));
+	JP_PY_CATCH(nullptr);
 }
-// GCOVR_EXCL_STOP
 
 static PyObject* PyJPModule_isPackage(PyObject *module, PyObject *pkg)
 {
@@ -616,7 +1010,7 @@ PyObject* examine(PyObject *module, PyObject *other)
 	printf("    alloc: %p\n", type->tp_alloc);
 	printf("    free: %p\n", type->tp_free);
 	printf("    finalize: %p\n", type->tp_finalize);
-	long v = _PyObject_VAR_SIZE(type, 1)+(PyJPValue_hasJavaSlot(type)?sizeof (JPValue):0);
+	long v = _PyObject_VAR_SIZE(type, 1)+(PyJPValue_hasJavaSlot(type)?sizeof (PyJPSlot):0);
 	printf("    size?: %ld\n",v);
 	printf("======\n");
 
@@ -684,9 +1078,23 @@ static PyMethodDef moduleMethods[] = {
 	{"_newArrayType", (PyCFunction) PyJPModule_newArrayType, METH_VARARGS, ""},
 	{"_collect", (PyCFunction) PyJPModule_collect, METH_VARARGS, ""},
 	{"gcStats", (PyCFunction) PyJPModule_gcStats, METH_NOARGS, ""},
+	{"gcConfig", (PyCFunction) PyJPModule_gcConfig, METH_VARARGS, ""},
+	{"counterConfig", (PyCFunction) PyJPModule_counterConfig, METH_VARARGS, ""},
+	{"counterStats", (PyCFunction) PyJPModule_counterStats, METH_VARARGS, ""},
+	{"profileConfig", (PyCFunction) PyJPModule_profileConfig, METH_VARARGS, ""},
+	{"profileStats", (PyCFunction) PyJPModule_profileStats, METH_VARARGS, ""},
+	{"instrumentConfig", (PyCFunction) PyJPModule_instrumentConfig, METH_VARARGS, ""},
+	{"stringCache", (PyCFunction) PyJPModule_stringCache, METH_VARARGS, ""},
 
 	// Threading
 	{"isThreadAttachedToJVM", (PyCFunction) PyJPModule_isThreadAttached, METH_NOARGS, ""},
+	{"threadStats", (PyCFunction) PyJPModule_threadStats, METH_NOARGS, ""},
+	{"_asyncWakeup", (PyCFunction) PyJPModule_asyncWakeup, METH_O, ""},
+	{"_asyncDrain", (PyCFunction) PyJPModule_asyncDrain, METH_NOARGS, ""},
+	{"_asyncWatch", (PyCFunction) PyJPModule_asyncWatch, METH_VARARGS, ""},
+	{"_runCallbacks", (PyCFunction) PyJPModule_runCallbacks, METH_VARARGS, ""},
+	{"_serveCallbacks", (PyCFunction) PyJPModule_serveCallbacks, METH_O, ""},
+	{"_callbackWakeup", (PyCFunction) PyJPModule_callbackWakeup, METH_O, ""},
 #ifndef ANDROID
 	{"attachThreadToJVM", (PyCFunction) PyJPModule_attachThread, METH_NOARGS, ""},
 	{"detachThreadFromJVM", (PyCFunction) PyJPModule_detachThread, METH_NOARGS, ""},
@@ -757,6 +1165,7 @@ PyMODINIT_FUNC PyInit__jpype()
 	PyJPClassHints_initType(module);
 	PyJPPackage_initType(module);
 	PyJPChar_initType(module);
+	PyJPString_initType(module);
 
 	_PyJPModule_trace = true;
 
@@ -27,14 +27,16 @@ struct PyJPMonitor
 {
 	PyObject_HEAD
 	JPMonitor *m_Monitor;
+	// Holds the reference used by the monitor
+	PyObject *m_Object;
 } ;
 
 static int PyJPMonitor_init(PyJPMonitor *self, PyObject *args)
 {
 	JP_PY_TRY("PyJPMonitor_init");
 	self->m_Monitor = nullptr;
+	self->m_Object = nullptr;
 	JPContext *context = PyJPModule_getContext();
-	JPJavaFrame frame = JPJavaFrame::outer(context);
 
 	PyObject* value;
 
@@ -66,7 +68,10 @@ static int PyJPMonitor_init(PyJPMonitor *self, PyObject *args)
 		return -1;
 	}
 
+	// The wrapper already owns a global reference, so the monitor borrows it
 	self->m_Monitor = new JPMonitor(context, v1->getValue().l);
+	self->m_Object = value;
+	Py_INCREF(value);
 	return 0;
 	JP_PY_CATCH(-1);
 }
@@ -74,6 +79,9 @@ static int PyJPMonitor_init(PyJPMonitor *self, PyObject *args)
 static void PyJPMonitor_dealloc(PyJPMonitor *self)
 {
 	JP_PY_TRY("PyJPMonitor_dealloc");
+	// A monitor left held must keep its object so the reference stays valid
+	if (self->m_Monitor == nullptr || !self->m_Monitor->isEntered())
+		Py_XDECREF(self->m_Object);
 	delete self->m_Monitor;
 	Py_TYPE(self)->tp_free(self);
 	JP_PY_CATCH(); // GCOVR_EXCL_LINE
@@ -91,7 +99,7 @@ static PyObject *PyJPMonitor_enter(PyJPMonitor *self, PyObject *args)
 	JP_PY_TRY("PyJPMonitor_enter");
 	JPContext *context = PyJPModule_getContext();
 	JPJavaFrame frame = JPJavaFrame::outer(context);
-	self->m_Monitor->enter();
+	self->m_Monitor->enter(frame);
 	Py_RETURN_NONE;
 	JP_PY_CATCH(nullptr);
 }
@@ -101,7 +109,7 @@ static PyObject *PyJPMonitor_exit(PyJPMonitor *self, PyObject *args)
 	JP_PY_TRY("PyJPMonitor_exit");
 	JPContext *context = PyJPModule_getContext();
 	JPJavaFrame frame = JPJavaFrame::outer(context);
-	self->m_Monitor->exit();
+	self->m_Monitor->exit(frame);
 	Py_RETURN_NONE;
 	JP_PY_CATCH(nullptr);
 }
@@ -203,14 +203,29 @@ static Py_hash_t PyJPObject_hash(PyObject *obj)
 {
 	JP_PY_TRY("PyJPObject_hash");
 	JPContext *context = PyJPModule_getContext();
-	JPJavaFrame frame = JPJavaFrame::outer(context);
 	JPValue *javaSlot = PyJPValue_getJavaSlot(obj);
 	if (javaSlot == nullptr)
 		return Py_TYPE(Py_None)->tp_hash(Py_None);
 	jobject o = javaSlot->getJavaObject();
 	if (o == nullptr)
 		return Py_TYPE(Py_None)->tp_hash(Py_None);
-	return frame.hashCode(o);
+
+	// The hash of an immutable object is only fetched once
+	Py_hash_t *cache = nullptr;
+	if (javaSlot->getClass()->isImmutable())
+	{
+		cache = PyJPValue_getHashSlot(obj);
+		if (*cache != -1)
+			return *cache;
+	}
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	Py_hash_t hash = frame.hashCode(o);
+	// -1 is reserved for errors
+	if (hash == -1)
+		hash = -2;
+	if (cache != nullptr)
+		*cache = hash;
+	return hash;
 	JP_PY_CATCH(0);
 }
 
@@ -37,7 +37,8 @@ static PyObject *PyJPProxy_new(PyTypeObject *type, PyObject *args, PyObject *kwa
 	PyObject *target;
 	PyObject *pyintf;
 	int convert = 0;
-	if (!PyArg_ParseTuple(args, "OO|p", &target, &pyintf, &convert))
+	int queued = 0;
+	if (!PyArg_ParseTuple(args, "OO|pp", &target, &pyintf, &convert, &queued))
 		return nullptr;
 
 	// Pack interfaces
@@ -68,6 +69,7 @@ static PyObject *PyJPProxy_new(PyTypeObject *type, PyObject *args, PyObject *kwa
 		self->m_Proxy = new JPProxyDirect(context, self, interfaces);
 	else
 		self->m_Proxy = new JPProxyIndirect(context, self, interfaces);
+	self->m_Proxy->setQueued(queued != 0);
 	self->m_Target = target;
 	self->m_Convert = (convert != 0);
 	Py_INCREF(target);
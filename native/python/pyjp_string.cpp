@@ -0,0 +1,604 @@
+/*****************************************************************************
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+   See NOTICE file for details.
+ *****************************************************************************/
+#include "jpype.h"
+#include "pyjp.h"
+#include "jp_stringtype.h"
+#include <algorithm>
+
+/**
+ * Base for java.lang.String.
+ *
+ * Java strings are immutable so a JString can act as a view of the text.
+ * Length, indexing, slicing, iteration, search and comparison with Python
+ * strings read the UTF-16 contents directly, as does the hash.  The full Python string is
+ * only decoded when it is required and is then cached on the instance.
+ */
+
+#if PY_VERSION_HEX >= 0x030e0000
+#define PyJP_HashBytes Py_HashBuffer
+#else
+#define PyJP_HashBytes _Py_HashBytes
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+PyTypeObject *PyJPString_Type = nullptr;
+
+static jstring PyJPString_get(PyObject *self)
+{
+	JPValue *value = PyJPValue_getJavaSlot(self);
+	if (value == nullptr)
+		JP_RAISE(PyExc_TypeError, "Not a Java value");
+	return (jstring) value->getValue().l;
+}
+
+static PyObject *PyJPString_cacheName = nullptr;
+
+/**
+ * Get the decoded string if we already have one.
+ *
+ * This never creates the instance dictionary, so a string that has not
+ * been decoded costs no allocation.
+ *
+ * @return a borrowed reference or null.
+ */
+static PyObject *PyJPString_getCache(PyObject *self)
+{
+#if PY_VERSION_HEX >= 0x030b0000
+	// Asking for the dict pointer would build a dict from the inline values.
+	if (PyType_HasFeature(Py_TYPE(self), Py_TPFLAGS_MANAGED_DICT))
+	{
+		PyObject *out = _PyObject_GenericGetAttrWithDict(self, PyJPString_cacheName, nullptr, 1);
+		if (out == nullptr)
+			return nullptr;
+		// The instance holds a reference
+		Py_DECREF(out);
+		return out;
+	}
+#endif
+	PyObject **dict = _PyObject_GetDictPtr(self);
+	if (dict == nullptr || *dict == nullptr)
+		return nullptr;
+	return PyDict_GetItem(*dict, PyJPString_cacheName);
+}
+
+static PyObject *PyJPString_str(PyObject *self)
+{
+	JP_PY_TRY("PyJPString_str");
+	PyObject *cache = PyJPString_getCache(self);
+	if (cache != nullptr)
+	{
+		Py_INCREF(cache);
+		return cache;
+	}
+	return PyJPValue_str(self);
+	JP_PY_CATCH(nullptr);
+}
+
+static Py_ssize_t PyJPString_len(PyObject *self)
+{
+	JP_PY_TRY("PyJPString_len");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		JP_RAISE(PyExc_TypeError, "null string has no length");
+	return frame.GetStringLength(jstr);
+	JP_PY_CATCH(-1);
+}
+
+static PyObject *PyJPString_charAt(JPJavaFrame &frame, jstring jstr, jsize i)
+{
+	jvalue v;
+	frame.GetStringRegion(jstr, i, 1, &v.c);
+	return frame.getContext()->_char->convertToPythonObject(frame, v, false).keep();
+}
+
+static PyObject *PyJPString_item(PyObject *self, Py_ssize_t i)
+{
+	JP_PY_TRY("PyJPString_item");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		JP_RAISE(PyExc_TypeError, "null string is not subscriptable");
+	// Negative indices have already been adjusted using the length
+	if (i < 0)
+		JP_RAISE(PyExc_IndexError, "Array index is negative");
+	if (i >= frame.GetStringLength(jstr))
+		JP_RAISE(PyExc_IndexError, "Array index exceeds length");
+	return PyJPString_charAt(frame, jstr, (jsize) i);
+	JP_PY_CATCH(nullptr);
+}
+
+static PyObject *PyJPString_getItem(PyObject *self, PyObject *item)
+{
+	JP_PY_TRY("PyJPString_getItem");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		JP_RAISE(PyExc_TypeError, "null string is not subscriptable");
+	jsize length = frame.GetStringLength(jstr);
+
+	if (PyIndex_Check(item))
+	{
+		Py_ssize_t i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+		if (i == -1 && PyErr_Occurred())
+			return nullptr;
+		if (i < 0)
+			i += length;
+		if (i < 0)
+			JP_RAISE(PyExc_IndexError, "Array index is negative");
+		if (i >= length)
+			JP_RAISE(PyExc_IndexError, "Array index exceeds length");
+		return PyJPString_charAt(frame, jstr, (jsize) i);
+	}
+
+	if (!PySlice_Check(item))
+	{
+		PyErr_Format(PyExc_TypeError, "string indices must be integers or slices, not %s",
+				Py_TYPE(item)->tp_name);
+		return nullptr;
+	}
+
+	// Slices index code points like str does.  They are served from the
+	// UTF-16 contents if nothing the slice depends on is a surrogate, as then
+	// code units and code points agree.  A forward slice with positive
+	// bounds only depends on the text before its end.
+	PyObject *cache = PyJPString_getCache(self);
+	Py_ssize_t start, stop, step;
+	if (PySlice_Unpack(item, &start, &stop, &step) < 0)
+		return nullptr;
+	if (cache == nullptr)
+	{
+		jsize end = length;
+		if (step > 0 && start >= 0 && stop >= 0 && stop < length)
+			end = (jsize) stop;
+		std::vector<jchar> buffer(end);
+		frame.GetStringRegion(jstr, 0, end, buffer.data());
+		bool surrogate = false;
+		for (jchar c : buffer)
+		{
+			if (c >= 0xd800 && c < 0xe000)
+			{
+				surrogate = true;
+				break;
+			}
+		}
+		if (!surrogate)
+		{
+			Py_ssize_t n = PySlice_AdjustIndices(end, &start, &stop, step);
+			if (step == 1)
+				return PyUnicode_FromKindAndData(PyUnicode_2BYTE_KIND, buffer.data() + start, n);
+			std::vector<jchar> out(n);
+			for (Py_ssize_t i = 0, j = start; i < n; ++i, j += step)
+				out[i] = buffer[j];
+			return PyUnicode_FromKindAndData(PyUnicode_2BYTE_KIND, out.data(), n);
+		}
+	}
+	JPPyObject str = JPPyObject::call(PyJPString_str(self));
+	return PyObject_GetItem(str.get(), item);
+	JP_PY_CATCH(nullptr);
+}
+
+/**
+ * Iterator over the characters of a string.
+ *
+ * Characters are fetched and converted in chunks so that each step of the
+ * iteration does not need to enter Java, without building every character
+ * up front.
+ */
+struct PyJPStringIter
+{
+	PyObject_HEAD
+	PyObject *m_String;
+	PyObject *m_Chunk;
+	jsize m_Index;
+	jsize m_Length;
+	Py_ssize_t m_Offset;
+} ;
+
+static const jsize PyJPStringIter_chunk = 256;
+static PyTypeObject *PyJPStringIter_Type = nullptr;
+
+static PyObject *PyJPString_iter(PyObject *self)
+{
+	JP_PY_TRY("PyJPString_iter");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		JP_RAISE(PyExc_TypeError, "null string is not iterable");
+	auto *iter = (PyJPStringIter*) PyJPStringIter_Type->tp_alloc(PyJPStringIter_Type, 0);
+	JP_PY_CHECK();
+	Py_INCREF(self);
+	iter->m_String = self;
+	iter->m_Chunk = nullptr;
+	iter->m_Index = 0;
+	iter->m_Length = frame.GetStringLength(jstr);
+	iter->m_Offset = 0;
+	return (PyObject*) iter;
+	JP_PY_CATCH(nullptr);
+}
+
+static void PyJPStringIter_dealloc(PyJPStringIter *self)
+{
+	Py_CLEAR(self->m_Chunk);
+	Py_CLEAR(self->m_String);
+	PyTypeObject *type = Py_TYPE(self);
+	type->tp_free(self);
+	Py_DECREF(type);
+}
+
+static PyObject *PyJPStringIter_next(PyJPStringIter *self)
+{
+	JP_PY_TRY("PyJPStringIter_next");
+	if (self->m_Chunk != nullptr && self->m_Offset < PyList_GET_SIZE(self->m_Chunk))
+	{
+		PyObject *item = PyList_GET_ITEM(self->m_Chunk, self->m_Offset++);
+		Py_INCREF(item);
+		return item;
+	}
+	Py_CLEAR(self->m_Chunk);
+	if (self->m_String == nullptr)
+		return nullptr;
+	if (self->m_Index >= self->m_Length)
+	{
+		Py_CLEAR(self->m_String);
+		return nullptr;
+	}
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jsize n = self->m_Length - self->m_Index;
+	if (n > PyJPStringIter_chunk)
+		n = PyJPStringIter_chunk;
+	jchar buffer[PyJPStringIter_chunk];
+	frame.GetStringRegion(PyJPString_get(self->m_String), self->m_Index, n, buffer);
+	JPPyObject chunk = JPPyObject::call(PyList_New(n));
+	for (jsize i = 0; i < n; ++i)
+	{
+		jvalue v;
+		v.c = buffer[i];
+		PyList_SET_ITEM(chunk.get(), i, context->_char->convertToPythonObject(frame, v, false).keep());
+	}
+	self->m_Chunk = chunk.keep();
+	self->m_Index += n;
+	self->m_Offset = 1;
+	PyObject *item = PyList_GET_ITEM(self->m_Chunk, 0);
+	Py_INCREF(item);
+	return item;
+	JP_PY_CATCH(nullptr);
+}
+
+static PyType_Slot stringIterSlots[] = {
+	{ Py_tp_dealloc,  (void*) PyJPStringIter_dealloc},
+	{ Py_tp_iter,     (void*) PyObject_SelfIter},
+	{ Py_tp_iternext, (void*) PyJPStringIter_next},
+	{0}
+};
+
+static PyType_Spec stringIterSpec = {
+	"_jpype._JStringIter",
+	sizeof (PyJPStringIter),
+	0,
+	Py_TPFLAGS_DEFAULT,
+	stringIterSlots
+};
+
+/**
+ * Compare the contents of a Java string with a Python string.
+ */
+static bool PyJPString_equals(JPJavaFrame &frame, jstring jstr, PyObject *other)
+{
+	// Check the length in UTF-16 code units before reading the contents
+	Py_ssize_t units = PyUnicode_GET_LENGTH(other);
+	if (PyUnicode_KIND(other) == PyUnicode_4BYTE_KIND)
+	{
+		auto *data = (Py_UCS4*) PyUnicode_DATA(other);
+		for (Py_ssize_t i = 0; i < PyUnicode_GET_LENGTH(other); ++i)
+		{
+			if (data[i] >= 0x10000)
+				units++;
+		}
+	}
+	jsize length = frame.GetStringLength(jstr);
+	if (units != length)
+		return false;
+
+	// Nothing in this section may call Java
+	JNIEnv *env = frame.getEnv();
+	const jchar *chars = env->GetStringCritical(jstr, nullptr);
+	if (chars == nullptr)
+		JP_RAISE(PyExc_MemoryError, "Unable to access string");
+	bool equal = PyJPString_equalsUTF16(other, chars, length);
+	env->ReleaseStringCritical(jstr, chars);
+	return equal;
+}
+
+static PyObject *PyJPString_compare(PyObject *self, PyObject *other, int op)
+{
+	JP_PY_TRY("PyJPString_compare");
+	if ((op == Py_EQ || op == Py_NE) && PyUnicode_Check(other))
+	{
+		JPContext *context = PyJPModule_getContext();
+		JPJavaFrame frame = JPJavaFrame::outer(context);
+		jstring jstr = PyJPString_get(self);
+		if (jstr == nullptr)
+			return PyBool_FromLong(op == Py_NE);
+		PyObject *cache = PyJPString_getCache(self);
+		if (cache != nullptr)
+			return PyObject_RichCompare(cache, other, op);
+		bool equal = PyJPString_equals(frame, jstr, other);
+		return PyBool_FromLong(equal == (op == Py_EQ));
+	}
+	return PyJPComparable_Type->tp_richcompare(self, other, op);
+	JP_PY_CATCH(nullptr);
+}
+
+/**
+ * Hash the contents of a Java string the same way as str.
+ *
+ * str hashes the bytes of its compact form, so the UTF-16 contents can be
+ * hashed directly if they fit in UCS-2, or after narrowing if they fit in
+ * Latin-1.
+ *
+ * @return the hash, or -1 if the string has surrogates.
+ */
+static Py_hash_t PyJPString_hashUTF16(JPJavaFrame &frame, jstring jstr)
+{
+	jsize length = frame.GetStringLength(jstr);
+	std::vector<Py_UCS1> narrow(length);
+
+	// Nothing in this section may call Java
+	JNIEnv *env = frame.getEnv();
+	const jchar *chars = env->GetStringCritical(jstr, nullptr);
+	if (chars == nullptr)
+		JP_RAISE(PyExc_MemoryError, "Unable to access string");
+	jchar max = 0;
+	bool surrogate = false;
+	for (jsize i = 0; i < length; ++i)
+	{
+		jchar c = chars[i];
+		if (c >= 0xd800 && c < 0xe000)
+		{
+			surrogate = true;
+			break;
+		}
+		if (c > max)
+			max = c;
+		narrow[i] = (Py_UCS1) c;
+	}
+	Py_hash_t hash = -1;
+	if (!surrogate && max >= 0x100)
+		hash = PyJP_HashBytes(chars, length * sizeof (jchar));
+	env->ReleaseStringCritical(jstr, chars);
+
+	if (!surrogate && max < 0x100)
+		hash = PyJP_HashBytes(narrow.data(), length);
+	return hash;
+}
+
+/**
+ * Get the UTF-16 code units of a Python or Java string.
+ *
+ * @return false if the object is not a string.
+ */
+static bool PyJPString_toUTF16(JPJavaFrame &frame, PyObject *obj, std::vector<jchar> &out)
+{
+	if (PyUnicode_Check(obj))
+	{
+		Py_ssize_t n = PyUnicode_GET_LENGTH(obj);
+		int kind = PyUnicode_KIND(obj);
+		void *data = PyUnicode_DATA(obj);
+		out.reserve(n);
+		for (Py_ssize_t i = 0; i < n; ++i)
+		{
+			Py_UCS4 c = PyUnicode_READ(kind, data, i);
+			if (c >= 0x10000)
+			{
+				c -= 0x10000;
+				out.push_back((jchar) (0xd800 + (c >> 10)));
+				out.push_back((jchar) (0xdc00 + (c & 0x3ff)));
+			} else
+				out.push_back((jchar) c);
+		}
+		return true;
+	}
+	JPValue *value = PyJPValue_getJavaSlot(obj);
+	if (value == nullptr || value->getClass() != frame.getContext()->_java_lang_String
+			|| value->getValue().l == nullptr)
+		return false;
+	auto jstr = (jstring) value->getValue().l;
+	out.resize(frame.GetStringLength(jstr));
+	frame.GetStringRegion(jstr, 0, (jsize) out.size(), out.data());
+	return true;
+}
+
+static int PyJPString_contains(PyObject *self, PyObject *other)
+{
+	JP_PY_TRY("PyJPString_contains");
+	JPContext *context = PyJPModule_getContext();
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		JP_RAISE(PyExc_TypeError, "null string is not a container");
+	PyObject *cache = PyJPString_getCache(self);
+	if (cache != nullptr && PyUnicode_Check(other))
+		return PyUnicode_Contains(cache, other);
+	std::vector<jchar> needle;
+	if (!PyJPString_toUTF16(frame, other, needle))
+	{
+		// Other CharSequences are left to String.contains
+		JPPyObject out = JPPyObject::call(PyObject_CallMethod(self, "contains", "O", other));
+		return PyObject_IsTrue(out.get());
+	}
+	jsize length = frame.GetStringLength(jstr);
+	if (needle.empty())
+		return 1;
+	if ((jsize) needle.size() > length)
+		return 0;
+
+	// A match in code units is a match in code points as UTF-16 can not
+	// match part way through a surrogate pair.  Nothing in this section may
+	// call Java.
+	JNIEnv *env = frame.getEnv();
+	const jchar *chars = env->GetStringCritical(jstr, nullptr);
+	if (chars == nullptr)
+		JP_RAISE(PyExc_MemoryError, "Unable to access string");
+	bool found = std::search(chars, chars + length, needle.begin(), needle.end()) != chars + length;
+	env->ReleaseStringCritical(jstr, chars);
+	return found;
+	JP_PY_CATCH(-1);
+}
+
+static Py_hash_t PyJPString_hash(PyObject *self)
+{
+	JP_PY_TRY("PyJPString_hash");
+	JPContext *context = PyJPModule_getContext();
+	jstring jstr = PyJPString_get(self);
+	if (jstr == nullptr)
+		return Py_TYPE(Py_None)->tp_hash(Py_None);
+	Py_hash_t *cache = PyJPValue_getHashSlot(self);
+	if (*cache != -1)
+		return *cache;
+
+	// Must agree with str so that a JString can be used as a key
+	JPJavaFrame frame = JPJavaFrame::outer(context);
+	Py_hash_t hash = PyJPString_hashUTF16(frame, jstr);
+	if (hash == -1)
+	{
+		JPPyObject str = JPPyObject::call(PyJPString_str(self));
+		hash = PyObject_Hash(str.get());
+		if (hash == -1)
+			return -1;
+	}
+	*cache = hash;
+	return hash;
+	JP_PY_CATCH(-1);
+}
+
+static PyType_Slot stringSlots[] = {
+	{Py_tp_str,         (void*) &PyJPString_str},
+	{Py_tp_richcompare, (void*) &PyJPString_compare},
+	{Py_tp_hash,        (void*) &PyJPString_hash},
+	{Py_tp_iter,        (void*) &PyJPString_iter},
+	{Py_sq_length,      (void*) &PyJPString_len},
+	{Py_sq_item,        (void*) &PyJPString_item},
+	{Py_sq_contains,    (void*) &PyJPString_contains},
+	{Py_mp_length,      (void*) &PyJPString_len},
+	{Py_mp_subscript,   (void*) &PyJPString_getItem},
+	{0}
+};
+
+static PyType_Spec stringSpec = {
+	"_jpype._JString",
+	0,
+	0,
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	stringSlots
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * Decode a range of a Java string.
+ *
+ * The UTF-16 contents are decoded directly rather than passing through
+ * modified UTF-8.  Unpaired surrogates are preserved.
+ */
+JPPyObject PyJPString_decode(JPJavaFrame &frame, jstring jstr, jsize start, jsize length)
+{
+	JP_COUNT(JPCOUNT_TO_PYTHON_STRING);
+	std::vector<jchar> buffer(length);
+	frame.GetStringRegion(jstr, start, length, buffer.data());
+	int byteorder = PY_LITTLE_ENDIAN ? -1 : 1;
+	return JPPyObject::call(PyUnicode_DecodeUTF16((const char*) buffer.data(),
+			2 * (Py_ssize_t) length, "surrogatepass", &byteorder));
+}
+
+/**
+ * Compare a Python string with UTF-16 code units.
+ *
+ * This does not call Python or Java so it may be used while holding a
+ * critical section.
+ */
+bool PyJPString_equalsUTF16(PyObject *str, const jchar *chars, jsize length)
+{
+	Py_ssize_t n = PyUnicode_GET_LENGTH(str);
+	void *data = PyUnicode_DATA(str);
+	switch (PyUnicode_KIND(str))
+	{
+		case PyUnicode_1BYTE_KIND:
+			if (n != length)
+				return false;
+			for (Py_ssize_t i = 0; i < n; ++i)
+				if (chars[i] != ((Py_UCS1*) data)[i])
+					return false;
+			return true;
+		case PyUnicode_2BYTE_KIND:
+			if (n != length)
+				return false;
+			for (Py_ssize_t i = 0; i < n; ++i)
+				if (chars[i] != ((Py_UCS2*) data)[i])
+					return false;
+			return true;
+		default:
+		{
+			Py_ssize_t j = 0;
+			for (Py_ssize_t i = 0; i < n; ++i)
+			{
+				Py_UCS4 c = ((Py_UCS4*) data)[i];
+				if (c >= 0x10000)
+				{
+					c -= 0x10000;
+					if (j + 1 >= length
+							|| chars[j] != 0xd800 + (c >> 10)
+							|| chars[j + 1] != 0xdc00 + (c & 0x3ff))
+						return false;
+					j += 2;
+				} else
+				{
+					if (j >= length || chars[j] != c)
+						return false;
+					j++;
+				}
+			}
+			return j == length;
+		}
+	}
+}
+
+void PyJPString_initType(PyObject* module)
+{
+	PyJPString_cacheName = PyUnicode_InternFromString("_jstr");
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+	JPPyObject bases = JPPyTuple_Pack(PyJPComparable_Type);
+	PyJPString_Type = (PyTypeObject*) PyJPClass_FromSpecWithBases(&stringSpec, bases.get());
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+	PyModule_AddObject(module, "_JString", (PyObject*) PyJPString_Type);
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+
+	PyJPStringIter_Type = (PyTypeObject*) PyType_FromSpec(&stringIterSpec);
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+	PyModule_AddObject(module, "_JStringIter", (PyObject*) PyJPStringIter_Type);
+	JP_PY_CHECK(); // GCOVR_EXCL_LINE
+}
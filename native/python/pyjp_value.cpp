@@ -63,7 +63,7 @@ PyObject* PyJPValue_alloc(PyTypeObject* type, Py_ssize_t nitems)
 		std::lock_guard<std::mutex> lock(mtx);
 		// Mutate the allocator type 
 		PyJPAlloc_Type->tp_flags = type->tp_flags;
-		PyJPAlloc_Type->tp_basicsize = type->tp_basicsize + sizeof (JPValue);
+		PyJPAlloc_Type->tp_basicsize = type->tp_basicsize + sizeof (PyJPSlot);
 		PyJPAlloc_Type->tp_itemsize = type->tp_itemsize;
 	
 		// Create a new allocation for the dummy type
@@ -142,6 +142,19 @@ JPValue* PyJPValue_getJavaSlot(PyObject* self)
 	return value;
 }
 
+/**
+ * Get the cached hash for an object with a Java slot.
+ *
+ * @return the hash slot or nullptr if the object has no Java slot.
+ */
+Py_hash_t* PyJPValue_getHashSlot(PyObject* self)
+{
+	Py_ssize_t offset = PyJPValue_getJavaSlotOffset(self);
+	if (offset == 0)
+		return nullptr;
+	return &((PyJPSlot*) (((char*) self) + offset))->hash;
+}
+
 void PyJPValue_free(void* obj)
 {
 	JP_PY_TRY("PyJPValue_free", obj);
@@ -216,9 +229,7 @@ PyObject* PyJPValue_str(PyObject* self)
 				return cache;
 			}
 			auto jstr = (jstring) value->getValue().l;
-			string str;
-			str = frame.toStringUTF8(jstr);
-			cache = JPPyString::fromStringUTF8(str).keep();
+			cache = PyJPString_decode(frame, jstr, 0, frame.GetStringLength(jstr)).keep();
 			PyDict_SetItemString(dict.get(), "_jstr", cache);
 			return cache;
 		}
@@ -305,22 +316,23 @@ void PyJPValue_assignJavaSlot(JPJavaFrame &frame, PyObject* self, const JPValue&
 	}
 	// GCOVR_EXCL_STOP
 
-	auto* slot = (JPValue*) (((char*) self) + offset);
+	auto* slot = (PyJPSlot*) (((char*) self) + offset);
 	// GCOVR_EXCL_START
 	// This is a sanity check that should never trigger in normal operations.
-	if (slot->getClass() != nullptr)
+	if (slot->value.getClass() != nullptr)
 	{
 		JP_RAISE(PyExc_SystemError, "Slot assigned twice");
 	}
 	// GCOVR_EXCL_STOP
+	slot->hash = -1;
 	JPClass* cls = value.getClass();
 	if (cls != nullptr && !cls->isPrimitive())
 	{
 		jvalue q;
 		q.l = frame.NewGlobalRef(value.getValue().l);
-		*slot = JPValue(cls, q);
+		slot->value = JPValue(cls, q);
 	} else
-		*slot = value;
+		slot->value = value;
 }
 
 bool PyJPValue_isSetJavaSlot(PyObject* self)
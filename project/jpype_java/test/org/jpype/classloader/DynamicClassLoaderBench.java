@@ -0,0 +1,97 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package org.jpype.classloader;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.jar.JarEntry;
+import java.util.jar.JarOutputStream;
+
+/**
+ * Startup benchmark for the DynamicClassLoader over a large classpath.
+ *
+ * Generates a set of jars, adds them to a loader, and times the lookups made
+ * while warming up. Usage: DynamicClassLoaderBench [jars] [entries].
+ */
+public class DynamicClassLoaderBench
+{
+
+  public static void main(String[] args) throws IOException
+  {
+    int jars = args.length > 0 ? Integer.parseInt(args[0]) : 500;
+    int entries = args.length > 1 ? Integer.parseInt(args[1]) : 200;
+    Path dir = Files.createTempDirectory("jpype-bench");
+    Path[] paths = new Path[jars];
+    for (int i = 0; i < jars; ++i)
+    {
+      paths[i] = dir.resolve("bench" + i + ".jar");
+      try (OutputStream os = Files.newOutputStream(paths[i]);
+              JarOutputStream jos = new JarOutputStream(os))
+      {
+        jos.putNextEntry(new JarEntry("bench/p" + i + "/"));
+        for (int j = 0; j < entries; ++j)
+        {
+          jos.putNextEntry(new JarEntry("bench/p" + i + "/R" + j + ".txt"));
+          jos.write(new byte[]
+          {
+            (byte) j
+          });
+        }
+      }
+    }
+
+    long t0 = System.nanoTime();
+    DynamicClassLoader cl = new DynamicClassLoader(ClassLoader.getSystemClassLoader());
+    for (Path path : paths)
+    {
+      cl.addFile(path);
+    }
+    long t1 = System.nanoTime();
+    int found = 0;
+    for (int i = 0; i < jars; ++i)
+    {
+      for (int j = 0; j < entries; j += 10)
+      {
+        if (cl.getResource("bench/p" + i + "/R" + j + ".txt") != null)
+          found++;
+      }
+    }
+    long t2 = System.nanoTime();
+    int missed = 0;
+    for (int i = 0; i < jars * 10; ++i)
+    {
+      if (cl.getResource("bench/missing/M" + i + ".class") == null)
+        missed++;
+    }
+    long t3 = System.nanoTime();
+
+    System.out.println("{\"jars\": " + jars
+            + ", \"entries\": " + entries
+            + ", \"add_ms\": " + (t1 - t0) / 1e6
+            + ", \"hit_ms\": " + (t2 - t1) / 1e6
+            + ", \"hits\": " + found
+            + ", \"miss_ms\": " + (t3 - t2) / 1e6
+            + ", \"misses\": " + missed + "}");
+
+    for (Path path : paths)
+    {
+      Files.deleteIfExists(path);
+    }
+    Files.deleteIfExists(dir);
+  }
+}
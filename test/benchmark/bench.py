@@ -0,0 +1,482 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+""" Microbenchmarks for the hot paths between Python and Java.
+
+The Java fixture ``jpype.bench.Bench`` is built with the test harness::
+
+    python setup.py test_java
+    python test/benchmark/bench.py --json build/bench.json
+
+Each case runs its operation in a loop which is calibrated to take at least
+``--min-time`` seconds, then repeated ``--repeat`` times.  The time per
+operation is reported in nanoseconds.  A previous result file can be passed
+with ``--compare`` to show the change for each case.
+"""
+import argparse
+import array
+import datetime
+import gc
+import json
+import pathlib
+import platform
+import statistics
+import sys
+import time
+
+import jpype
+
+_cases = []
+
+
+class Case(object):
+    def __init__(self, group, name, func, params, once):
+        self.group = group
+        self.name = name
+        self.func = func
+        self.params = params
+        self.once = once
+
+    @property
+    def key(self):
+        if not self.params:
+            return "%s.%s" % (self.group, self.name)
+        args = ",".join("%s=%s" % i for i in sorted(self.params.items()))
+        return "%s.%s[%s]" % (self.group, self.name, args)
+
+
+def bench(group, once=False, **grid):
+    """ Register a benchmark.
+
+    The function is called with the fixture class, the number of operations
+    to run and one value from each parameter in the grid.  It returns the
+    number of operations run if that differs from the number requested.
+
+    Args:
+        group (str): The group used to filter and report the case.
+        once (bool): The operation can only be run once, as with loading a
+          class, so the loop is not calibrated.
+        **grid: Lists of values for each parameter.
+    """
+    def register(func):
+        params = [{}]
+        for k, values in grid.items():
+            params = [dict(p, **{k: v}) for p in params for v in values]
+        for p in params:
+            _cases.append(Case(group, func.__name__, func, p, once))
+        return func
+    return register
+
+
+SIZES = [16, 1024, 65536]
+LENGTHS = [8, 256, 16384]
+CHARSETS = {
+    'ascii': 'abcdefgh',
+    'latin1': 'abc\xe9\xe8\xff\xe0z',
+    'bmp': 'ab中文Ж☃yz',
+    'astral': 'ab\U0001f600\U0001f601cd',
+}
+
+
+def text(charset, length):
+    s = CHARSETS[charset]
+    return (s * (length // len(s) + 1))[:length]
+
+
+# Calls
+@bench("call")
+def static0(Bench, n):
+    f = Bench.static0
+    for _ in range(n):
+        f()
+
+
+@bench("call")
+def static1(Bench, n):
+    f = Bench.static1
+    for _ in range(n):
+        f(1)
+
+
+@bench("call")
+def static2(Bench, n):
+    f = Bench.static2
+    for _ in range(n):
+        f(1, 2)
+
+
+@bench("call")
+def static4(Bench, n):
+    f = Bench.static4
+    for _ in range(n):
+        f(1, 2, 3, 4)
+
+
+@bench("call")
+def instance0(Bench, n):
+    f = Bench().call0
+    for _ in range(n):
+        f()
+
+
+@bench("call")
+def instance1(Bench, n):
+    f = Bench().call1
+    for _ in range(n):
+        f(1)
+
+
+@bench("call")
+def instance2(Bench, n):
+    f = Bench().call2
+    for _ in range(n):
+        f(1, 2)
+
+
+@bench("call")
+def instance4(Bench, n):
+    f = Bench().call4
+    for _ in range(n):
+        f(1, 2, 3, 4)
+
+
+@bench("call")
+def lookup(Bench, n):
+    b = Bench()
+    for _ in range(n):
+        b.call0()
+
+
+# Overload resolution
+@bench("overload")
+def cacheHit(Bench, n):
+    f = Bench.over
+    for _ in range(n):
+        f(1)
+
+
+@bench("overload")
+def cacheMiss(Bench, n):
+    f = Bench.over
+    args = [1, "s", 1.5, jpype.JObject(1), jpype.JArray(jpype.JInt)(1)]
+    for i in range(n):
+        f(args[i % 5])
+
+
+# Object returns
+@bench("return")
+def sameClass(Bench, n):
+    f = Bench.same
+    for _ in range(n):
+        f()
+
+
+@bench("return")
+def mixedClass(Bench, n):
+    f = Bench.object
+    for i in range(n):
+        f(i)
+
+
+# Fields
+@bench("field")
+def getInstance(Bench, n):
+    b = Bench()
+    for _ in range(n):
+        b.intField
+
+
+@bench("field")
+def setInstance(Bench, n):
+    b = Bench()
+    for _ in range(n):
+        b.intField = 1
+
+
+@bench("field")
+def getStatic(Bench, n):
+    for _ in range(n):
+        Bench.staticField
+
+
+@bench("field")
+def setStatic(Bench, n):
+    for _ in range(n):
+        Bench.staticField = 1
+
+
+@bench("field")
+def setObject(Bench, n):
+    b = Bench()
+    for _ in range(n):
+        b.objectField = "s"
+
+
+# Strings
+@bench("string", charset=list(CHARSETS), length=LENGTHS)
+def toJava(Bench, n, charset, length):
+    f = Bench.length
+    s = text(charset, length)
+    for _ in range(n):
+        f(s)
+
+
+@bench("string", charset=list(CHARSETS), length=LENGTHS)
+def toPython(Bench, n, charset, length):
+    f = Bench.string
+    js = jpype.JString(text(charset, length))
+    for _ in range(n):
+        # A new wrapper each time so the decoded text is not reused
+        str(f(js))
+
+
+@bench("string", length=LENGTHS)
+def hashed(Bench, n, length):
+    f = Bench.string
+    js = jpype.JString(text('ascii', length))
+    for _ in range(n):
+        f(js).__hash__()
+
+
+# Boxing
+@bench("boxing")
+def box(Bench, n):
+    f = Bench.boxed
+    for _ in range(n):
+        f(1)
+
+
+@bench("boxing")
+def boxObject(Bench, n):
+    f = Bench.boxedObject
+    for _ in range(n):
+        f(1)
+
+
+@bench("boxing")
+def unbox(Bench, n):
+    f = Bench.unboxed
+    i = jpype.JObject(1, jpype.java.lang.Integer)
+    for _ in range(n):
+        f(i)
+
+
+@bench("boxing")
+def toInt(Bench, n):
+    i = jpype.JObject(1, jpype.java.lang.Integer)
+    for _ in range(n):
+        int(i)
+
+
+# Arrays
+@bench("array", size=SIZES)
+def sliced(Bench, n, size):
+    a = Bench.ints(size)
+    for _ in range(n):
+        a[:]
+
+
+@bench("array", size=SIZES)
+def indexed(Bench, n, size):
+    a = Bench.ints(size)
+    for i in range(n):
+        a[i % size]
+
+
+@bench("array", size=SIZES)
+def bufferToPython(Bench, n, size):
+    a = Bench.doubles(size)
+    for _ in range(n):
+        memoryview(a).tobytes()
+
+
+@bench("array", size=SIZES)
+def bufferToJava(Bench, n, size):
+    cls = jpype.JArray(jpype.JInt)
+    a = array.array('i', range(size))
+    for _ in range(n):
+        cls(a)
+
+
+@bench("array", size=SIZES)
+def sequenceToJava(Bench, n, size):
+    f = Bench.sum
+    a = list(range(size))
+    for _ in range(n):
+        f(a)
+
+
+# Proxies
+@bench("proxy")
+def callback(Bench, n):
+    Bench.callback(lambda i: i, n)
+
+
+@bench("proxy")
+def implements(Bench, n):
+    f = Bench.callback
+    for _ in range(n):
+        f(lambda i: i, 1)
+
+
+# Exceptions
+@bench("exception")
+def throwCatch(Bench, n):
+    f = Bench.fail
+    exc = jpype.java.lang.IllegalStateException
+    for _ in range(n):
+        try:
+            f()
+        except exc:
+            pass
+
+
+# Classes
+_unloaded = ["jpype.bench.Load%d" % i for i in range(8)]
+
+
+@bench("class", once=True)
+def firstLoad(Bench, n):
+    # Each run must see a class that has not been loaded
+    if not _unloaded:
+        return 0
+    jpype.JClass(_unloaded.pop(0))
+    return 1
+
+
+def measure(case, Bench, min_time, repeat):
+    """ Time a case and return the nanoseconds per operation for each run. """
+    def run(number):
+        gc.collect()
+        gc.disable()
+        try:
+            start = time.perf_counter_ns()
+            done = case.func(Bench, number, **case.params)
+            elapsed = time.perf_counter_ns() - start
+        finally:
+            gc.enable()
+        if done is None:
+            done = number
+        return elapsed, done
+
+    if case.once:
+        number = 1
+    else:
+        # Grow the loop until it takes long enough to time
+        number = 1
+        while True:
+            elapsed, done = run(number)
+            if elapsed >= min_time * 1e9 or number >= 1 << 30:
+                break
+            number = max(number * 2, int(number * min_time * 1.2e9 / max(elapsed, 1)))
+
+    samples = []
+    for _ in range(repeat):
+        elapsed, done = run(number)
+        if done == 0:
+            break
+        samples.append(elapsed / done)
+    return number, samples
+
+
+def metadata():
+    System = jpype.java.lang.System
+    return {
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "jpype": jpype.__version__,
+        "python": sys.version.split()[0],
+        "implementation": platform.python_implementation(),
+        "java": str(System.getProperty("java.version")),
+        "jvm": str(System.getProperty("java.vm.name")),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+    }
+
+
+def startJVM(args):
+    root = pathlib.Path(__file__).resolve().parent.parent
+    jpype.addClassPath(root / "classes")
+    jpype.addClassPath(pathlib.Path("lib/*").absolute())
+    jpype.addClassPath(root / "jar" / "*")
+    jvmargs = ["-Xmx256M"] + args.jvm_arg
+    jpype.startJVM(*jvmargs, convertStrings=False)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("-k", "--filter", action="append", default=[],
+                        help="only run cases whose name contains this text")
+    parser.add_argument("--list", action="store_true",
+                        help="list the cases and exit")
+    parser.add_argument("--repeat", type=int, default=5,
+                        help="number of timed runs for each case")
+    parser.add_argument("--min-time", type=float, default=0.05,
+                        help="minimum time for each run in seconds")
+    parser.add_argument("--json", metavar="FILE",
+                        help="write the results to a JSON file")
+    parser.add_argument("--compare", metavar="FILE",
+                        help="compare with a previous JSON result file")
+    parser.add_argument("--jvm-arg", action="append", default=[],
+                        help="extra argument for the JVM")
+    args = parser.parse_args(argv)
+
+    cases = [c for c in _cases
+             if not args.filter or any(f in c.key for f in args.filter)]
+    if args.list:
+        for case in cases:
+            print(case.key)
+        return 0
+
+    baseline = {}
+    if args.compare:
+        with open(args.compare) as fd:
+            baseline = {r["key"]: r for r in json.load(fd)["results"]}
+
+    startJVM(args)
+    Bench = jpype.JClass("jpype.bench.Bench")
+    results = []
+    for case in cases:
+        number, samples = measure(case, Bench, args.min_time, args.repeat)
+        if not samples:
+            continue
+        result = {
+            "key": case.key,
+            "group": case.group,
+            "name": case.name,
+            "params": case.params,
+            "number": number,
+            "repeat": len(samples),
+            "min_ns": min(samples),
+            "median_ns": statistics.median(samples),
+            "mean_ns": statistics.mean(samples),
+            "stdev_ns": statistics.stdev(samples) if len(samples) > 1 else 0.0,
+        }
+        results.append(result)
+        line = "%-48s %12.1f ns %10.1f ns" % (case.key, result["median_ns"], result["stdev_ns"])
+        previous = baseline.get(case.key)
+        if previous:
+            line += " %+8.1f%%" % (100.0 * (result["median_ns"] / previous["median_ns"] - 1))
+        print(line, flush=True)
+
+    if args.json:
+        with open(args.json, "w") as fd:
+            json.dump({"meta": metadata(), "results": results}, fd, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
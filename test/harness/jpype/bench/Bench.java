@@ -0,0 +1,186 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package jpype.bench;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.function.IntUnaryOperator;
+
+/**
+ * Fixture for the microbenchmarks in test/benchmark.
+ * <p>
+ * The methods do as little as possible so that the cost measured is that of
+ * crossing between Python and Java.
+ */
+public class Bench
+{
+
+  public static int staticField;
+  public int intField;
+  public Object objectField;
+
+  private static final Object[] OBJECTS = new Object[]
+  {
+    "string", 1, 2.0, new ArrayList<>(), new HashMap<>(), new int[1], new Bench(),
+    new StringBuilder()
+  };
+
+  // Calls by arity
+  public static void static0()
+  {
+  }
+
+  public static int static1(int a)
+  {
+    return a;
+  }
+
+  public static int static2(int a, int b)
+  {
+    return a;
+  }
+
+  public static int static4(int a, int b, int c, int d)
+  {
+    return a;
+  }
+
+  public void call0()
+  {
+  }
+
+  public int call1(int a)
+  {
+    return a;
+  }
+
+  public int call2(int a, int b)
+  {
+    return a;
+  }
+
+  public int call4(int a, int b, int c, int d)
+  {
+    return a;
+  }
+
+  // Overloads for resolution
+  public static int over(int a)
+  {
+    return 0;
+  }
+
+  public static int over(long a)
+  {
+    return 1;
+  }
+
+  public static int over(double a)
+  {
+    return 2;
+  }
+
+  public static int over(String a)
+  {
+    return 3;
+  }
+
+  public static int over(Object a)
+  {
+    return 4;
+  }
+
+  public static int over(int[] a)
+  {
+    return 5;
+  }
+
+  // Object returns with a declared type that does not match
+  public static Object object(int i)
+  {
+    return OBJECTS[i % OBJECTS.length];
+  }
+
+  public static Object same()
+  {
+    return OBJECTS[0];
+  }
+
+  // Strings
+  public static String string(String s)
+  {
+    return s;
+  }
+
+  public static int length(String s)
+  {
+    return s.length();
+  }
+
+  // Boxing
+  public static Integer boxed(Integer i)
+  {
+    return i;
+  }
+
+  public static int unboxed(int i)
+  {
+    return i;
+  }
+
+  public static Object boxedObject(Object o)
+  {
+    return o;
+  }
+
+  // Arrays
+  public static int[] ints(int n)
+  {
+    return new int[n];
+  }
+
+  public static double[] doubles(int n)
+  {
+    return new double[n];
+  }
+
+  public static int sum(int[] a)
+  {
+    int s = 0;
+    for (int i : a)
+    {
+      s += i;
+    }
+    return s;
+  }
+
+  // Callbacks
+  public static int callback(IntUnaryOperator op, int n)
+  {
+    int s = 0;
+    for (int i = 0; i < n; ++i)
+    {
+      s += op.applyAsInt(i);
+    }
+    return s;
+  }
+
+  // Exceptions
+  public static void fail()
+  {
+    throw new IllegalStateException("bench");
+  }
+}
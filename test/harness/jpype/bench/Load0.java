@@ -0,0 +1,40 @@
+/* ****************************************************************************
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  See NOTICE file for details.
+**************************************************************************** */
+package jpype.bench;
+
+/**
+ * Class that is not loaded until the first load benchmark asks for it.
+ * <p>
+ * The load classes are top level so that loading Bench does not load them
+ * as public inner classes.
+ */
+public class Load0
+{
+
+  public int a, b, c;
+
+  public void m0()
+  {
+  }
+
+  public void m1(int a)
+  {
+  }
+
+  public void m1(String a)
+  {
+  }
+}
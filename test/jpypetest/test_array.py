@@ -242,6 +242,47 @@ class ArrayTestCase(common.JPypeTestCase):
         for i in t.i:
             self.assertNotEqual(i, 0)
 
+    def testIterateChunks(self):
+        a = JArray(JInt)(list(range(1000)))
+        self.assertEqual(list(a), list(range(1000)))
+        self.assertEqual(list(a[999:0:-3]), list(range(999, 0, -3)))
+        self.assertEqual(list(a[::100]), list(range(0, 1000, 100)))
+        self.assertEqual(list(JArray(JInt)(0)), [])
+
+    def testIterateObjects(self):
+        a = JArray(JObject)([JInt(1), "a", None, JInt(2), "b"])
+        self.assertEqual([type(i) for i in a],
+                         [java.lang.Integer, java.lang.String, type(None), java.lang.Integer, java.lang.String])
+
+    def testToList(self):
+        self.assertEqual(JArray(JDouble)([1.5, 2.5]).tolist(), [1.5, 2.5])
+        self.assertEqual(JArray(JBoolean)([True, False]).tolist(), [True, False])
+        self.assertEqual(JArray(JString)(["a", None]).tolist(), ["a", None])
+        self.assertEqual(JArray(JInt)(list(range(10)))[1:8:2].tolist(), [1, 3, 5, 7])
+        self.assertEqual(JArray(JInt, 2)([[1, 2], [3, 4]]).tolist(), [[1, 2], [3, 4]])
+
+    def testSetStrings(self):
+        values = ["abc", "", "\u00e9t\u00e9", "\u4e2d\u6587", "\U0001f600x"]
+        a = JArray(JString)(len(values))
+        a[:] = values
+        self.assertEqual([str(i) for i in a], values)
+        self.assertEqual(a[4].length(), 3)
+        b = JArray(JObject)(6)
+        b[::2] = ["a", JInt(1), "b"]
+        self.assertEqual(b[0], "a")
+        self.assertIsInstance(b[2], java.lang.Integer)
+        self.assertEqual(b[4], "b")
+        self.assertEqual(b[1], None)
+        with self.assertRaises(TypeError):
+            a[0:2] = ["x", object()]
+
+    def testSetStringsLarge(self):
+        values = ["s%d" % i for i in range(100000)]
+        a = JArray(JString)(values)
+        self.assertEqual(a[0], "s0")
+        self.assertEqual(a[99999], "s99999")
+        self.assertEqual([str(i) for i in a[1000:1010]], values[1000:1010])
+
     def testGetSubclass(self):
         t = JClass("jpype.array.TestArray")()
         v = t.getSubClassArray()
@@ -358,6 +399,35 @@ class ArrayTestCase(common.JPypeTestCase):
         a[1:4] = ['x', 'y', 'z']
         self.assertEqual(list(a), ['a', 'x', 'y', 'z', 'e', 'f'])
 
+    def testPrimitiveSetRange(self):
+        import array
+        a = JArray(JInt)(list(range(40)))
+        a[2:5] = array.array('i', [-1, -2, -3])
+        self.assertEqual(list(a[0:6]), [0, 1, -1, -2, -3, 5])
+        a[10:16:2] = array.array('d', [1.5, 2.5, 3.5])
+        self.assertEqual(list(a[10:16]), [1, 11, 2, 13, 3, 15])
+        a[20:17:-1] = [7, 8, 9]
+        self.assertEqual(list(a[17:21]), [17, 9, 8, 7])
+        a[0:40:20] = array.array('b', [100, 101])
+        self.assertEqual((a[0], a[1], a[20], a[21]), (100, 1, 101, 21))
+        with self.assertRaises(OverflowError):
+            a[0:2] = [1, 2 ** 40]
+        self.assertEqual(a[0], 100)
+        b = JArray(JBoolean)(4)
+        b[:] = array.array('b', [0, 2, 0, -1])
+        self.assertEqual(list(b), [False, True, False, True])
+
+    def testObjectSetRangeFails(self):
+        a = JArray(JObject)(["a", "b", "c", "d"])
+        with self.assertRaises(OverflowError):
+            a[0:4] = [1, 2, 2 ** 70, 4]
+        self.assertEqual(list(a), ["a", "b", "c", "d"])
+        with self.assertRaises(OverflowError):
+            a[0:4:2] = ["x", 2 ** 70]
+        self.assertEqual(list(a), ["a", "b", "c", "d"])
+        a[0:4:2] = ["x", 1]
+        self.assertEqual(list(a), ["x", "b", 1, "d"])
+
     def checkArrayOf(self, jtype, dtype, mn=None, mx=None):
         if mn and mx:
             a = np.random.randint(mn, mx, size=100, dtype=dtype)
@@ -432,6 +502,19 @@ class ArrayTestCase(common.JPypeTestCase):
         self.assertIsInstance(ja, JArray(jtype))
         self.assertTrue(np.all(a.astype(dtype) == ja))
 
+    @common.requireNumpy
+    def testArrayOfLarge(self):
+        # Large enough to be split across worker threads
+        a = np.arange(64 * 3 * 8192, dtype=np.float64).reshape((64, 3, 8192))
+        ja = JArray.of(a)
+        self.assertIsInstance(ja, JArray(JDouble, 3))
+        self.assertEqual(ja[63][2][8191], a[63, 2, 8191])
+        self.assertTrue(np.all(a == ja))
+        b = a[::2, :, ::3]
+        self.assertTrue(np.all(b == JArray.of(b)))
+        c = a.astype(np.int32)
+        self.assertTrue(np.all(c == JArray.of(c)))
+
     @common.requireNumpy
     def testArrayOfBoolean(self):
         self.checkArrayOf(JBoolean, np.bool_, 0, 1)
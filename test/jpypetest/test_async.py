@@ -0,0 +1,136 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import asyncio
+import jpype
+import common
+
+
+class AsyncTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+
+    def testCallStatic(self):
+        Integer = jpype.JClass("java.lang.Integer")
+
+        async def run():
+            return await jpype.callAsync(Integer.parseInt, "123")
+        self.assertEqual(asyncio.run(run()), 123)
+
+    def testCallInstance(self):
+        s = jpype.JString("hello")
+
+        async def run():
+            return await jpype.callAsync(s.toUpperCase)
+        out = asyncio.run(run())
+        self.assertIsInstance(out, jpype.JString)
+        self.assertEqual(out, "HELLO")
+
+    def testCallVoid(self):
+        Thread = jpype.JClass("java.lang.Thread")
+
+        async def run():
+            return await jpype.callAsync(Thread.sleep, 10)
+        self.assertIsNone(asyncio.run(run()))
+
+    def testCallException(self):
+        Integer = jpype.JClass("java.lang.Integer")
+
+        async def run():
+            return await jpype.callAsync(Integer.parseInt, "x")
+        with self.assertRaises(jpype.JClass("java.lang.NumberFormatException")):
+            asyncio.run(run())
+
+    def testCallMany(self):
+        Integer = jpype.JClass("java.lang.Integer")
+
+        async def run():
+            futures = [jpype.callAsync(Integer.valueOf, i) for i in range(200)]
+            return await asyncio.gather(*futures)
+        self.assertEqual(list(asyncio.run(run())), list(range(200)))
+
+    def testCallExecutor(self):
+        Executors = jpype.JClass("java.util.concurrent.Executors")
+        executor = Executors.newSingleThreadExecutor()
+        Integer = jpype.JClass("java.lang.Integer")
+
+        async def run():
+            return await jpype.callAsync(Integer.parseInt, "7", executor=executor)
+        try:
+            self.assertEqual(asyncio.run(run()), 7)
+        finally:
+            executor.shutdown()
+
+    def testBadMethod(self):
+        async def run():
+            return await jpype.callAsync(len, "x")
+        with self.assertRaises(TypeError):
+            asyncio.run(run())
+
+    def testAwaitStage(self):
+        CompletableFuture = jpype.JClass("java.util.concurrent.CompletableFuture")
+
+        async def run():
+            return await CompletableFuture.supplyAsync(lambda: jpype.JString("done"))
+        self.assertEqual(asyncio.run(run()), "done")
+
+    def testAwaitCompleted(self):
+        CompletableFuture = jpype.JClass("java.util.concurrent.CompletableFuture")
+
+        async def run():
+            return await jpype.asFuture(CompletableFuture.completedFuture(jpype.JInt(5)))
+        self.assertEqual(asyncio.run(run()), 5)
+
+    def testAwaitFailed(self):
+        CompletableFuture = jpype.JClass("java.util.concurrent.CompletableFuture")
+        IllegalStateException = jpype.JClass("java.lang.IllegalStateException")
+
+        async def run():
+            f = CompletableFuture()
+            f.completeExceptionally(IllegalStateException("bad"))
+            return await f
+        with self.assertRaises(IllegalStateException):
+            asyncio.run(run())
+
+    def testAwaitMany(self):
+        CompletableFuture = jpype.JClass("java.util.concurrent.CompletableFuture")
+
+        async def run():
+            stages = [CompletableFuture() for i in range(1000)]
+            futures = [jpype.asFuture(s) for s in stages]
+            for i, s in enumerate(stages):
+                s.complete(jpype.JInt(i))
+            return await asyncio.gather(*futures)
+        self.assertEqual(list(asyncio.run(run())), list(range(1000)))
+
+    def testAsFutureBad(self):
+        async def run():
+            return jpype.asFuture(jpype.JString("x"))
+        with self.assertRaises(TypeError):
+            asyncio.run(run())
+
+    def testToCompletableFuture(self):
+        async def run():
+            future = asyncio.get_running_loop().create_future()
+            jfuture = jpype.toCompletableFuture(future)
+            future.set_result(jpype.JString("x"))
+            await asyncio.sleep(0)
+            return jfuture
+        jfuture = asyncio.run(run())
+        self.assertTrue(jfuture.isDone())
+        self.assertEqual(jfuture.get(), "x")
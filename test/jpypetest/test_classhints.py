@@ -105,6 +105,44 @@ class ClassHintsTestCase(common.JPypeTestCase):
         self.assertIsInstance(cht.input, self.MyCustom)
         self.assertIsInstance(cht.input.arg, MyImpl)
 
+    def testConvertAbcRegister(self):
+        import abc
+
+        class Marker(abc.ABC):
+            pass
+
+        class Plain:
+            pass
+
+        @jpype.JConversion(self.Custom, instanceof=Marker)
+        def MarkerToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        cht = self.ClassHintsTest
+        with self.assertRaises(TypeError):
+            cht.call(Plain())
+        # Registration after the type was seen must be honored
+        Marker.register(Plain)
+        cht.call(Plain())
+        self.assertIsInstance(cht.input.arg, Plain)
+
+    def testConvertAttributeInstance(self):
+        class Dynamic:
+            pass
+
+        @jpype.JConversion(self.Custom, attribute="_dynamic_marker")
+        def DynamicToCustom(jcls, args):
+            return self.MyCustom(args)
+
+        cht = self.ClassHintsTest
+        with self.assertRaises(TypeError):
+            cht.call(Dynamic())
+        # Attributes are tested on each object, not cached by type
+        obj = Dynamic()
+        obj._dynamic_marker = True
+        cht.call(obj)
+        self.assertIs(cht.input.arg, obj)
+
     def testClassCustomizer(self):
 
         @jpype.JConversion("java.lang.Class", instanceof=ClassProxy)
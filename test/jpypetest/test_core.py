@@ -57,3 +57,12 @@ class JCharTestCase(common.JPypeTestCase):
         th.start()
         th.join()
         self.assertTrue(run.rc)
+
+    def testPreloadPackages(self):
+        classes = jpype.preloadPackages("java.util.function")
+        self.assertIn(JClass("java.util.function.Function"), classes)
+        for cls in classes:
+            self.assertTrue(cls.class_.getName().startswith("java.util.function."))
+
+    def testPreloadPackagesMissing(self):
+        self.assertEqual(jpype.preloadPackages("no.such.package"), [])
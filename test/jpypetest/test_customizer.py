@@ -44,3 +44,27 @@ class CustomizerTestCase(common.JPypeTestCase):
         self.assertEqual(B.remove, _A.remove)
         self.assertEqual(str(A.remove_), "jpype.override.A.remove")
         self.assertEqual(str(B.remove_), "jpype.override.B.remove")
+
+    def testImmutable(self):
+        self.assertTrue(JClass("java.lang.String")._immutable)
+        self.assertTrue(JClass("java.lang.Integer")._immutable)
+        self.assertTrue(JClass("java.lang.Thread$State")._immutable)
+        self.assertFalse(JClass("java.util.ArrayList")._immutable)
+
+        Fixture = JClass("jpype.common.Fixture")
+        try:
+            @jpype.JImplementationFor("jpype.common.Fixture", immutable=True)
+            class _Fixture:
+                pass
+            self.assertTrue(Fixture._immutable)
+            self.assertEqual(hash(self.fixture), self.fixture.hashCode())
+            self.assertEqual(hash(self.fixture), hash(self.fixture))
+        finally:
+            # Fixture is shared with other tests which change its fields
+            jpype._jcustomizer.getClassHints("jpype.common.Fixture").immutable = False
+            Fixture._immutable = False
+
+    def testImmutableEnum(self):
+        State = JClass("java.lang.Thread$State")
+        self.assertEqual(hash(State.NEW), State.NEW.hashCode())
+        self.assertEqual({State.NEW: 1}[State.NEW], 1)
@@ -135,6 +135,20 @@ class JBooleanTestCase(common.JPypeTestCase):
         jarr[:] = a
         self.assertCountEqual(a, jarr)
 
+    @common.requireNumpy
+    def testSetFromNPBytesArray(self):
+        import numpy as np
+        # One byte formats that are not bool must not be copied raw
+        a = np.array([b"a", b"b"], dtype="S1")
+        jarr = jpype.JArray(jpype.JBoolean)(2)
+        with self.assertRaisesRegex(ValueError, "buffer type"):
+            jarr[:] = a
+        self.assertEqual(list(jarr), [False, False])
+        b = np.array([True, False, True], dtype=">?")
+        jarr = jpype.JArray(jpype.JBoolean)(3)
+        jarr[:] = b
+        self.assertEqual(list(jarr), [True, False, True])
+
     @common.requireNumpy
     def testArrayBufferDims(self):
         ja = JArray(JBoolean)(5)
@@ -311,3 +311,41 @@ class JMethodTestCase(common.JPypeTestCase):
         self.assertTrue(js.substring._matches(1))
         self.assertTrue(js.substring._matches(1, 2))
         self.assertFalse(js.substring._matches(1, 2, 3))
+
+    @common.requireNumpy
+    def testCallNumPy(self):
+        import numpy as np
+        Arrays = JClass("java.util.Arrays")
+        ja = JArray(JInt)([1, 2, 3])
+        out = jpype.callNumPy(Arrays.copyOf, ja, 5)
+        self.assertIsInstance(out, np.ndarray)
+        self.assertEqual(out.dtype, np.int32)
+        self.assertTrue(out.flags.owndata)
+        self.assertEqual(out.tolist(), [1, 2, 3, 0, 0])
+        out = jpype.callNumPy(JString("abc").toCharArray)
+        self.assertEqual(out.dtype, np.uint16)
+        self.assertEqual(out.tolist(), [97, 98, 99])
+        out = jpype.callNumPy(Arrays.copyOf, JArray(JBoolean)([True, False]), 2)
+        self.assertEqual(out.dtype, np.bool_)
+        self.assertEqual(out.tolist(), [True, False])
+        # Other returns are unchanged
+        self.assertIsInstance(jpype.callNumPy(JString("a,b").split, ","), JArray(JString))
+        self.assertIsInstance(jpype.callNumPy(Arrays.copyOf, JArray(JInt, 2)([[1]]), 1), JArray(JInt, 2))
+        self.assertEqual(jpype.callNumPy(JString("abc").length), 3)
+        with self.assertRaises(TypeError):
+            jpype.callNumPy(len, "abc")
+
+    @common.requireNumpy
+    def testReturnNumPy(self):
+        import numpy as np
+        cls = JClass("java.lang.String")
+        self.assertFalse(cls.toCharArray._returnNumPy)
+        jpype.returnNumPy(cls.toCharArray)
+        try:
+            self.assertTrue(JString("ab").toCharArray._returnNumPy)
+            out = JString("ab").toCharArray()
+            self.assertIsInstance(out, np.ndarray)
+            self.assertEqual(out.tolist(), [97, 98])
+        finally:
+            jpype.returnNumPy(cls.toCharArray, False)
+        self.assertIsInstance(JString("ab").toCharArray(), JArray(JChar))
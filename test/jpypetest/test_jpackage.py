@@ -74,3 +74,19 @@ class JPackageTestCase(common.JPypeTestCase):
         JL = JPackage("java.lng")
         with self.assertRaisesRegex(AttributeError, "Java package 'java.lng' is not valid"):
             getattr(JL, "foo")
+
+    def testIndex(self):
+        if jpype.getJVMVersion() < (9,):
+            raise common.unittest.SkipTest("runtime modules are not indexed on Java 8")
+        Index = JClass("org.jpype.pkg.JPypePackageIndex")
+        Package = JClass("org.jpype.pkg.JPypePackage")
+        start = Index.getHits()
+        first = Package("java.util.function")
+        middle = Index.getHits()
+        second = Package("java.util.function")
+        end = Index.getHits()
+        self.assertGreater(end - middle, 0)
+        self.assertEqual(end - middle, middle - start)
+        contents = set(str(i) for i in second.getContents())
+        self.assertEqual(set(str(i) for i in first.getContents()), contents)
+        self.assertIn("Function", contents)
@@ -104,6 +104,31 @@ class JStringTestCase(common.JPypeTestCase):
         a = jpype.JString("abc")
         self.assertTrue("ab" in a)
         self.assertFalse("cd" in a)
+        self.assertTrue("" in a)
+        self.assertTrue(jpype.JString("bc") in a)
+        self.assertFalse("abcd" in a)
+        with self.assertRaises(TypeError):
+            1 in a
+
+    def testContainsCharSequence(self):
+        a = jpype.JString("abc")
+        StringBuilder = jpype.JClass("java.lang.StringBuilder")
+        self.assertTrue(StringBuilder("bc") in a)
+        self.assertFalse(StringBuilder("cd") in a)
+
+    def testContainsUnicode(self):
+        a = jpype.JString("x\U0001f600中文")
+        self.assertTrue("\U0001f600" in a)
+        self.assertTrue("中" in a)
+        self.assertFalse("\U0001f601" in a)
+
+    def testIter(self):
+        a = jpype.JString("abc")
+        self.assertEqual(list(a), ["a", "b", "c"])
+        self.assertIsInstance(next(iter(a)), jpype.JChar)
+        self.assertEqual(list(reversed(a)), ["c", "b", "a"])
+        s = "".join(chr(65 + i % 26) for i in range(1000))
+        self.assertEqual("".join(jpype.JString(s)), s)
 
     def testHash(self):
         a = jpype.JString("abc")
@@ -181,3 +206,33 @@ class JStringTestCase(common.JPypeTestCase):
         self.assertEqual(s[:5], s2[:5])
         self.assertEqual(s[3:], s2[3:])
         self.assertEqual(s[::-1], s2[::-1])
+        self.assertEqual(s[1:10:3], s2[1:10:3])
+        self.assertEqual(s[-5:-1], s2[-5:-1])
+        self.assertEqual(s[-2:2:-2], s2[-2:2:-2])
+
+    def testSliceSurrogate(self):
+        s = 'ab\U0001f600cd'
+        s2 = JString(s)
+        self.assertEqual(len(s2), 6)
+        self.assertEqual(s2[0:2], 'ab')
+        self.assertEqual(s2[1:4], s[1:4])
+        self.assertEqual(s2[3:], s[3:])
+        self.assertEqual(str(s2), s)
+
+    def testEqUnicode(self):
+        for s in ['', 'abc', 'été', '中文', 'x\U0001f600']:
+            self.assertTrue(JString(s) == s)
+            self.assertFalse(JString(s) != s)
+            self.assertFalse(JString(s) == s + 'a')
+            self.assertTrue(JString(s + 'a') != s + 'b')
+        self.assertFalse(JString('\U0001f600') == '\U0001f601')
+        self.assertEqual(hash(JString('中文')), hash('中文'))
+
+    def testHashUnicode(self):
+        for s in ['', 'abc', 'été', '\xff', '中文', '\uffff', 'x\U0001f600']:
+            js = JString(s)
+            self.assertEqual(hash(js), hash(s))
+            # Cached on the second call
+            self.assertEqual(hash(js), hash(s))
+            self.assertEqual({s: 1}[js], 1)
+            self.assertEqual({js: 1}[s], 1)
@@ -74,6 +74,31 @@ class LegacyTestCase(unittest.TestCase):
         self.assertEqual(tuple(slc), tc[1:-1])
         self.assertIsInstance(slc[1], str)
 
+    def testStringCache(self):
+        import _jpype
+        String = jpype.JClass("java.lang.String")
+        String.valueOf(0)
+        orig = _jpype.stringCache()
+        try:
+            _jpype.stringCache({"size": 1, "max_length": 8})
+            first = String.valueOf(1234)
+            second = String.valueOf(1234)
+            self.assertIsInstance(first, str)
+            self.assertIs(first, second)
+            stats = _jpype.stringCache()
+            self.assertEqual((stats["hits"], stats["misses"]), (1, 1))
+            # A single slot only holds the latest value
+            self.assertEqual(String.valueOf(5678), "5678")
+            self.assertEqual(String.valueOf(1234), "1234")
+            stats = _jpype.stringCache()
+            self.assertEqual((stats["hits"], stats["misses"]), (1, 3))
+            # Strings longer than max_length bypass the cache
+            self.assertEqual(String.valueOf(123456789012), "123456789012")
+            stats = _jpype.stringCache()
+            self.assertEqual((stats["hits"], stats["misses"]), (1, 3))
+        finally:
+            _jpype.stringCache({"size": orig["size"], "max_length": orig["max_length"]})
+
     def testProxy(self):
         p = jpype.JProxy([self._intf], dict={'call': proxy})
         r = self._test().callProxy(p, "roundtrip")
@@ -103,6 +103,82 @@ class ModuleTestCase(common.JPypeTestCase):
         with self.assertRaises(TypeError):
             _jpype._hasClass(object())
 
+    def testGCConfig(self):
+        orig = _jpype.gcConfig()
+        try:
+            config = _jpype.gcConfig({"policy": "heap", "heap_fraction": 0.5, "async": False})
+            self.assertEqual(config["policy"], "heap")
+            self.assertEqual(config["heap_fraction"], 0.5)
+            self.assertFalse(config["async"])
+            with self.assertRaises(ValueError):
+                _jpype.gcConfig({"policy": "fred"})
+            with self.assertRaises(ValueError):
+                _jpype.gcConfig({"delta": -1})
+            with self.assertRaises(ValueError):
+                _jpype.gcConfig({"interval": -1})
+            with self.assertRaises(KeyError):
+                _jpype.gcConfig({"fred": 1})
+            self.assertEqual(_jpype.gcConfig()["policy"], "heap")
+        finally:
+            _jpype.gcConfig(orig)
+
+    def testStringCache(self):
+        orig = _jpype.stringCache()
+        self.assertEqual(orig["size"], 0)
+        try:
+            config = _jpype.stringCache({"size": 1000, "max_length": 32})
+            self.assertEqual(config["size"], 1024)
+            self.assertEqual(config["max_length"], 32)
+            self.assertEqual(config["hits"], 0)
+            # Strings which are not converted never reach the cache
+            if not self._convertStrings:
+                String = jpype.JClass("java.lang.String")
+                self.assertIsInstance(String.valueOf(1234), String)
+                self.assertEqual(_jpype.stringCache()["misses"], 0)
+            with self.assertRaises(ValueError):
+                _jpype.stringCache({"size": -1})
+            with self.assertRaises(KeyError):
+                _jpype.stringCache({"fred": 1})
+        finally:
+            _jpype.stringCache({"size": orig["size"], "max_length": orig["max_length"]})
+
+    def testGCStats(self):
+        stats = _jpype.gcStats()
+        self.assertGreater(stats["java_committed"], 0)
+        self.assertGreaterEqual(stats["java_used"], 0)
+        self.assertIn("skipped", stats)
+
+    def testCounters(self):
+        orig = _jpype.counterConfig()
+        try:
+            config = _jpype.counterConfig({"enabled": True, "timing": True})
+            self.assertTrue(config["enabled"])
+            self.assertTrue(config["timing"])
+            with self.assertRaises(KeyError):
+                _jpype.counterConfig({"fred": 1})
+            _jpype.counterStats(True)
+            Math = jpype.JClass("java.lang.Math")
+            for i in range(10):
+                Math.abs(i)
+            stats = _jpype.counterStats()
+            self.assertGreaterEqual(stats["jni_calls"], 10)
+            self.assertGreaterEqual(stats["dispatch_cache_hits"], 9)
+            converted = sum(stats["to_java_" + i] for i in ("exact", "derived", "implicit", "explicit"))
+            self.assertGreaterEqual(converted, 10)
+            self.assertGreaterEqual(stats["to_python_primitive"], 10)
+            timer = stats["timers"]["java_call"]
+            self.assertGreaterEqual(timer["count"], 10)
+            self.assertEqual(sum(timer["buckets"]), timer["count"])
+            # Counts start over after a reset and stop while disabled.  Java
+            # threads may still call in, so the bound is loose.
+            _jpype.counterConfig({"enabled": False})
+            _jpype.counterStats(True)
+            for i in range(100):
+                Math.abs(i)
+            self.assertLess(_jpype.counterStats()["jni_calls"], 100)
+        finally:
+            _jpype.counterConfig(orig)
+
 
 class JInitTestCase(common.JPypeTestCase):
 
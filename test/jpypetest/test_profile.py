@@ -0,0 +1,149 @@
+# *****************************************************************************
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+#   See NOTICE file for details.
+#
+# *****************************************************************************
+import os
+import pstats
+import sys
+import tempfile
+import unittest
+
+import _jpype
+import jpype
+import jpype.profile
+import common
+
+
+class ProfileTestCase(common.JPypeTestCase):
+
+    def setUp(self):
+        common.JPypeTestCase.setUp(self)
+        self.orig = _jpype.profileConfig()
+        self.instrument = _jpype.instrumentConfig()
+        jpype.profile.stats(reset=True)
+
+    def tearDown(self):
+        _jpype.profileConfig(self.orig)
+        _jpype.instrumentConfig(self.instrument)
+        jpype.profile.stats(reset=True)
+
+    def testConfig(self):
+        jpype.profile.enable(4)
+        config = _jpype.profileConfig()
+        self.assertTrue(config["enabled"])
+        self.assertEqual(config["interval"], 4)
+        with self.assertRaises(ValueError):
+            _jpype.profileConfig({"interval": 0})
+        with self.assertRaises(KeyError):
+            _jpype.profileConfig({"fred": 1})
+        jpype.profile.disable()
+        self.assertFalse(_jpype.profileConfig()["enabled"])
+
+    def testStats(self):
+        Math = jpype.JClass("java.lang.Math")
+        jpype.profile.enable(5)
+        for i in range(20):
+            Math.abs(i)
+        jpype.profile.disable()
+        Math.abs(1)
+        entry = jpype.profile.stats()["java.lang.Math.abs"]
+        self.assertEqual(entry["calls"], 20)
+        self.assertEqual(entry["sampled"], 4)
+        self.assertGreaterEqual(entry["cache_hits"], 19)
+        self.assertGreater(entry["java_ns"], 0)
+        self.assertEqual(entry["total_ns"], sum(entry[i + "_ns"]
+                                                for i in ("match", "convert", "java", "return")))
+
+    def testReset(self):
+        jpype.profile.enable(1)
+        jpype.JClass("java.lang.Math").abs(1)
+        jpype.profile.disable()
+        self.assertIn("java.lang.Math.abs", jpype.profile.stats(reset=True))
+        self.assertNotIn("java.lang.Math.abs", jpype.profile.stats())
+
+    def testException(self):
+        Integer = jpype.JClass("java.lang.Integer")
+        jpype.profile.enable(1)
+        with self.assertRaises(jpype.JException):
+            Integer.parseInt("fred")
+        with self.assertRaises(TypeError):
+            Integer.parseInt(object())
+        jpype.profile.disable()
+        entry = jpype.profile.stats()["java.lang.Integer.parseInt"]
+        self.assertEqual(entry["calls"], 2)
+        self.assertEqual(entry["sampled"], 2)
+
+    def testDump(self):
+        jpype.profile.enable(1)
+        jpype.JClass("java.lang.Math").abs(1)
+        jpype.profile.disable()
+        fd, filename = tempfile.mkstemp(suffix=".prof")
+        os.close(fd)
+        try:
+            jpype.profile.dump(filename)
+            stats = pstats.Stats(filename).stats
+            self.assertIn(("java.lang.Math", 0, "abs"), stats)
+            self.assertIn(("java.lang.Math", 0, "abs [java]"), stats)
+            self.assertEqual(stats[("java.lang.Math", 0, "abs")][1], 1)
+        finally:
+            os.remove(filename)
+
+    def testInstrumentConfig(self):
+        with self.assertRaises(KeyError):
+            _jpype.instrumentConfig({"fred": True})
+        config = _jpype.instrumentConfig({"perf_map": False, "monitoring": False})
+        self.assertFalse(config["perf_map"])
+        self.assertFalse(config["monitoring"])
+
+    def testPerfMap(self):
+        try:
+            jpype.profile.perfMap()
+        except NotImplementedError:
+            raise unittest.SkipTest("perf map not supported")
+        Math = jpype.JClass("java.lang.Math")
+        self.assertEqual(Math.abs(-1), 1)
+        with self.assertRaises(TypeError):
+            Math.abs(object())
+        jpype.profile.perfMap(False)
+        with open("/tmp/perf-%d.map" % os.getpid()) as fd:
+            self.assertIn("java::java.lang.Math.abs", fd.read())
+
+    @unittest.skipIf(sys.version_info < (3, 13), "requires sys.monitoring C API")
+    def testMonitoring(self):
+        events = sys.monitoring.events
+        tool = sys.monitoring.PROFILER_ID
+        sys.monitoring.use_tool_id(tool, "test")
+        seen = []
+        try:
+            sys.monitoring.register_callback(tool, events.PY_START,
+                                             lambda code, offset: seen.append(("start", code)))
+            sys.monitoring.register_callback(tool, events.PY_RETURN,
+                                             lambda code, offset, value: seen.append(("return", code)))
+            sys.monitoring.register_callback(tool, events.PY_UNWIND,
+                                             lambda code, offset, exc: seen.append(("unwind", code)))
+            sys.monitoring.set_events(tool, events.PY_START | events.PY_RETURN | events.PY_UNWIND)
+            jpype.profile.monitoring()
+            Math = jpype.JClass("java.lang.Math")
+            Math.abs(-1)
+            with self.assertRaises(TypeError):
+                Math.abs(object())
+            jpype.profile.monitoring(False)
+        finally:
+            sys.monitoring.set_events(tool, 0)
+            sys.monitoring.free_tool_id(tool)
+        java = [(kind, code.co_name) for kind, code in seen if code.co_filename == "java.lang.Math"]
+        self.assertEqual(java, [("start", "abs"), ("return", "abs"),
+                                ("start", "abs"), ("unwind", "abs")])
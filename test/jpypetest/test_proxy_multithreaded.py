@@ -139,3 +139,76 @@ class ProxyMultiThreadedTestCase(common.JPypeTestCase):
         expected = self.executor.getExpectedTasks()
         self.assertEqual(result, expected,
                          "Executed Tasks should be the same.")
+
+    def testQueuedProxy(self):
+        """Test queued proxy calls from many Java threads.
+
+        The calls are run by a callback executor thread.
+        """
+        self.executor = self.package.ProxyExecutor(10)
+        for i in range(0, 5):
+            proxy = JProxy(self.package.TestInterface4, inst=C(), queued=True)
+            self.executor.registerProxy(proxy, 15)
+
+        with JCallbackExecutor():
+            self.executor.runExecutor()
+            result = self.executor.waitForExecutedTasks()
+        expected = self.executor.getExpectedTasks()
+        self.assertEqual(result, expected,
+                         "Executed Tasks should be the same.")
+
+    def testQueuedProxyException(self):
+        @JImplements("java.util.concurrent.Callable", queued=True)
+        class Fail:
+            @JOverride
+            def call(self):
+                raise ValueError("queued failure")
+
+        pool = java.util.concurrent.Executors.newFixedThreadPool(2)
+        try:
+            with JCallbackExecutor():
+                future = pool.submit(Fail())
+                with self.assertRaises(java.util.concurrent.ExecutionException):
+                    future.get()
+        finally:
+            pool.shutdown()
+
+    def testQueuedProxyNoExecutor(self):
+        @JImplements("java.util.concurrent.Callable", queued=True)
+        class Answer:
+            @JOverride
+            def call(self):
+                return "done"
+
+        # Without an executor the Java thread calls the proxy itself
+        pool = java.util.concurrent.Executors.newFixedThreadPool(1)
+        try:
+            future = pool.submit(Answer())
+            result = future.get(10, java.util.concurrent.TimeUnit.SECONDS)
+            self.assertEqual(result, "done")
+        finally:
+            pool.shutdown()
+
+    def testQueuedProxyServeLoop(self):
+        import asyncio
+
+        @JImplements("java.util.function.Supplier", queued=True)
+        class Answer:
+            @JOverride
+            def get(self):
+                return "done"
+
+        CompletableFuture = java.util.concurrent.CompletableFuture
+
+        async def main():
+            server = serveCallbacks()
+            self.assertIs(serveCallbacks(), server)
+            result = await CompletableFuture.supplyAsync(Answer())
+            return server, result
+
+        server, result = asyncio.run(main())
+        self.assertEqual(result, "done")
+        # The loop stops serving when asyncio.run cancels its task
+        self.assertFalse(server.serving)
+        future = CompletableFuture.supplyAsync(Answer())
+        self.assertEqual(future.get(10, java.util.concurrent.TimeUnit.SECONDS), "done")
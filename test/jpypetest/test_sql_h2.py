@@ -427,6 +427,37 @@ class CursorTestCase(common.JPypeTestCase):
             with self.assertRaises(dbapi2.ProgrammingError):
                 cu.executemany("inert into booze values (?)", [['?']])
 
+    def test_executecolumns(self):
+        with dbapi2.connect(db_name) as cx, cx.cursor() as cu:
+            cu.execute("create table booze (id integer, price double, name varchar(20))")
+            cu.executecolumns("insert into booze values (?,?,?)",
+                              [[1, 2, 3], [1.5, 2.5, None], ["a", None, "c"]],
+                              batchsize=2)
+            self.assertEqual(cu.rowcount, 3)
+            cu.execute("select * from booze order by id")
+            self.assertEqual(cu.fetchall(), [[1, 1.5, "a"], [2, 2.5, None], [3, None, "c"]])
+
+    @common.requireNumpy
+    def test_executecolumnsNumpy(self):
+        import numpy as np
+        with dbapi2.connect(db_name) as cx, cx.cursor() as cu:
+            cu.execute("create table booze (id integer, price double)")
+            cu.executecolumns("insert into booze values (?,?)",
+                              [np.arange(100, dtype=np.int32), np.linspace(0, 1, 100)])
+            self.assertEqual(cu.rowcount, 100)
+            cu.execute("select sum(id) from booze")
+            self.assertEqual(cu.fetchone()[0], 4950)
+
+    def test_executecolumnsBad(self):
+        with dbapi2.connect(db_name) as cx, cx.cursor() as cu:
+            cu.execute("create table booze (id integer, name varchar(20))")
+            with self.assertRaises(dbapi2.InterfaceError):
+                cu.executecolumns("insert into booze values (?,?)", object())
+            with self.assertRaises(dbapi2.ProgrammingError):
+                cu.executecolumns("insert into booze values (?,?)", [[1, 2]])
+            with self.assertRaises(dbapi2.ProgrammingError):
+                cu.executecolumns("insert into booze values (?,?)", [[1, 2], ["a"]])
+
     def test_fetchone(self):
         with dbapi2.connect(db_name) as cx, cx.cursor() as cur:
             # cursor.fetchone should raise an Error if called before
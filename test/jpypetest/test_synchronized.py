@@ -18,6 +18,7 @@
 import sys
 import threading
 import time
+import _jpype
 import jpype
 from jpype import synchronized
 import common
@@ -89,6 +90,35 @@ class SynchronizedTestCase(common.JPypeTestCase):
         # Verify they did not trample each other
         self.assertTrue(success)
 
+    def testReentrant(self):
+        Thread = jpype.JClass("java.lang.Thread")
+        jo = jpype.JClass("java.lang.Object")()
+        other = jpype.JObject(jo)
+        orig = _jpype.counterConfig()
+        try:
+            _jpype.counterConfig({"enabled": True})
+            with synchronized(jo):
+                _jpype.counterStats(True)
+                # A second wrapper of the same object
+                with synchronized(other):
+                    self.assertTrue(Thread.holdsLock(jo))
+                    released = _jpype.counterStats()["gil_releases"]
+                self.assertTrue(Thread.holdsLock(jo))
+        finally:
+            _jpype.counterConfig(orig)
+        self.assertFalse(Thread.holdsLock(jo))
+        # The nested enter kept the GIL, so only holdsLock gave it up
+        self.assertLess(released, 2)
+
+    def testNotHeld(self):
+        jo = jpype.JClass("java.lang.Object")()
+        monitor = synchronized(jo)
+        with self.assertRaises(jpype.JException):
+            monitor.__exit__(None, None, None)
+        # The monitor can still be used
+        with monitor:
+            pass
+
     def testSyncronizedFail(self):
         with self.assertRaisesRegex(TypeError, "Java object is required"):
             with jpype.synchronized(object()):
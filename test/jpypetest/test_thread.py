@@ -67,3 +67,35 @@ class ThreadTestCase(common.JPypeTestCase):
         java.lang.Thread.attachAsDaemon()
         self.assertTrue(java.lang.Thread.isAttached())
         self.assertTrue(java.lang.Thread.currentThread().isDaemon())
+
+    def testDetachStats(self):
+        import _jpype
+        # The main thread may have been attached when the JVM was created
+        # rather than by JPype, so its detach must not be counted.
+        jpype.java.lang.Thread.detach()
+        self.assertGreaterEqual(_jpype.threadStats()["attached"], 0)
+        jpype.java.lang.Thread.detach()
+        self.assertGreaterEqual(_jpype.threadStats()["attached"], 0)
+        jpype.java.lang.Thread.attach()
+
+    def testAutoDetach(self):
+        import _jpype
+        import threading
+        import time
+        before = _jpype.threadStats()
+
+        def run():
+            jpype.JString("foo")
+        t = threading.Thread(target=run)
+        t.start()
+        t.join()
+
+        # The detach happens as the native thread exits
+        for i in range(100):
+            after = _jpype.threadStats()
+            if after["auto_detaches"] > before["auto_detaches"]:
+                break
+            time.sleep(0.01)
+        self.assertGreater(after["attaches"], before["attaches"])
+        self.assertGreater(after["auto_detaches"], before["auto_detaches"])
+        self.assertGreaterEqual(after["attached"], 0)